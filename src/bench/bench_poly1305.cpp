@@ -0,0 +1,647 @@
+//======================================================================
+//
+// bench_poly1305.cpp
+// ------------------
+// Verilator based latency and throughput benchmark for the Poly1305
+// core and the top level wrapper. Messages of increasing size are
+// processed and the number of cycles used is reported. The result
+// can be compared against a baseline, in which case the benchmark
+// fails if any message requires more cycles than in the baseline.
+//
+// The program is built with BENCH_CORE defined to drive
+// poly1305_core directly, or with BENCH_TOP defined to drive the
+// poly1305 top through the register interface. For the top, every
+// bus access uses one cycle, and the cycles reported are thus the
+// host bus cycles including status polling.
+//
+// The tag for the RFC 8439 test vector is checked before the
+// benchmark, and the tag for every benchmark message is checked
+// against a software model. A tag mismatch fails the benchmark.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "verilated.h"
+
+#if defined(BENCH_TOP)
+#include "Vpoly1305.h"
+typedef Vpoly1305 Vdut;
+static const char *BENCH_NAME = "top";
+#elif defined(BENCH_CORE)
+#include "Vpoly1305_core.h"
+typedef Vpoly1305_core Vdut;
+static const char *BENCH_NAME = "core";
+#else
+#error "BENCH_CORE or BENCH_TOP must be defined."
+#endif
+
+
+//------------------------------------------------------------------
+// Constants.
+//------------------------------------------------------------------
+static const uint32_t MESSAGE_SIZES[] = {0, 1, 16, 64, 256, 1024,
+                                         4096, 16384, 65536};
+static const uint32_t NUM_SIZES = sizeof(MESSAGE_SIZES) / sizeof(uint32_t);
+
+// Key from RFC 8439, section 2.5.2.
+static const uint8_t BENCH_KEY[32] = {
+  0x85, 0xd6, 0xbe, 0x78, 0x57, 0x55, 0x6d, 0x33,
+  0x7f, 0x44, 0x52, 0xfe, 0x42, 0xd5, 0x06, 0xa8,
+  0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd,
+  0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b};
+
+// Message and tag from RFC 8439, section 2.5.2.
+static const char    RFC_MSG[] = "Cryptographic Forum Research Group";
+static const uint8_t RFC_TAG[16] = {
+  0xa8, 0x06, 0x1d, 0xc1, 0x30, 0x51, 0x36, 0xc6,
+  0xc2, 0x2b, 0x8b, 0xaf, 0x0c, 0x01, 0x27, 0xa9};
+
+// Top level register addresses.
+static const uint8_t ADDR_CTRL      = 0x08;
+static const uint8_t ADDR_STATUS    = 0x09;
+static const uint8_t ADDR_BLOCKLEN  = 0x0a;
+static const uint8_t ADDR_KEY0      = 0x10;
+static const uint8_t ADDR_BLOCK0    = 0x20;
+static const uint8_t ADDR_MAC0      = 0x30;
+
+static const uint32_t CTRL_INIT     = 0x01;
+static const uint32_t CTRL_NEXT     = 0x02;
+static const uint32_t CTRL_LAST     = 0x08;
+static const uint32_t STATUS_READY  = 0x01;
+
+// Upper limit for the number of cycles waiting for ready.
+static const uint64_t MAX_WAIT      = 100000;
+
+
+//------------------------------------------------------------------
+// Globals.
+//------------------------------------------------------------------
+static Vdut     *dut;
+static uint64_t cycle_ctr;
+
+
+//------------------------------------------------------------------
+// tick()
+//
+// Advance the DUT one clock cycle.
+//------------------------------------------------------------------
+static void tick() {
+  dut->clk = 1;
+  dut->eval();
+  dut->clk = 0;
+  dut->eval();
+  cycle_ctr++;
+}
+
+
+//------------------------------------------------------------------
+// reset_dut()
+//------------------------------------------------------------------
+static void reset_dut() {
+  dut->clk     = 0;
+  dut->reset_n = 0;
+  tick();
+  tick();
+  dut->reset_n = 1;
+  tick();
+  tick();
+}
+
+
+//------------------------------------------------------------------
+// load32_le()
+//------------------------------------------------------------------
+static uint32_t load32_le(const uint8_t *buf) {
+  return ((uint32_t) buf[0]) | ((uint32_t) buf[1] << 8) |
+         ((uint32_t) buf[2] << 16) | ((uint32_t) buf[3] << 24);
+}
+
+
+//------------------------------------------------------------------
+// model_poly1305()
+//
+// Software model used to check the tags. The block function and
+// the finalization are the same as poly_block() and
+// crypto_poly1305_final() in the monocypher model in src/model,
+// without the debug printouts.
+//------------------------------------------------------------------
+static void model_poly1305(const uint8_t *msg, uint32_t len,
+                           const uint8_t *key, uint8_t *tag) {
+  uint32_t r[4], s[4], c[5];
+  uint32_t h[5] = {0, 0, 0, 0, 0};
+
+  r[0] = load32_le(&key[0]) & 0x0fffffff;
+  for (int i = 1 ; i < 4 ; i++)
+    r[i] = load32_le(&key[i * 4]) & 0x0ffffffc;
+  for (int i = 0 ; i < 4 ; i++)
+    s[i] = load32_le(&key[i * 4 + 16]);
+
+  uint32_t rr0 = (r[0] >> 2) * 5;
+  uint32_t rr1 = (r[1] >> 2) + r[1];
+  uint32_t rr2 = (r[2] >> 2) + r[2];
+  uint32_t rr3 = (r[3] >> 2) + r[3];
+
+  for (uint32_t offset = 0 ; offset < len ; offset += 16) {
+    uint8_t block[17];
+    uint32_t blen = ((len - offset) < 16) ? (len - offset) : 16;
+
+    // Padded block with the final one bit after the message bytes.
+    memset(&block[0], 0, sizeof(block));
+    memcpy(&block[0], &msg[offset], blen);
+    block[blen] = 1;
+    for (int i = 0 ; i < 4 ; i++)
+      c[i] = load32_le(&block[i * 4]);
+    c[4] = block[16];
+
+    uint64_t s0 = h[0] + (uint64_t) c[0];
+    uint64_t s1 = h[1] + (uint64_t) c[1];
+    uint64_t s2 = h[2] + (uint64_t) c[2];
+    uint64_t s3 = h[3] + (uint64_t) c[3];
+    uint32_t s4 = h[4] + c[4];
+
+    uint64_t x0 = s0 * r[0] + s1 * rr3  + s2 * rr2  + s3 * rr1  + s4 * rr0;
+    uint64_t x1 = s0 * r[1] + s1 * r[0] + s2 * rr3  + s3 * rr2  + s4 * rr1;
+    uint64_t x2 = s0 * r[2] + s1 * r[1] + s2 * r[0] + s3 * rr3  + s4 * rr2;
+    uint64_t x3 = s0 * r[3] + s1 * r[2] + s2 * r[1] + s3 * r[0] + s4 * rr3;
+    uint32_t x4 = s4 * (r[0] & 3);
+
+    uint32_t u5 = x4 + (x3 >> 32);
+    uint64_t u0 = (u5 >>  2) * 5 + (x0 & 0xffffffff);
+    uint64_t u1 = (u0 >> 32)     + (x1 & 0xffffffff) + (x0 >> 32);
+    uint64_t u2 = (u1 >> 32)     + (x2 & 0xffffffff) + (x1 >> 32);
+    uint64_t u3 = (u2 >> 32)     + (x3 & 0xffffffff) + (x2 >> 32);
+    uint64_t u4 = (u3 >> 32)     + (u5 & 3);
+
+    h[0] = u0 & 0xffffffff;
+    h[1] = u1 & 0xffffffff;
+    h[2] = u2 & 0xffffffff;
+    h[3] = u3 & 0xffffffff;
+    h[4] = (uint32_t) u4;
+  }
+
+  uint64_t u0 = (uint64_t) 5  + h[0];
+  uint64_t u1 = (u0 >> 32)    + h[1];
+  uint64_t u2 = (u1 >> 32)    + h[2];
+  uint64_t u3 = (u2 >> 32)    + h[3];
+  uint64_t u4 = (u3 >> 32)    + h[4];
+
+  uint64_t uu0 = (u4 >> 2) * 5 + h[0] + s[0];
+  uint64_t uu1 = (uu0 >> 32)   + h[1] + s[1];
+  uint64_t uu2 = (uu1 >> 32)   + h[2] + s[2];
+  uint64_t uu3 = (uu2 >> 32)   + h[3] + s[3];
+  uint32_t m[4] = {(uint32_t) uu0, (uint32_t) uu1, (uint32_t) uu2, (uint32_t) uu3};
+
+  for (int i = 0 ; i < 16 ; i++)
+    tag[i] = (m[i / 4] >> ((i % 4) * 8)) & 0xff;
+}
+
+
+//------------------------------------------------------------------
+// check_tag()
+//
+// Compare a tag with the expected tag. Returns non zero and
+// prints both tags on mismatch.
+//------------------------------------------------------------------
+static int check_tag(uint32_t len, const uint8_t *tag, const uint8_t *expected) {
+  if (memcmp(tag, expected, 16) == 0)
+    return 0;
+
+  printf("Error: Tag mismatch for %s at %u bytes.\n", BENCH_NAME, len);
+  printf("Expected: ");
+  for (int i = 0 ; i < 16 ; i++)
+    printf("%02x", expected[i]);
+  printf("\nGot:      ");
+  for (int i = 0 ; i < 16 ; i++)
+    printf("%02x", tag[i]);
+  printf("\n");
+  return 1;
+}
+
+
+//------------------------------------------------------------------
+// get_word()
+//
+// Get the big endian 32-bit word starting at the given byte
+// offset in a buffer. Bytes after the end are read as zero.
+//------------------------------------------------------------------
+static uint32_t get_word(const uint8_t *buf, uint32_t len, uint32_t offset) {
+  uint32_t w = 0;
+  for (uint32_t i = 0 ; i < 4 ; i++) {
+    w <<= 8;
+    if ((offset + i) < len)
+      w |= buf[offset + i];
+  }
+  return w;
+}
+
+
+#if defined(BENCH_CORE)
+//------------------------------------------------------------------
+// wait_ready()
+//
+// Wait until the core signals ready. Returns non zero on timeout.
+//------------------------------------------------------------------
+static int wait_ready() {
+  uint64_t start = cycle_ctr;
+  while (!dut->ready) {
+    tick();
+    if ((cycle_ctr - start) > MAX_WAIT)
+      return 1;
+  }
+  return 0;
+}
+
+
+//------------------------------------------------------------------
+// run_message()
+//
+// Process a message with the core. The command for each operation
+// is given in the cycle where ready is seen, and the cycles used
+// thus equal the sum of the operation latencies.
+//------------------------------------------------------------------
+static int run_message(const uint8_t *msg, uint32_t len, uint8_t *tag) {
+  uint32_t num_blocks = (len == 0) ? 1 : (len + 15) / 16;
+
+  // The first key byte is in the most significant byte.
+  for (uint32_t i = 0 ; i < 8 ; i++)
+    dut->key[7 - i] = get_word(BENCH_KEY, 32, i * 4);
+
+  dut->init = 1;
+  tick();
+  dut->init = 0;
+  if (wait_ready())
+    return 1;
+
+  for (uint32_t b = 0 ; b < num_blocks ; b++) {
+    uint32_t offset   = b * 16;
+    uint32_t blocklen = ((len - offset) > 16) ? 16 : (len - offset);
+
+    for (uint32_t i = 0 ; i < 4 ; i++)
+      dut->block[3 - i] = get_word(msg, offset + blocklen, offset + i * 4);
+
+    dut->blocklen = blocklen;
+    dut->last     = (b == (num_blocks - 1));
+    dut->next     = 1;
+    tick();
+    dut->next     = 0;
+    dut->last     = 0;
+    if (wait_ready())
+      return 1;
+  }
+
+  for (uint32_t i = 0 ; i < 16 ; i++)
+    tag[i] = (dut->mac[(15 - i) / 4] >> (((15 - i) % 4) * 8)) & 0xff;
+
+  return 0;
+}
+#endif
+
+
+#if defined(BENCH_TOP)
+//------------------------------------------------------------------
+// write_word()
+//
+// One cycle bus write.
+//------------------------------------------------------------------
+static void write_word(uint8_t address, uint32_t data) {
+  dut->cs         = 1;
+  dut->we         = 1;
+  dut->address    = address;
+  dut->write_data = data;
+  tick();
+  dut->cs         = 0;
+  dut->we         = 0;
+}
+
+
+//------------------------------------------------------------------
+// read_word()
+//
+// One cycle bus read. The read data is sampled before the
+// rising clock edge.
+//------------------------------------------------------------------
+static uint32_t read_word(uint8_t address) {
+  uint32_t data;
+
+  dut->cs      = 1;
+  dut->we      = 0;
+  dut->address = address;
+  dut->eval();
+  data = dut->read_data;
+  tick();
+  dut->cs      = 0;
+  return data;
+}
+
+
+//------------------------------------------------------------------
+// wait_ready()
+//
+// Poll the status register until ready is set.
+// Returns non zero on timeout.
+//------------------------------------------------------------------
+static int wait_ready() {
+  uint64_t start = cycle_ctr;
+  while (!(read_word(ADDR_STATUS) & STATUS_READY)) {
+    if ((cycle_ctr - start) > MAX_WAIT)
+      return 1;
+  }
+  return 0;
+}
+
+
+//------------------------------------------------------------------
+// run_message()
+//
+// Process a message through the register interface, the same
+// way as a simple driver would: write the block, blocklen and
+// command, then poll the status until the core is ready.
+//------------------------------------------------------------------
+static int run_message(const uint8_t *msg, uint32_t len, uint8_t *tag) {
+  uint32_t num_blocks = (len == 0) ? 1 : (len + 15) / 16;
+
+  for (uint32_t i = 0 ; i < 8 ; i++)
+    write_word(ADDR_KEY0 + i, get_word(BENCH_KEY, 32, i * 4));
+
+  write_word(ADDR_CTRL, CTRL_INIT);
+  if (wait_ready())
+    return 1;
+
+  for (uint32_t b = 0 ; b < num_blocks ; b++) {
+    uint32_t offset   = b * 16;
+    uint32_t blocklen = ((len - offset) > 16) ? 16 : (len - offset);
+    uint32_t ctrl     = CTRL_NEXT;
+
+    if (blocklen > 0) {
+      for (uint32_t i = 0 ; i < 4 ; i++)
+        write_word(ADDR_BLOCK0 + i, get_word(msg, offset + blocklen, offset + i * 4));
+    }
+
+    if (b == (num_blocks - 1))
+      ctrl |= CTRL_LAST;
+
+    write_word(ADDR_BLOCKLEN, blocklen);
+    write_word(ADDR_CTRL, ctrl);
+    if (wait_ready())
+      return 1;
+  }
+
+  for (uint32_t i = 0 ; i < 4 ; i++) {
+    uint32_t w = read_word(ADDR_MAC0 + i);
+    tag[i * 4 + 0] = (w >> 24) & 0xff;
+    tag[i * 4 + 1] = (w >> 16) & 0xff;
+    tag[i * 4 + 2] = (w >>  8) & 0xff;
+    tag[i * 4 + 3] = w & 0xff;
+  }
+
+  return 0;
+}
+#endif
+
+
+//------------------------------------------------------------------
+// read_baseline()
+//
+// Read all lines in a baseline file. Each line contains the
+// bench name, the message size and the number of cycles. Lines
+// starting with '#' are comments.
+//------------------------------------------------------------------
+static void read_baseline(const char *fname, std::vector<std::string> &lines) {
+  std::ifstream f(fname);
+  std::string line;
+  while (std::getline(f, line))
+    lines.push_back(line);
+}
+
+
+//------------------------------------------------------------------
+// get_baseline()
+//
+// Extract the baseline cycles for this bench.
+//------------------------------------------------------------------
+static void get_baseline(const std::vector<std::string> &lines,
+                         std::map<uint32_t, uint64_t> &baseline) {
+  for (size_t i = 0 ; i < lines.size() ; i++) {
+    std::istringstream ss(lines[i]);
+    std::string name;
+    uint32_t size;
+    uint64_t cycles;
+
+    if (lines[i].empty() || (lines[i][0] == '#'))
+      continue;
+
+    if ((ss >> name >> size >> cycles) && (name == BENCH_NAME))
+      baseline[size] = cycles;
+  }
+}
+
+
+//------------------------------------------------------------------
+// write_baseline()
+//
+// Update the baseline file with the result for this bench.
+// Lines for other benches are kept.
+//------------------------------------------------------------------
+static int write_baseline(const char *fname, const uint64_t *cycles) {
+  std::vector<std::string> lines;
+  std::string prefix = std::string(BENCH_NAME) + " ";
+
+  read_baseline(fname, lines);
+
+  FILE *f = fopen(fname, "w");
+  if (f == NULL) {
+    printf("Error: Could not open %s for writing.\n", fname);
+    return 1;
+  }
+
+  for (size_t i = 0 ; i < lines.size() ; i++) {
+    if (lines[i].compare(0, prefix.size(), prefix) != 0)
+      fprintf(f, "%s\n", lines[i].c_str());
+  }
+
+  for (uint32_t i = 0 ; i < NUM_SIZES ; i++)
+    fprintf(f, "%s %u %llu\n", BENCH_NAME, MESSAGE_SIZES[i],
+            (unsigned long long) cycles[i]);
+
+  fclose(f);
+  printf("Baseline for %s written to %s\n", BENCH_NAME, fname);
+  return 0;
+}
+
+
+//------------------------------------------------------------------
+// usage()
+//------------------------------------------------------------------
+static void usage(const char *name) {
+  printf("Usage: %s [--baseline <file>] [--write <file>]\n", name);
+  printf("  --baseline <file>  Fail if any message needs more cycles than in file.\n");
+  printf("  --write <file>     Update the baseline in file with the result.\n");
+}
+
+
+//------------------------------------------------------------------
+// main()
+//------------------------------------------------------------------
+int main(int argc, char **argv) {
+  const char *baseline_file = NULL;
+  const char *write_file    = NULL;
+  uint64_t cycles[NUM_SIZES];
+  std::vector<uint8_t> msg(MESSAGE_SIZES[NUM_SIZES - 1]);
+  uint8_t tag[16];
+  uint8_t expected[16];
+  int error_ctr = 0;
+  int tag_errors = 0;
+
+  Verilated::commandArgs(argc, argv);
+
+  for (int i = 1 ; i < argc ; i++) {
+    if ((strcmp(argv[i], "--baseline") == 0) && ((i + 1) < argc))
+      baseline_file = argv[++i];
+    else if ((strcmp(argv[i], "--write") == 0) && ((i + 1) < argc))
+      write_file = argv[++i];
+    else if (argv[i][0] != '+') {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  // Deterministic message data.
+  uint32_t lfsr = 0x13050001;
+  for (size_t i = 0 ; i < msg.size() ; i++) {
+    lfsr = lfsr * 1664525 + 1013904223;
+    msg[i] = lfsr >> 24;
+  }
+
+  dut = new Vdut;
+  reset_dut();
+
+  // Check the model and the DUT against the RFC 8439 vector.
+  model_poly1305((const uint8_t *) RFC_MSG, strlen(RFC_MSG), BENCH_KEY, &expected[0]);
+  if (check_tag(strlen(RFC_MSG), &expected[0], RFC_TAG)) {
+    printf("Error: The model does not match the RFC 8439 vector.\n");
+    delete dut;
+    return 1;
+  }
+
+  if (run_message((const uint8_t *) RFC_MSG, strlen(RFC_MSG), &tag[0])) {
+    printf("Error: Timeout waiting for ready for the RFC 8439 vector.\n");
+    delete dut;
+    return 1;
+  }
+
+  if (check_tag(strlen(RFC_MSG), &tag[0], RFC_TAG)) {
+    delete dut;
+    return 1;
+  }
+
+  printf("Poly1305 %s benchmark\n", BENCH_NAME);
+  printf("%8s %12s %14s\n", "bytes", "cycles", "cycles/byte");
+
+  for (uint32_t i = 0 ; i < NUM_SIZES ; i++) {
+    uint64_t start = cycle_ctr;
+
+    if (run_message(&msg[0], MESSAGE_SIZES[i], &tag[0])) {
+      printf("Error: Timeout waiting for ready at %u bytes.\n", MESSAGE_SIZES[i]);
+      delete dut;
+      return 1;
+    }
+    cycles[i] = cycle_ctr - start;
+
+    model_poly1305(&msg[0], MESSAGE_SIZES[i], BENCH_KEY, &expected[0]);
+    tag_errors += check_tag(MESSAGE_SIZES[i], &tag[0], &expected[0]);
+
+    if (MESSAGE_SIZES[i] > 0)
+      printf("%8u %12llu %14.3f\n", MESSAGE_SIZES[i], (unsigned long long) cycles[i],
+             (double) cycles[i] / MESSAGE_SIZES[i]);
+    else
+      printf("%8u %12llu %14s\n", MESSAGE_SIZES[i], (unsigned long long) cycles[i], "-");
+  }
+
+  delete dut;
+
+  if (baseline_file) {
+    std::vector<std::string> lines;
+    std::map<uint32_t, uint64_t> baseline;
+
+    read_baseline(baseline_file, lines);
+    get_baseline(lines, baseline);
+
+    for (uint32_t i = 0 ; i < NUM_SIZES ; i++) {
+      if (baseline.count(MESSAGE_SIZES[i]) == 0) {
+        printf("Error: No baseline for %s at %u bytes.\n", BENCH_NAME, MESSAGE_SIZES[i]);
+        error_ctr++;
+      }
+      else if (cycles[i] > baseline[MESSAGE_SIZES[i]]) {
+        printf("Error: %s at %u bytes used %llu cycles, baseline is %llu cycles.\n",
+               BENCH_NAME, MESSAGE_SIZES[i], (unsigned long long) cycles[i],
+               (unsigned long long) baseline[MESSAGE_SIZES[i]]);
+        error_ctr++;
+      }
+      else if (cycles[i] < baseline[MESSAGE_SIZES[i]]) {
+        printf("Note: %s at %u bytes used %llu cycles, baseline is %llu cycles.\n",
+               BENCH_NAME, MESSAGE_SIZES[i], (unsigned long long) cycles[i],
+               (unsigned long long) baseline[MESSAGE_SIZES[i]]);
+      }
+    }
+
+    if (error_ctr == 0)
+      printf("Baseline check for %s passed.\n", BENCH_NAME);
+    else
+      printf("Baseline check for %s failed.\n", BENCH_NAME);
+  }
+
+  if (tag_errors != 0) {
+    printf("Tag check for %s failed.\n", BENCH_NAME);
+    return 1;
+  }
+
+  if (write_file && (error_ctr == 0)) {
+    if (write_baseline(write_file, &cycles[0]))
+      return 1;
+  }
+
+  return (error_ctr == 0) ? 0 : 1;
+}
+
+//======================================================================
+// EOF bench_poly1305.cpp
+//======================================================================
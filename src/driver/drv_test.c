@@ -0,0 +1,381 @@
+//======================================================================
+//
+// drv_test.c
+// ----------
+// Test program for the driver using the Verilator backend. The
+// tags are checked against known vectors and a software reference,
+// and the number of bus transactions per byte is reported for a
+// range of message sizes, with status polling and with the irq.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "poly1305_drv.h"
+#include "poly1305_vl.h"
+
+
+//------------------------------------------------------------------
+// Constants.
+//------------------------------------------------------------------
+static const uint32_t MESSAGE_SIZES[] = {0, 1, 16, 64, 256, 1024, 4096};
+static const uint32_t NUM_SIZES = sizeof(MESSAGE_SIZES) / sizeof(uint32_t);
+
+// Number of messages per size in the report.
+static const uint32_t NUM_MESSAGES = 8;
+
+// Key and message from RFC 8439, section 2.5.2.
+static const uint8_t RFC_KEY[32] = {
+  0x85, 0xd6, 0xbe, 0x78, 0x57, 0x55, 0x6d, 0x33,
+  0x7f, 0x44, 0x52, 0xfe, 0x42, 0xd5, 0x06, 0xa8,
+  0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd,
+  0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b};
+
+static const uint8_t RFC_MSG[34] = {
+  0x43, 0x72, 0x79, 0x70, 0x74, 0x6f, 0x67, 0x72,
+  0x61, 0x70, 0x68, 0x69, 0x63, 0x20, 0x46, 0x6f,
+  0x72, 0x75, 0x6d, 0x20, 0x52, 0x65, 0x73, 0x65,
+  0x61, 0x72, 0x63, 0x68, 0x20, 0x47, 0x72, 0x6f,
+  0x75, 0x70};
+
+static const uint8_t RFC_TAG[16] = {
+  0xa8, 0x06, 0x1d, 0xc1, 0x30, 0x51, 0x36, 0xc6,
+  0xc2, 0x2b, 0x8b, 0xaf, 0x0c, 0x01, 0x27, 0xa9};
+
+// Key and tag for the long message test in tb_poly1305.
+static const uint8_t LONG_KEY[32] = {
+  0xf3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3f,
+  0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf3};
+
+static const uint8_t LONG_TAG[16] = {
+  0xdc, 0x09, 0x64, 0xe5, 0xce, 0x9c, 0xd7, 0xd9,
+  0xa7, 0x57, 0x1f, 0xaf, 0xa5, 0xdc, 0x04, 0x73};
+
+
+//------------------------------------------------------------------
+// Globals.
+//------------------------------------------------------------------
+static uint8_t msg_buf[4096];
+
+
+//------------------------------------------------------------------
+// fill_message()
+//
+// Fill the message buffer with pseudo random data.
+//------------------------------------------------------------------
+static void fill_message(uint32_t seed) {
+  for (uint32_t i = 0 ; i < sizeof(msg_buf) ; i++) {
+    seed = seed * 1103515245 + 12345;
+    msg_buf[i] = (seed >> 16) & 0xff;
+  }
+}
+
+
+//------------------------------------------------------------------
+// load32_le()
+//------------------------------------------------------------------
+static uint32_t load32_le(const uint8_t *buf) {
+  return ((uint32_t) buf[0]) | ((uint32_t) buf[1] << 8) |
+         ((uint32_t) buf[2] << 16) | ((uint32_t) buf[3] << 24);
+}
+
+
+//------------------------------------------------------------------
+// model_poly1305()
+//
+// Software reference used to check the tags. The same model as
+// in bench_poly1305.cpp, based on poly_block() and
+// crypto_poly1305_final() in the monocypher model in src/model.
+//------------------------------------------------------------------
+static void model_poly1305(const uint8_t *msg, uint32_t len,
+                           const uint8_t *key, uint8_t *tag) {
+  uint32_t r[4], s[4], c[5];
+  uint32_t h[5] = {0, 0, 0, 0, 0};
+
+  r[0] = load32_le(&key[0]) & 0x0fffffff;
+  for (int i = 1 ; i < 4 ; i++)
+    r[i] = load32_le(&key[i * 4]) & 0x0ffffffc;
+  for (int i = 0 ; i < 4 ; i++)
+    s[i] = load32_le(&key[i * 4 + 16]);
+
+  uint32_t rr0 = (r[0] >> 2) * 5;
+  uint32_t rr1 = (r[1] >> 2) + r[1];
+  uint32_t rr2 = (r[2] >> 2) + r[2];
+  uint32_t rr3 = (r[3] >> 2) + r[3];
+
+  for (uint32_t offset = 0 ; offset < len ; offset += 16) {
+    uint8_t block[17];
+    uint32_t blen = ((len - offset) < 16) ? (len - offset) : 16;
+
+    // Padded block with the final one bit after the message bytes.
+    memset(&block[0], 0, sizeof(block));
+    memcpy(&block[0], &msg[offset], blen);
+    block[blen] = 1;
+    for (int i = 0 ; i < 4 ; i++)
+      c[i] = load32_le(&block[i * 4]);
+    c[4] = block[16];
+
+    uint64_t s0 = h[0] + (uint64_t) c[0];
+    uint64_t s1 = h[1] + (uint64_t) c[1];
+    uint64_t s2 = h[2] + (uint64_t) c[2];
+    uint64_t s3 = h[3] + (uint64_t) c[3];
+    uint32_t s4 = h[4] + c[4];
+
+    uint64_t x0 = s0 * r[0] + s1 * rr3  + s2 * rr2  + s3 * rr1  + s4 * rr0;
+    uint64_t x1 = s0 * r[1] + s1 * r[0] + s2 * rr3  + s3 * rr2  + s4 * rr1;
+    uint64_t x2 = s0 * r[2] + s1 * r[1] + s2 * r[0] + s3 * rr3  + s4 * rr2;
+    uint64_t x3 = s0 * r[3] + s1 * r[2] + s2 * r[1] + s3 * r[0] + s4 * rr3;
+    uint32_t x4 = s4 * (r[0] & 3);
+
+    uint32_t u5 = x4 + (x3 >> 32);
+    uint64_t u0 = (u5 >>  2) * 5 + (x0 & 0xffffffff);
+    uint64_t u1 = (u0 >> 32)     + (x1 & 0xffffffff) + (x0 >> 32);
+    uint64_t u2 = (u1 >> 32)     + (x2 & 0xffffffff) + (x1 >> 32);
+    uint64_t u3 = (u2 >> 32)     + (x3 & 0xffffffff) + (x2 >> 32);
+    uint64_t u4 = (u3 >> 32)     + (u5 & 3);
+
+    h[0] = u0 & 0xffffffff;
+    h[1] = u1 & 0xffffffff;
+    h[2] = u2 & 0xffffffff;
+    h[3] = u3 & 0xffffffff;
+    h[4] = (uint32_t) u4;
+  }
+
+  uint64_t u0 = (uint64_t) 5  + h[0];
+  uint64_t u1 = (u0 >> 32)    + h[1];
+  uint64_t u2 = (u1 >> 32)    + h[2];
+  uint64_t u3 = (u2 >> 32)    + h[3];
+  uint64_t u4 = (u3 >> 32)    + h[4];
+
+  uint64_t uu0 = (u4 >> 2) * 5 + h[0] + s[0];
+  uint64_t uu1 = (uu0 >> 32)   + h[1] + s[1];
+  uint64_t uu2 = (uu1 >> 32)   + h[2] + s[2];
+  uint64_t uu3 = (uu2 >> 32)   + h[3] + s[3];
+  uint32_t m[4] = {(uint32_t) uu0, (uint32_t) uu1, (uint32_t) uu2, (uint32_t) uu3};
+
+  for (int i = 0 ; i < 16 ; i++)
+    tag[i] = (m[i / 4] >> ((i % 4) * 8)) & 0xff;
+}
+
+
+//------------------------------------------------------------------
+// check_tag()
+//------------------------------------------------------------------
+static int check_tag(const char *name, int res, const uint8_t *tag,
+                     const uint8_t *expected) {
+  if (res != POLY1305_OK) {
+    printf("%s: driver error %d.\n", name, res);
+    return 1;
+  }
+
+  if (memcmp(tag, expected, 16) != 0) {
+    printf("%s: Correct tag NOT generated.\n", name);
+    return 1;
+  }
+
+  printf("%s: Correct tag generated.\n", name);
+  return 0;
+}
+
+
+//------------------------------------------------------------------
+// test_vectors()
+//
+// Check the tags for the known vectors. The RFC message is also
+// written one byte at a time, and the long message in uneven
+// chunks, to test the word packing in the driver.
+//------------------------------------------------------------------
+static int test_vectors(poly1305_dev *dev) {
+  uint8_t tag[16];
+  int errors = 0;
+  int res;
+
+  res = poly1305_mac(dev, RFC_KEY, RFC_MSG, sizeof(RFC_MSG), tag);
+  errors += check_tag("rfc8439", res, tag, RFC_TAG);
+
+  res = poly1305_start(dev, RFC_KEY);
+  for (uint32_t i = 0 ; (i < sizeof(RFC_MSG)) && (res == POLY1305_OK) ; i++)
+    res = poly1305_update(dev, &RFC_MSG[i], 1);
+  if (res == POLY1305_OK)
+    res = poly1305_finish(dev, tag);
+  errors += check_tag("rfc8439_bytes", res, tag, RFC_TAG);
+
+  res = poly1305_mac(dev, RFC_KEY, RFC_MSG, 0, tag);
+  errors += check_tag("bytes0", res, tag, &RFC_KEY[16]);
+
+  memset(msg_buf, 0xff, 1024);
+  msg_buf[1024] = 0x01;
+  res = poly1305_start(dev, LONG_KEY);
+  for (uint32_t i = 0 ; (i < 1025) && (res == POLY1305_OK) ; i += 7)
+    res = poly1305_update(dev, &msg_buf[i], ((1025 - i) < 7) ? (1025 - i) : 7);
+  if (res == POLY1305_OK)
+    res = poly1305_finish(dev, tag);
+  errors += check_tag("long", res, tag, LONG_TAG);
+
+  return errors;
+}
+
+
+//------------------------------------------------------------------
+// test_chunks()
+//
+// Check the tags for all message lengths 0..69 against the
+// software reference, with the message split into update calls
+// of one to five bytes and with a single update call. The lengths
+// cover final blocks of all sizes, including 13..15 bytes.
+//------------------------------------------------------------------
+static int test_chunks(poly1305_dev *dev) {
+  uint8_t ref[16];
+  uint8_t tag[16];
+  int errors = 0;
+  int res;
+
+  fill_message(0x13050048);
+
+  for (uint32_t len = 0 ; len < 70 ; len++) {
+    model_poly1305(msg_buf, len, RFC_KEY, ref);
+
+    res = poly1305_mac(dev, RFC_KEY, msg_buf, len, tag);
+    if ((res != POLY1305_OK) || (memcmp(tag, ref, 16) != 0)) {
+      printf("chunks: Incorrect tag for length %u.\n", len);
+      errors++;
+    }
+
+    for (uint32_t chunk = 1 ; chunk < 6 ; chunk++) {
+      res = poly1305_start(dev, RFC_KEY);
+      for (uint32_t i = 0 ; (i < len) && (res == POLY1305_OK) ; i += chunk)
+        res = poly1305_update(dev, &msg_buf[i], ((len - i) < chunk) ? (len - i) : chunk);
+      if (res == POLY1305_OK)
+        res = poly1305_finish(dev, tag);
+
+      if ((res != POLY1305_OK) || (memcmp(tag, ref, 16) != 0)) {
+        printf("chunks: Incorrect tag for length %u and chunk size %u.\n", len, chunk);
+        errors++;
+      }
+    }
+  }
+
+  if (!errors)
+    printf("chunks: Correct tags for all lengths and update sizes.\n");
+  return errors;
+}
+
+
+//------------------------------------------------------------------
+// report()
+//
+// Report the bus transactions per byte for each message size.
+// The same key is used for all messages, as in a session.
+//------------------------------------------------------------------
+static int report(poly1305_vl *vl, int use_irq) {
+  poly1305_bus bus;
+  poly1305_dev dev;
+  uint8_t tag[16];
+
+  poly1305_vl_bus(vl, &bus, use_irq);
+  if (poly1305_open(&dev, &bus) != POLY1305_OK) {
+    printf("Error: Device not found.\n");
+    return 1;
+  }
+
+  printf("\nBus transactions with %s:\n", use_irq ? "irq" : "status polling");
+  printf("size    reads/msg  writes/msg  polls/msg  trans/byte  cycles/byte\n");
+
+  fill_message(0x13050001);
+  for (uint32_t i = 0 ; i < NUM_SIZES ; i++) {
+    uint32_t len = MESSAGE_SIZES[i];
+    uint64_t start = poly1305_vl_cycles(vl);
+    uint64_t cycles;
+
+    poly1305_clear_stats(&dev);
+    for (uint32_t m = 0 ; m < NUM_MESSAGES ; m++) {
+      if (poly1305_mac(&dev, RFC_KEY, msg_buf, len, tag) != POLY1305_OK) {
+        printf("Error: Timeout for message size %u.\n", len);
+        return 1;
+      }
+    }
+    cycles = poly1305_vl_cycles(vl) - start;
+
+    printf("%-7u %9.1f  %10.1f  %9.1f  %10.3f  %11.2f\n", len,
+           (double) dev.stats.reads / NUM_MESSAGES,
+           (double) dev.stats.writes / NUM_MESSAGES,
+           (double) dev.stats.polls / NUM_MESSAGES,
+           len ? (double) (dev.stats.reads + dev.stats.writes) / dev.stats.bytes : 0.0,
+           len ? (double) cycles / dev.stats.bytes : 0.0);
+  }
+
+  printf("\nTotals:\n");
+  poly1305_print_stats(&dev);
+  return 0;
+}
+
+
+//------------------------------------------------------------------
+// main()
+//------------------------------------------------------------------
+int main(void) {
+  poly1305_vl *vl;
+  poly1305_bus bus;
+  poly1305_dev dev;
+  int errors = 0;
+
+  vl = poly1305_vl_open();
+  poly1305_vl_bus(vl, &bus, 0);
+  if (poly1305_open(&dev, &bus) != POLY1305_OK) {
+    printf("Error: Device not found.\n");
+    poly1305_vl_close(vl);
+    return 1;
+  }
+
+  errors += test_vectors(&dev);
+  errors += test_chunks(&dev);
+  errors += report(vl, 0);
+  errors += report(vl, 1);
+
+  poly1305_vl_close(vl);
+
+  if (errors) {
+    printf("\n%d errors.\n", errors);
+    return 1;
+  }
+
+  printf("\nAll driver tests passed.\n");
+  return 0;
+}
+
+//======================================================================
+// EOF drv_test.c
+//======================================================================
@@ -0,0 +1,424 @@
+//======================================================================
+//
+// poly1305_drv.c
+// --------------
+// Driver for the Poly1305 top level register interface.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+#include <stdio.h>
+#include <string.h>
+
+#include "poly1305_drv.h"
+
+
+//------------------------------------------------------------------
+// bus_read()
+//------------------------------------------------------------------
+static uint32_t bus_read(poly1305_dev *dev, uint8_t address) {
+  dev->stats.reads++;
+  return dev->bus.read(dev->bus.ctx, address);
+}
+
+
+//------------------------------------------------------------------
+// bus_write()
+//------------------------------------------------------------------
+static void bus_write(poly1305_dev *dev, uint8_t address, uint32_t data) {
+  dev->stats.writes++;
+  dev->bus.write(dev->bus.ctx, address, data);
+}
+
+
+//------------------------------------------------------------------
+// get_word()
+//
+// Get the big endian 32-bit word in the given bytes. This is the
+// byte order used by the key, block, FIFO and MAC registers.
+//------------------------------------------------------------------
+static uint32_t get_word(const uint8_t *b) {
+  return ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) |
+    ((uint32_t)b[2] << 8) | (uint32_t)b[3];
+}
+
+
+//------------------------------------------------------------------
+// set_irq_mask()
+//
+// Select the irq events, the mask is only written when changed.
+//------------------------------------------------------------------
+static void set_irq_mask(poly1305_dev *dev, uint32_t mask) {
+  if (dev->irq_mask != mask) {
+    bus_write(dev, POLY1305_ADDR_IRQ_MASK, mask);
+    dev->irq_mask = mask;
+  }
+}
+
+
+//------------------------------------------------------------------
+// get_credit()
+//
+// Get a credit for pushing one block to the FIFO. The credit
+// register is only read when all credits from the previous read
+// have been used. Since the FIFO is only drained by the device,
+// the number of credits read is a lower bound until the driver
+// has pushed the blocks. If the FIFO is full and the backend can
+// wait for the irq, the driver waits for a block to be completed
+// instead of polling. The event is cleared before the credits are
+// read, so a block completed after the read is not missed.
+//------------------------------------------------------------------
+static int get_credit(poly1305_dev *dev) {
+  uint32_t polls = 0;
+
+  if (dev->credits == 0) {
+    if (dev->bus.wait_irq) {
+      set_irq_mask(dev, POLY1305_IRQ_BLOCK);
+      bus_write(dev, POLY1305_ADDR_IRQ_STATUS, POLY1305_IRQ_BLOCK);
+    }
+
+    dev->credits = bus_read(dev, POLY1305_ADDR_CREDITS);
+    while (dev->credits == 0) {
+      dev->stats.polls++;
+      if (++polls > POLY1305_MAX_POLLS)
+        return POLY1305_ERR_TIMEOUT;
+
+      if (dev->bus.wait_irq) {
+        if (dev->bus.wait_irq(dev->bus.ctx))
+          return POLY1305_ERR_TIMEOUT;
+        bus_write(dev, POLY1305_ADDR_IRQ_STATUS, POLY1305_IRQ_BLOCK);
+      }
+
+      dev->credits = bus_read(dev, POLY1305_ADDR_CREDITS);
+    }
+  }
+
+  dev->credits--;
+  return POLY1305_OK;
+}
+
+
+//------------------------------------------------------------------
+// write_fifo_word()
+//
+// Write one message word to the FIFO. A credit is taken at the
+// first word in each block.
+//------------------------------------------------------------------
+static int write_fifo_word(poly1305_dev *dev, uint32_t word) {
+  int res;
+
+  if (dev->block_bytes == 0) {
+    res = get_credit(dev);
+    if (res != POLY1305_OK)
+      return res;
+  }
+
+  bus_write(dev, POLY1305_ADDR_FIFO_DATA, word);
+  dev->block_bytes = (dev->block_bytes + 4) & 0xf;
+  return POLY1305_OK;
+}
+
+
+//------------------------------------------------------------------
+// wait_final()
+//
+// Wait until the final processing has been completed. If the
+// backend can wait for the irq, the status is read once after
+// the irq to check that the irq was not left from an earlier
+// event.
+//------------------------------------------------------------------
+static int wait_final(poly1305_dev *dev) {
+  uint32_t polls = 0;
+  uint32_t ready;
+
+  if (dev->bus.wait_irq) {
+    do {
+      if (dev->bus.wait_irq(dev->bus.ctx))
+        return POLY1305_ERR_TIMEOUT;
+
+      ready = bus_read(dev, POLY1305_ADDR_STATUS) & POLY1305_STATUS_READY;
+      if (!ready) {
+        dev->stats.polls++;
+        if (++polls > POLY1305_MAX_POLLS)
+          return POLY1305_ERR_TIMEOUT;
+      }
+    } while (!ready);
+
+    bus_write(dev, POLY1305_ADDR_IRQ_STATUS, POLY1305_IRQ_FINAL);
+    return POLY1305_OK;
+  }
+
+  while (!(bus_read(dev, POLY1305_ADDR_STATUS) & POLY1305_STATUS_READY)) {
+    dev->stats.polls++;
+    if (++polls > POLY1305_MAX_POLLS)
+      return POLY1305_ERR_TIMEOUT;
+  }
+  return POLY1305_OK;
+}
+
+
+//------------------------------------------------------------------
+// poly1305_open()
+//
+// Check that the device is a Poly1305 core and set up the
+// driver state. If the backend can wait for the irq, the irq is
+// enabled.
+//------------------------------------------------------------------
+int poly1305_open(poly1305_dev *dev, const poly1305_bus *bus) {
+  memset(dev, 0, sizeof(*dev));
+  dev->bus = *bus;
+
+  if ((bus_read(dev, POLY1305_ADDR_NAME0) != POLY1305_NAME0) ||
+      (bus_read(dev, POLY1305_ADDR_NAME1) != POLY1305_NAME1))
+    return POLY1305_ERR_DEVICE;
+
+  if (dev->bus.wait_irq) {
+    bus_write(dev, POLY1305_ADDR_IRQ_MASK, POLY1305_IRQ_FINAL);
+    bus_write(dev, POLY1305_ADDR_IRQ_STATUS, POLY1305_IRQ_BLOCK | POLY1305_IRQ_FINAL);
+    bus_write(dev, POLY1305_ADDR_IRQ_ENABLE, 0x1);
+    dev->irq_mask = POLY1305_IRQ_FINAL;
+  }
+
+  poly1305_clear_stats(dev);
+  return POLY1305_OK;
+}
+
+
+//------------------------------------------------------------------
+// poly1305_invalidate_key()
+//
+// Force the key to be written for the next message. Must be
+// called if the key registers may have been changed by someone
+// else, for example after a context restore.
+//------------------------------------------------------------------
+void poly1305_invalidate_key(poly1305_dev *dev) {
+  dev->key_valid = 0;
+}
+
+
+//------------------------------------------------------------------
+// poly1305_start()
+//
+// Start a new message. Only key words that differ from the
+// words last written are written. The init command is not
+// followed by a status poll, the FIFO drain logic waits for the
+// core to be ready before the first block is processed.
+//------------------------------------------------------------------
+int poly1305_start(poly1305_dev *dev, const uint8_t key[32]) {
+  for (uint8_t i = 0 ; i < 8 ; i++) {
+    uint32_t w = get_word(&key[i * 4]);
+
+    if (dev->key_valid && (dev->key[i] == w)) {
+      dev->stats.key_writes_saved++;
+    }
+    else {
+      bus_write(dev, POLY1305_ADDR_KEY0 + i, w);
+      dev->key[i] = w;
+    }
+  }
+  dev->key_valid = 1;
+
+  bus_write(dev, POLY1305_ADDR_CTRL, POLY1305_CTRL_INIT);
+  dev->buf_len     = 0;
+  dev->block_bytes = 0;
+  return POLY1305_OK;
+}
+
+
+//------------------------------------------------------------------
+// poly1305_update()
+//
+// Add message bytes. Bytes are buffered until a complete word
+// can be written, so that each word is written once regardless
+// of how the message is split into update calls.
+//------------------------------------------------------------------
+int poly1305_update(poly1305_dev *dev, const uint8_t *msg, size_t len) {
+  int res;
+
+  dev->stats.bytes += len;
+
+  while ((len > 0) && (dev->buf_len > 0)) {
+    dev->buf[dev->buf_len++] = *msg++;
+    len--;
+
+    if (dev->buf_len == 4) {
+      dev->buf_len = 0;
+      res = write_fifo_word(dev, get_word(dev->buf));
+      if (res != POLY1305_OK)
+        return res;
+    }
+  }
+
+  while (len >= 4) {
+    res = write_fifo_word(dev, get_word(msg));
+    if (res != POLY1305_OK)
+      return res;
+    msg += 4;
+    len -= 4;
+  }
+
+  while (len > 0) {
+    dev->buf[dev->buf_len++] = *msg++;
+    len--;
+  }
+
+  return POLY1305_OK;
+}
+
+
+//------------------------------------------------------------------
+// poly1305_finish()
+//
+// Push the final block, wait for the final processing and read
+// the tag. The final block is processed with last set, and no
+// separate finish command is needed. A final block of 13..15
+// bytes is written as four words with the last word padded. The
+// device holds the last full block until ADDR_LASTLEN has been
+// written, and the length written trims the padding.
+//------------------------------------------------------------------
+int poly1305_finish(poly1305_dev *dev, uint8_t tag[16]) {
+  uint32_t lastlen = dev->block_bytes + dev->buf_len;
+  int res;
+
+  if (dev->buf_len > 0) {
+    memset(&dev->buf[dev->buf_len], 0, 4 - dev->buf_len);
+    dev->buf_len = 0;
+    res = write_fifo_word(dev, get_word(dev->buf));
+  }
+  else if (dev->block_bytes == 0) {
+    res = get_credit(dev);
+  }
+  else {
+    res = POLY1305_OK;
+  }
+
+  if (res != POLY1305_OK)
+    return res;
+
+  if (dev->bus.wait_irq)
+    set_irq_mask(dev, POLY1305_IRQ_FINAL);
+
+  bus_write(dev, POLY1305_ADDR_LASTLEN, lastlen);
+  dev->block_bytes = 0;
+
+  res = wait_final(dev);
+  if (res != POLY1305_OK)
+    return res;
+
+  for (uint8_t i = 0 ; i < 4 ; i++) {
+    uint32_t w = bus_read(dev, POLY1305_ADDR_MAC0 + i);
+    tag[i * 4 + 0] = (w >> 24) & 0xff;
+    tag[i * 4 + 1] = (w >> 16) & 0xff;
+    tag[i * 4 + 2] = (w >>  8) & 0xff;
+    tag[i * 4 + 3] = w & 0xff;
+  }
+
+  dev->stats.messages++;
+  return POLY1305_OK;
+}
+
+
+//------------------------------------------------------------------
+// poly1305_mac()
+//
+// Generate the tag for a complete message.
+//------------------------------------------------------------------
+int poly1305_mac(poly1305_dev *dev, const uint8_t key[32],
+                 const uint8_t *msg, size_t len, uint8_t tag[16]) {
+  int res;
+
+  res = poly1305_start(dev, key);
+  if (res != POLY1305_OK)
+    return res;
+
+  res = poly1305_update(dev, msg, len);
+  if (res != POLY1305_OK)
+    return res;
+
+  return poly1305_finish(dev, tag);
+}
+
+
+//------------------------------------------------------------------
+// poly1305_clear_stats()
+//------------------------------------------------------------------
+void poly1305_clear_stats(poly1305_dev *dev) {
+  memset(&dev->stats, 0, sizeof(dev->stats));
+}
+
+
+//------------------------------------------------------------------
+// poly1305_print_stats()
+//------------------------------------------------------------------
+void poly1305_print_stats(const poly1305_dev *dev) {
+  const poly1305_stats *s = &dev->stats;
+  uint64_t trans = s->reads + s->writes;
+
+  printf("Messages:           %llu\n", (unsigned long long) s->messages);
+  printf("Bytes:              %llu\n", (unsigned long long) s->bytes);
+  printf("Bus reads:          %llu\n", (unsigned long long) s->reads);
+  printf("Bus writes:         %llu\n", (unsigned long long) s->writes);
+  printf("Polls:              %llu\n", (unsigned long long) s->polls);
+  printf("Key writes saved:   %llu\n", (unsigned long long) s->key_writes_saved);
+
+  if (s->bytes)
+    printf("Transactions/byte:  %.3f\n", (double) trans / (double) s->bytes);
+
+  if (s->messages)
+    printf("Transactions/msg:   %.1f\n", (double) trans / (double) s->messages);
+}
+
+
+//------------------------------------------------------------------
+// Memory mapped backend.
+//------------------------------------------------------------------
+static uint32_t mmio_read(void *ctx, uint8_t address) {
+  volatile uint32_t *base = (volatile uint32_t *) ctx;
+  return base[address];
+}
+
+
+static void mmio_write(void *ctx, uint8_t address, uint32_t data) {
+  volatile uint32_t *base = (volatile uint32_t *) ctx;
+  base[address] = data;
+}
+
+
+void poly1305_mmio_bus(poly1305_bus *bus, volatile uint32_t *base) {
+  bus->ctx      = (void *) base;
+  bus->read     = mmio_read;
+  bus->write    = mmio_write;
+  bus->wait_irq = NULL;
+}
+
+//======================================================================
+// EOF poly1305_drv.c
+//======================================================================
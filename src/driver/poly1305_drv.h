@@ -0,0 +1,199 @@
+//======================================================================
+//
+// poly1305_drv.h
+// --------------
+// Driver for the Poly1305 top level register interface. The driver
+// accesses the device through a pluggable bus backend, provides a
+// streaming MAC API and counts the bus transactions used.
+//
+// The message is written through the block FIFO. Message bytes are
+// packed into words and written to ADDR_FIFO_DATA, and the final
+// block is pushed with ADDR_LASTLEN. The FIFO credits are read only
+// when the credits given by the previous read have been used, and
+// the status is polled only when the MAC is needed.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+#ifndef POLY1305_DRV_H
+#define POLY1305_DRV_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+//------------------------------------------------------------------
+// Register addresses and bits.
+//------------------------------------------------------------------
+#define POLY1305_ADDR_NAME0       0x00
+#define POLY1305_ADDR_NAME1       0x01
+#define POLY1305_ADDR_VERSION     0x02
+
+#define POLY1305_ADDR_CTRL        0x08
+#define POLY1305_CTRL_INIT        0x01
+#define POLY1305_CTRL_NEXT        0x02
+#define POLY1305_CTRL_FINISH      0x04
+#define POLY1305_CTRL_LAST        0x08
+#define POLY1305_CTRL_VERIFY      0x10
+#define POLY1305_CTRL_FLUSH       0x40
+
+#define POLY1305_ADDR_STATUS      0x09
+#define POLY1305_STATUS_READY     0x01
+#define POLY1305_STATUS_FULL      0x02
+#define POLY1305_STATUS_CTX_ERROR 0x20
+#define POLY1305_STATUS_OVERFLOW  0x40
+
+#define POLY1305_ADDR_BLOCKLEN    0x0a
+#define POLY1305_ADDR_IRQ_ENABLE  0x0c
+#define POLY1305_ADDR_IRQ_MASK    0x0d
+#define POLY1305_ADDR_IRQ_STATUS  0x0e
+#define POLY1305_IRQ_BLOCK        0x02
+#define POLY1305_IRQ_FINAL        0x04
+#define POLY1305_ADDR_CREDITS     0x0f
+
+#define POLY1305_ADDR_KEY0        0x10
+#define POLY1305_ADDR_BLOCK0      0x20
+#define POLY1305_ADDR_FIFO_DATA   0x24
+#define POLY1305_ADDR_LASTLEN     0x25
+#define POLY1305_ADDR_FRAGLEN     0x26
+#define POLY1305_ADDR_FIFO_FRAG   0x27
+#define POLY1305_ADDR_MAC0        0x30
+
+#define POLY1305_NAME0            0x706f6c79
+#define POLY1305_NAME1            0x31333035
+
+
+//------------------------------------------------------------------
+// Return codes.
+//------------------------------------------------------------------
+#define POLY1305_OK               0
+#define POLY1305_ERR_DEVICE       1
+#define POLY1305_ERR_TIMEOUT      2
+
+// Upper limit for the number of status or credit polls.
+#define POLY1305_MAX_POLLS        1000000
+
+
+//------------------------------------------------------------------
+// poly1305_bus
+//
+// Bus backend. Each read and write is one bus transaction to the
+// word address given. The wait_irq function is optional. If set,
+// it must return when the irq output of the device is set, and is
+// used instead of polling when the FIFO is full and when waiting
+// for the MAC. It returns non zero on timeout.
+//------------------------------------------------------------------
+typedef struct {
+  void     *ctx;
+  uint32_t (*read)(void *ctx, uint8_t address);
+  void     (*write)(void *ctx, uint8_t address, uint32_t data);
+  int      (*wait_irq)(void *ctx);
+} poly1305_bus;
+
+
+//------------------------------------------------------------------
+// poly1305_stats
+//
+// Bus transaction counters. Polls are the status and credit reads
+// that did not allow the driver to proceed.
+//------------------------------------------------------------------
+typedef struct {
+  uint64_t reads;
+  uint64_t writes;
+  uint64_t polls;
+  uint64_t key_writes_saved;
+  uint64_t bytes;
+  uint64_t messages;
+} poly1305_stats;
+
+
+//------------------------------------------------------------------
+// poly1305_dev
+//
+// Driver state for one device.
+//------------------------------------------------------------------
+typedef struct {
+  poly1305_bus   bus;
+  poly1305_stats stats;
+
+  // Words last written to the key registers.
+  uint32_t       key[8];
+  int            key_valid;
+
+  // Bytes not yet written, and the number of bytes in the
+  // current block that have been written as words.
+  uint8_t        buf[4];
+  uint32_t       buf_len;
+  uint32_t       block_bytes;
+
+  // Number of blocks that can be pushed to the FIFO.
+  uint32_t       credits;
+
+  // Events currently set in the irq mask.
+  uint32_t       irq_mask;
+} poly1305_dev;
+
+
+//------------------------------------------------------------------
+// Driver API.
+//------------------------------------------------------------------
+int  poly1305_open(poly1305_dev *dev, const poly1305_bus *bus);
+void poly1305_invalidate_key(poly1305_dev *dev);
+
+int  poly1305_start(poly1305_dev *dev, const uint8_t key[32]);
+int  poly1305_update(poly1305_dev *dev, const uint8_t *msg, size_t len);
+int  poly1305_finish(poly1305_dev *dev, uint8_t tag[16]);
+int  poly1305_mac(poly1305_dev *dev, const uint8_t key[32],
+                  const uint8_t *msg, size_t len, uint8_t tag[16]);
+
+void poly1305_clear_stats(poly1305_dev *dev);
+void poly1305_print_stats(const poly1305_dev *dev);
+
+
+//------------------------------------------------------------------
+// Memory mapped backend. The registers are 32-bit words at
+// consecutive word addresses from base.
+//------------------------------------------------------------------
+void poly1305_mmio_bus(poly1305_bus *bus, volatile uint32_t *base);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POLY1305_DRV_H
+
+//======================================================================
+// EOF poly1305_drv.h
+//======================================================================
@@ -0,0 +1,192 @@
+//======================================================================
+//
+// poly1305_vl.cpp
+// ---------------
+// Bus backend for the driver using a Verilator model of the
+// Poly1305 top.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+#include "verilated.h"
+#include "Vpoly1305.h"
+
+#include "poly1305_vl.h"
+
+
+//------------------------------------------------------------------
+// Constants.
+//------------------------------------------------------------------
+// Upper limit for the number of cycles waiting for the irq.
+static const uint64_t MAX_WAIT = 100000;
+
+
+//------------------------------------------------------------------
+// poly1305_vl
+//------------------------------------------------------------------
+struct poly1305_vl {
+  Vpoly1305 *dut;
+  uint64_t  cycles;
+};
+
+
+//------------------------------------------------------------------
+// tick()
+//
+// Advance the model one clock cycle.
+//------------------------------------------------------------------
+static void tick(poly1305_vl *vl) {
+  vl->dut->clk = 1;
+  vl->dut->eval();
+  vl->dut->clk = 0;
+  vl->dut->eval();
+  vl->cycles++;
+}
+
+
+//------------------------------------------------------------------
+// vl_read()
+//
+// One cycle bus read. The read data is sampled before the
+// rising clock edge.
+//------------------------------------------------------------------
+static uint32_t vl_read(void *ctx, uint8_t address) {
+  poly1305_vl *vl = (poly1305_vl *) ctx;
+  uint32_t data;
+
+  vl->dut->cs      = 1;
+  vl->dut->we      = 0;
+  vl->dut->address = address;
+  vl->dut->eval();
+  data = vl->dut->read_data;
+  tick(vl);
+  vl->dut->cs      = 0;
+  return data;
+}
+
+
+//------------------------------------------------------------------
+// vl_write()
+//
+// One cycle bus write.
+//------------------------------------------------------------------
+static void vl_write(void *ctx, uint8_t address, uint32_t data) {
+  poly1305_vl *vl = (poly1305_vl *) ctx;
+
+  vl->dut->cs         = 1;
+  vl->dut->we         = 1;
+  vl->dut->address    = address;
+  vl->dut->write_data = data;
+  tick(vl);
+  vl->dut->cs         = 0;
+  vl->dut->we         = 0;
+}
+
+
+//------------------------------------------------------------------
+// vl_wait_irq()
+//
+// Run the clock until the irq is set, without bus accesses.
+// Returns non zero on timeout.
+//------------------------------------------------------------------
+static int vl_wait_irq(void *ctx) {
+  poly1305_vl *vl = (poly1305_vl *) ctx;
+  uint64_t start = vl->cycles;
+
+  while (!vl->dut->irq) {
+    tick(vl);
+    if ((vl->cycles - start) > MAX_WAIT)
+      return 1;
+  }
+  return 0;
+}
+
+
+//------------------------------------------------------------------
+// poly1305_vl_open()
+//
+// Create the model and apply reset.
+//------------------------------------------------------------------
+poly1305_vl *poly1305_vl_open(void) {
+  poly1305_vl *vl = new poly1305_vl;
+
+  vl->dut     = new Vpoly1305;
+  vl->cycles  = 0;
+
+  vl->dut->clk        = 0;
+  vl->dut->cs         = 0;
+  vl->dut->we         = 0;
+  vl->dut->address    = 0;
+  vl->dut->write_data = 0;
+  vl->dut->reset_n    = 0;
+  tick(vl);
+  tick(vl);
+  vl->dut->reset_n    = 1;
+  tick(vl);
+  tick(vl);
+  return vl;
+}
+
+
+//------------------------------------------------------------------
+// poly1305_vl_close()
+//------------------------------------------------------------------
+void poly1305_vl_close(poly1305_vl *vl) {
+  vl->dut->final();
+  delete vl->dut;
+  delete vl;
+}
+
+
+//------------------------------------------------------------------
+// poly1305_vl_bus()
+//
+// Set up a bus backend for the model. If use_irq is set, the
+// driver waits for the irq instead of polling the status.
+//------------------------------------------------------------------
+void poly1305_vl_bus(poly1305_vl *vl, poly1305_bus *bus, int use_irq) {
+  bus->ctx      = vl;
+  bus->read     = vl_read;
+  bus->write    = vl_write;
+  bus->wait_irq = use_irq ? vl_wait_irq : NULL;
+}
+
+
+//------------------------------------------------------------------
+// poly1305_vl_cycles()
+//------------------------------------------------------------------
+uint64_t poly1305_vl_cycles(const poly1305_vl *vl) {
+  return vl->cycles;
+}
+
+//======================================================================
+// EOF poly1305_vl.cpp
+//======================================================================
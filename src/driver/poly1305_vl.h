@@ -0,0 +1,64 @@
+//======================================================================
+//
+// poly1305_vl.h
+// -------------
+// Bus backend for the driver using a Verilator model of the
+// Poly1305 top. Each bus access takes one clock cycle, in the same
+// way as in the testbench and the Verilator benchmark.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+#ifndef POLY1305_VL_H
+#define POLY1305_VL_H
+
+#include "poly1305_drv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct poly1305_vl poly1305_vl;
+
+poly1305_vl *poly1305_vl_open(void);
+void         poly1305_vl_close(poly1305_vl *vl);
+void         poly1305_vl_bus(poly1305_vl *vl, poly1305_bus *bus, int use_irq);
+uint64_t     poly1305_vl_cycles(const poly1305_vl *vl);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POLY1305_VL_H
+
+//======================================================================
+// EOF poly1305_vl.h
+//======================================================================
@@ -0,0 +1,225 @@
+//======================================================================
+//
+// miter_final.v
+// -------------
+// Transaction level miter that checks that the one and two cycle
+// final processing (poly1305_final with LATENCY 1 or 2) gives the
+// same result as the reference ripple final processing for all
+// operands within the documented bounds.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module miter_final #(parameter LATENCY = 1)
+                   (
+                    input wire clk
+                   );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam START_CYCLE = 8'h2;
+  localparam MAX_CYCLES  = 8'h10;
+
+
+  //----------------------------------------------------------------
+  // Registers.
+  //----------------------------------------------------------------
+  reg [7 : 0]  cycle_ctr_reg;
+
+  reg          ref_busy_reg;
+  reg          ref_done_reg;
+  reg [31 : 0] ref_hres_reg [0 : 3];
+
+  reg          var_busy_reg;
+  reg          var_done_reg;
+  reg [31 : 0] var_hres_reg [0 : 3];
+
+
+  //----------------------------------------------------------------
+  // Operands. These are held constant for the whole trace.
+  //----------------------------------------------------------------
+  (* anyconst *) reg [31 : 0] h0;
+  (* anyconst *) reg [31 : 0] h1;
+  (* anyconst *) reg [31 : 0] h2;
+  (* anyconst *) reg [31 : 0] h3;
+  (* anyconst *) reg [31 : 0] h4;
+
+  (* anyconst *) reg [31 : 0] s0;
+  (* anyconst *) reg [31 : 0] s1;
+  (* anyconst *) reg [31 : 0] s2;
+  (* anyconst *) reg [31 : 0] s3;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  wire          reset_n;
+  wire          start;
+
+  wire          ref_ready;
+  wire [31 : 0] ref_hres [0 : 3];
+
+  wire          var_ready;
+  wire [31 : 0] var_hres [0 : 3];
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity.
+  //----------------------------------------------------------------
+  assign reset_n = (cycle_ctr_reg > 8'h0);
+  assign start   = (cycle_ctr_reg == START_CYCLE);
+
+
+  //----------------------------------------------------------------
+  // Reference and variant under test.
+  //----------------------------------------------------------------
+  poly1305_final #(.LATENCY(0))
+                 ref_inst(
+                          .clk(clk),
+                          .reset_n(reset_n),
+                          .start(start),
+                          .ready(ref_ready),
+                          .h0(h0), .h1(h1), .h2(h2), .h3(h3), .h4(h4),
+                          .s0(s0), .s1(s1), .s2(s2), .s3(s3),
+                          .hres0(ref_hres[0]),
+                          .hres1(ref_hres[1]),
+                          .hres2(ref_hres[2]),
+                          .hres3(ref_hres[3])
+                         );
+
+
+  poly1305_final #(.LATENCY(LATENCY))
+                 var_inst(
+                          .clk(clk),
+                          .reset_n(reset_n),
+                          .start(start),
+                          .ready(var_ready),
+                          .h0(h0), .h1(h1), .h2(h2), .h3(h3), .h4(h4),
+                          .s0(s0), .s1(s1), .s2(s2), .s3(s3),
+                          .hres0(var_hres[0]),
+                          .hres1(var_hres[1]),
+                          .hres2(var_hres[2]),
+                          .hres3(var_hres[3])
+                         );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // The transaction is started two cycles after reset. The result
+  // from each implementation is captured in the first cycle after
+  // start where ready is set. With LATENCY one, ready is never
+  // cleared and the result is captured directly.
+  //----------------------------------------------------------------
+  initial cycle_ctr_reg = 8'h0;
+
+  always @ (posedge clk)
+    begin : reg_update
+      integer i;
+
+      if (cycle_ctr_reg < MAX_CYCLES)
+        cycle_ctr_reg <= cycle_ctr_reg + 1'h1;
+
+      if (!reset_n)
+        begin
+          ref_busy_reg <= 1'h0;
+          ref_done_reg <= 1'h0;
+          var_busy_reg <= 1'h0;
+          var_done_reg <= 1'h0;
+        end
+      else
+        begin
+          if (start)
+            begin
+              ref_busy_reg <= 1'h1;
+              var_busy_reg <= 1'h1;
+            end
+
+          if (ref_busy_reg && ref_ready)
+            begin
+              ref_busy_reg <= 1'h0;
+              ref_done_reg <= 1'h1;
+              for (i = 0 ; i < 4 ; i = i + 1)
+                ref_hres_reg[i] <= ref_hres[i];
+            end
+
+          if (var_busy_reg && var_ready)
+            begin
+              var_busy_reg <= 1'h0;
+              var_done_reg <= 1'h1;
+              for (i = 0 ; i < 4 ; i = i + 1)
+                var_hres_reg[i] <= var_hres[i];
+            end
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // Operand bounds.
+  //
+  // h is the partially reduced hash from the block processing,
+  // h <= 4_ffffffff_ffffffff_ffffffff_ffffffff.
+  //----------------------------------------------------------------
+  always @*
+    begin : bounds
+      assume(h4 <= 32'h4);
+    end // bounds
+
+
+  //----------------------------------------------------------------
+  // equivalence
+  //----------------------------------------------------------------
+  always @*
+    begin : equivalence
+      if (ref_done_reg && var_done_reg)
+        begin
+          assert(ref_hres_reg[0] == var_hres_reg[0]);
+          assert(ref_hres_reg[1] == var_hres_reg[1]);
+          assert(ref_hres_reg[2] == var_hres_reg[2]);
+          assert(ref_hres_reg[3] == var_hres_reg[3]);
+        end
+
+      if (cycle_ctr_reg == MAX_CYCLES)
+        begin
+          assert(ref_done_reg);
+          assert(var_done_reg);
+        end
+    end // equivalence
+
+endmodule // miter_final
+
+//======================================================================
+// EOF miter_final.v
+//======================================================================
@@ -0,0 +1,336 @@
+//======================================================================
+//
+// miter_pblock.v
+// --------------
+// Transaction level miter that checks that a block processing
+// variant (poly1305_pblock_ll or poly1305_pblock_pipe) gives the
+// same results as the reference poly1305_pblock for two back to
+// back transactions with operands within the documented bounds.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module miter_pblock #(parameter VARIANT    = 1,
+                      parameter PIPE_DEPTH = 9)
+                    (
+                     input wire clk
+                    );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam VARIANT_LL   = 1;
+  localparam VARIANT_PIPE = 2;
+
+  localparam START_CYCLE  = 8'h2;
+  localparam MAX_CYCLES   = 8'h28;
+
+  localparam NUM_TRANS    = 2'h2;
+
+
+  //----------------------------------------------------------------
+  // Registers.
+  //----------------------------------------------------------------
+  reg [7 : 0]  cycle_ctr_reg;
+
+  reg          ref_busy_reg;
+  reg [1 : 0]  ref_ctr_reg;
+  reg [31 : 0] ref_ha_reg [0 : 4];
+  reg [31 : 0] ref_hb_reg [0 : 4];
+
+  reg          var_busy_reg;
+  reg [1 : 0]  var_ctr_reg;
+  reg [31 : 0] var_ha_reg [0 : 4];
+  reg [31 : 0] var_hb_reg [0 : 4];
+
+
+  //----------------------------------------------------------------
+  // Operands. There is one set of operands per transaction. The
+  // operands are held constant for the whole trace, but are
+  // otherwise free within the bounds.
+  //----------------------------------------------------------------
+  (* anyconst *) reg [159 : 0] h_a;
+  (* anyconst *) reg [159 : 0] c_a;
+  (* anyconst *) reg [127 : 0] r_a;
+
+  (* anyconst *) reg [159 : 0] h_b;
+  (* anyconst *) reg [159 : 0] c_b;
+  (* anyconst *) reg [127 : 0] r_b;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  wire           reset_n;
+
+  wire           ref_start;
+  wire [159 : 0] ref_h;
+  wire [159 : 0] ref_c;
+  wire [127 : 0] ref_r;
+  wire           ref_ready;
+  wire [31 : 0]  ref_h_new [0 : 4];
+
+  wire           var_start;
+  wire [159 : 0] var_h;
+  wire [159 : 0] var_c;
+  wire [127 : 0] var_r;
+  wire [31 : 0]  var_rr0;
+  wire [31 : 0]  var_rr1;
+  wire [31 : 0]  var_rr2;
+  wire [31 : 0]  var_rr3;
+  wire           var_ready;
+  wire [31 : 0]  var_h_new [0 : 4];
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity.
+  //
+  // Each implementation starts the first transaction at
+  // START_CYCLE, and the second transaction directly after the
+  // first has been completed. The operands are selected by the
+  // number of completed transactions.
+  //----------------------------------------------------------------
+  assign reset_n   = (cycle_ctr_reg > 8'h0);
+
+  assign ref_start = (cycle_ctr_reg >= START_CYCLE) && !ref_busy_reg &&
+                     (ref_ctr_reg < NUM_TRANS);
+  assign ref_h     = (ref_ctr_reg == 2'h0) ? h_a : h_b;
+  assign ref_c     = (ref_ctr_reg == 2'h0) ? c_a : c_b;
+  assign ref_r     = (ref_ctr_reg == 2'h0) ? r_a : r_b;
+
+  assign var_start = (cycle_ctr_reg >= START_CYCLE) && !var_busy_reg &&
+                     (var_ctr_reg < NUM_TRANS);
+  assign var_h     = (var_ctr_reg == 2'h0) ? h_a : h_b;
+  assign var_c     = (var_ctr_reg == 2'h0) ? c_a : c_b;
+  assign var_r     = (var_ctr_reg == 2'h0) ? r_a : r_b;
+
+  // Same as the precomputed 5 * r values in the core.
+  assign var_rr0 = (var_r[31 : 0] >> 2) * 5;
+  assign var_rr1 = (var_r[63 : 32] >> 2) + var_r[63 : 32];
+  assign var_rr2 = (var_r[95 : 64] >> 2) + var_r[95 : 64];
+  assign var_rr3 = (var_r[127 : 96] >> 2) + var_r[127 : 96];
+
+
+  //----------------------------------------------------------------
+  // Reference.
+  //----------------------------------------------------------------
+  poly1305_pblock ref_inst(
+                           .clk(clk),
+                           .reset_n(reset_n),
+                           .start(ref_start),
+                           .ready(ref_ready),
+                           .h0(ref_h[31 : 0]), .h1(ref_h[63 : 32]),
+                           .h2(ref_h[95 : 64]), .h3(ref_h[127 : 96]),
+                           .h4(ref_h[159 : 128]),
+                           .c0(ref_c[31 : 0]), .c1(ref_c[63 : 32]),
+                           .c2(ref_c[95 : 64]), .c3(ref_c[127 : 96]),
+                           .c4(ref_c[159 : 128]),
+                           .r0(ref_r[31 : 0]), .r1(ref_r[63 : 32]),
+                           .r2(ref_r[95 : 64]), .r3(ref_r[127 : 96]),
+                           .h0_new(ref_h_new[0]),
+                           .h1_new(ref_h_new[1]),
+                           .h2_new(ref_h_new[2]),
+                           .h3_new(ref_h_new[3]),
+                           .h4_new(ref_h_new[4])
+                          );
+
+
+  //----------------------------------------------------------------
+  // Variant under test.
+  //----------------------------------------------------------------
+  generate
+    if (VARIANT == VARIANT_LL)
+      begin : ll_gen
+        poly1305_pblock_ll var_inst(
+                                    .clk(clk),
+                                    .reset_n(reset_n),
+                                    .start(var_start),
+                                    .ready(var_ready),
+                                    .h0(var_h[31 : 0]), .h1(var_h[63 : 32]),
+                                    .h2(var_h[95 : 64]), .h3(var_h[127 : 96]),
+                                    .h4(var_h[159 : 128]),
+                                    .c0(var_c[31 : 0]), .c1(var_c[63 : 32]),
+                                    .c2(var_c[95 : 64]), .c3(var_c[127 : 96]),
+                                    .c4(var_c[159 : 128]),
+                                    .r0(var_r[31 : 0]), .r1(var_r[63 : 32]),
+                                    .r2(var_r[95 : 64]), .r3(var_r[127 : 96]),
+                                    .rr0(var_rr0), .rr1(var_rr1),
+                                    .rr2(var_rr2), .rr3(var_rr3),
+                                    .h0_new(var_h_new[0]),
+                                    .h1_new(var_h_new[1]),
+                                    .h2_new(var_h_new[2]),
+                                    .h3_new(var_h_new[3]),
+                                    .h4_new(var_h_new[4])
+                                   );
+      end
+    else
+      begin : pipe_gen
+        poly1305_pblock_pipe #(.PIPE_DEPTH(PIPE_DEPTH))
+                             var_inst(
+                                      .clk(clk),
+                                      .reset_n(reset_n),
+                                      .start(var_start),
+                                      .ready(var_ready),
+                                      .h0(var_h[31 : 0]), .h1(var_h[63 : 32]),
+                                      .h2(var_h[95 : 64]), .h3(var_h[127 : 96]),
+                                      .h4(var_h[159 : 128]),
+                                      .c0(var_c[31 : 0]), .c1(var_c[63 : 32]),
+                                      .c2(var_c[95 : 64]), .c3(var_c[127 : 96]),
+                                      .c4(var_c[159 : 128]),
+                                      .r0(var_r[31 : 0]), .r1(var_r[63 : 32]),
+                                      .r2(var_r[95 : 64]), .r3(var_r[127 : 96]),
+                                      .h0_new(var_h_new[0]),
+                                      .h1_new(var_h_new[1]),
+                                      .h2_new(var_h_new[2]),
+                                      .h3_new(var_h_new[3]),
+                                      .h4_new(var_h_new[4])
+                                     );
+      end
+  endgenerate
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // The first transaction is started two cycles after reset. The
+  // result from each transaction is captured in the first cycle
+  // after start where ready is set.
+  //----------------------------------------------------------------
+  initial cycle_ctr_reg = 8'h0;
+
+  always @ (posedge clk)
+    begin : reg_update
+      integer i;
+
+      if (cycle_ctr_reg < MAX_CYCLES)
+        cycle_ctr_reg <= cycle_ctr_reg + 1'h1;
+
+      if (!reset_n)
+        begin
+          ref_busy_reg <= 1'h0;
+          ref_ctr_reg  <= 2'h0;
+          var_busy_reg <= 1'h0;
+          var_ctr_reg  <= 2'h0;
+        end
+      else
+        begin
+          if (ref_start)
+            ref_busy_reg <= 1'h1;
+
+          if (var_start)
+            var_busy_reg <= 1'h1;
+
+          if (ref_busy_reg && ref_ready)
+            begin
+              ref_busy_reg <= 1'h0;
+              ref_ctr_reg  <= ref_ctr_reg + 1'h1;
+              for (i = 0 ; i < 5 ; i = i + 1)
+                if (ref_ctr_reg == 2'h0)
+                  ref_ha_reg[i] <= ref_h_new[i];
+                else
+                  ref_hb_reg[i] <= ref_h_new[i];
+            end
+
+          if (var_busy_reg && var_ready)
+            begin
+              var_busy_reg <= 1'h0;
+              var_ctr_reg  <= var_ctr_reg + 1'h1;
+              for (i = 0 ; i < 5 ; i = i + 1)
+                if (var_ctr_reg == 2'h0)
+                  var_ha_reg[i] <= var_h_new[i];
+                else
+                  var_hb_reg[i] <= var_h_new[i];
+            end
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // Operand bounds.
+  //
+  // The bounds are the same as for poly_block() in the model:
+  // h <= 4_ffffffff_ffffffff_ffffffff_ffffffff,
+  // c <= 1_ffffffff_ffffffff_ffffffff_ffffffff and r clamped.
+  //----------------------------------------------------------------
+  always @*
+    begin : bounds
+      assume(h_a[159 : 128] <= 32'h4);
+      assume(c_a[159 : 128] <= 32'h1);
+      assume((r_a & 128'h0ffffffc_0ffffffc_0ffffffc_0fffffff) == r_a);
+
+      assume(h_b[159 : 128] <= 32'h4);
+      assume(c_b[159 : 128] <= 32'h1);
+      assume((r_b & 128'h0ffffffc_0ffffffc_0ffffffc_0fffffff) == r_b);
+    end // bounds
+
+
+  //----------------------------------------------------------------
+  // equivalence
+  //
+  // Both implementations must complete both transactions, and
+  // produce the same results. The second transaction checks
+  // that no state from the first transaction affects the result.
+  //----------------------------------------------------------------
+  always @*
+    begin : equivalence
+      if ((ref_ctr_reg >= 2'h1) && (var_ctr_reg >= 2'h1))
+        begin
+          assert(ref_ha_reg[0] == var_ha_reg[0]);
+          assert(ref_ha_reg[1] == var_ha_reg[1]);
+          assert(ref_ha_reg[2] == var_ha_reg[2]);
+          assert(ref_ha_reg[3] == var_ha_reg[3]);
+          assert(ref_ha_reg[4] == var_ha_reg[4]);
+        end
+
+      if ((ref_ctr_reg == NUM_TRANS) && (var_ctr_reg == NUM_TRANS))
+        begin
+          assert(ref_hb_reg[0] == var_hb_reg[0]);
+          assert(ref_hb_reg[1] == var_hb_reg[1]);
+          assert(ref_hb_reg[2] == var_hb_reg[2]);
+          assert(ref_hb_reg[3] == var_hb_reg[3]);
+          assert(ref_hb_reg[4] == var_hb_reg[4]);
+        end
+
+      if (cycle_ctr_reg == MAX_CYCLES)
+        begin
+          assert(ref_ctr_reg == NUM_TRANS);
+          assert(var_ctr_reg == NUM_TRANS);
+        end
+    end // equivalence
+
+endmodule // miter_pblock
+
+//======================================================================
+// EOF miter_pblock.v
+//======================================================================
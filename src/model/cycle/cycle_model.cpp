@@ -0,0 +1,464 @@
+//======================================================================
+//
+// cycle_model.cpp
+// ---------------
+// Performance estimation using the cycle accurate Poly1305 model.
+//
+// Without arguments, the same message sizes as in the Verilator
+// benchmark (src/bench) are processed with the core and the top
+// model, and the cycles are reported. The result can be checked
+// against a baseline file written by the Verilator benchmark.
+//
+// A message mix can be given to estimate the throughput for a
+// given clock frequency.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "poly1305_cycle.h"
+
+
+//------------------------------------------------------------------
+// Constants.
+//------------------------------------------------------------------
+static const uint32_t MESSAGE_SIZES[] = {0, 1, 16, 64, 256, 1024,
+                                         4096, 16384, 65536};
+static const uint32_t NUM_SIZES = sizeof(MESSAGE_SIZES) / sizeof(uint32_t);
+
+// Key from RFC 8439, section 2.5.2.
+static const uint8_t RFC_KEY[32] = {
+  0x85, 0xd6, 0xbe, 0x78, 0x57, 0x55, 0x6d, 0x33,
+  0x7f, 0x44, 0x52, 0xfe, 0x42, 0xd5, 0x06, 0xa8,
+  0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd,
+  0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b};
+
+static const uint8_t RFC_MSG[34] = {
+  0x43, 0x72, 0x79, 0x70, 0x74, 0x6f, 0x67, 0x72,
+  0x61, 0x70, 0x68, 0x69, 0x63, 0x20, 0x46, 0x6f,
+  0x72, 0x75, 0x6d, 0x20, 0x52, 0x65, 0x73, 0x65,
+  0x61, 0x72, 0x63, 0x68, 0x20, 0x47, 0x72, 0x6f,
+  0x75, 0x70};
+
+static const uint8_t RFC_TAG[16] = {
+  0xa8, 0x06, 0x1d, 0xc1, 0x30, 0x51, 0x36, 0xc6,
+  0xc2, 0x2b, 0x8b, 0xaf, 0x0c, 0x01, 0x27, 0xa9};
+
+static const uint8_t NUL_TAG[16] = {
+  0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd,
+  0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b};
+
+
+//------------------------------------------------------------------
+// get_word()
+//
+// Get the big endian 32-bit word starting at the given byte
+// offset in a buffer. Bytes after the end are read as zero.
+//------------------------------------------------------------------
+static uint32_t get_word(const uint8_t *buf, uint32_t len, uint32_t offset) {
+  uint32_t w = 0;
+  for (uint32_t i = 0 ; i < 4 ; i++) {
+    w <<= 8;
+    if ((offset + i) < len)
+      w |= buf[offset + i];
+  }
+  return w;
+}
+
+
+//------------------------------------------------------------------
+// core_message()
+//
+// Process a message with the core model in the same way as the
+// Verilator benchmark. Returns the number of cycles used.
+//------------------------------------------------------------------
+static uint64_t core_message(Poly1305CoreModel &core, const uint8_t *key,
+                             const uint8_t *msg, uint32_t len, uint8_t *tag) {
+  uint64_t start = core.cycles;
+  uint32_t num_blocks = (len == 0) ? 1 : (len + 15) / 16;
+
+  memcpy(core.key, key, 32);
+  core.init = true;
+  core.tick();
+  core.init = false;
+  while (!core.ready)
+    core.tick();
+
+  for (uint32_t b = 0 ; b < num_blocks ; b++) {
+    uint32_t offset   = b * 16;
+    uint32_t blocklen = ((len - offset) > 16) ? 16 : (len - offset);
+
+    memset(core.block, 0, 16);
+    memcpy(core.block, &msg[offset], blocklen);
+    core.blocklen = blocklen;
+    core.last     = (b == (num_blocks - 1));
+    core.next     = true;
+    core.tick();
+    core.next     = false;
+    core.last     = false;
+    while (!core.ready)
+      core.tick();
+  }
+
+  memcpy(tag, core.mac, 16);
+  return core.cycles - start;
+}
+
+
+//------------------------------------------------------------------
+// top_message()
+//
+// Process a message through the top model register interface
+// in the same way as the Verilator benchmark. Returns the number
+// of bus cycles used.
+//------------------------------------------------------------------
+static void top_wait_ready(Poly1305TopModel &top) {
+  while (!(top.read(Poly1305TopModel::ADDR_STATUS) & 1))
+    ;
+}
+
+static uint64_t top_message(Poly1305TopModel &top, const uint8_t *key,
+                            const uint8_t *msg, uint32_t len, uint8_t *tag) {
+  uint64_t start = top.cycles();
+  uint32_t num_blocks = (len == 0) ? 1 : (len + 15) / 16;
+
+  for (uint32_t i = 0 ; i < 8 ; i++)
+    top.write(Poly1305TopModel::ADDR_KEY0 + i, get_word(key, 32, i * 4));
+
+  top.write(Poly1305TopModel::ADDR_CTRL, Poly1305TopModel::CTRL_INIT_BIT);
+  top_wait_ready(top);
+
+  for (uint32_t b = 0 ; b < num_blocks ; b++) {
+    uint32_t offset   = b * 16;
+    uint32_t blocklen = ((len - offset) > 16) ? 16 : (len - offset);
+    uint32_t ctrl     = Poly1305TopModel::CTRL_NEXT_BIT;
+
+    if (blocklen > 0) {
+      for (uint32_t i = 0 ; i < 4 ; i++)
+        top.write(Poly1305TopModel::ADDR_BLOCK0 + i,
+                  get_word(msg, offset + blocklen, offset + i * 4));
+    }
+
+    if (b == (num_blocks - 1))
+      ctrl |= Poly1305TopModel::CTRL_LAST_BIT;
+
+    top.write(Poly1305TopModel::ADDR_BLOCKLEN, blocklen);
+    top.write(Poly1305TopModel::ADDR_CTRL, ctrl);
+    top_wait_ready(top);
+  }
+
+  for (uint32_t i = 0 ; i < 4 ; i++) {
+    uint32_t w = top.read(Poly1305TopModel::ADDR_MAC0 + i);
+    tag[i * 4 + 0] = (w >> 24) & 0xff;
+    tag[i * 4 + 1] = (w >> 16) & 0xff;
+    tag[i * 4 + 2] = (w >>  8) & 0xff;
+    tag[i * 4 + 3] = w & 0xff;
+  }
+
+  return top.cycles() - start;
+}
+
+
+//------------------------------------------------------------------
+// check_tag()
+//------------------------------------------------------------------
+static int check_tag(const char *name, const uint8_t *tag, const uint8_t *expected) {
+  if (memcmp(tag, expected, 16) == 0) {
+    printf("%s: Correct tag generated.\n", name);
+    return 0;
+  }
+
+  printf("%s: Correct tag NOT generated.\n", name);
+  return 1;
+}
+
+
+//------------------------------------------------------------------
+// self_test()
+//
+// Check the tags from the core and top models against the
+// RFC 8439 test vectors.
+//------------------------------------------------------------------
+static int self_test(int final_latency) {
+  Poly1305CoreModel core(final_latency);
+  Poly1305TopModel top(final_latency);
+  uint8_t tag[16];
+  int error_ctr = 0;
+
+  core_message(core, RFC_KEY, RFC_MSG, 34, tag);
+  error_ctr += check_tag("core rfc8439", tag, RFC_TAG);
+  core_message(core, RFC_KEY, RFC_MSG, 0, tag);
+  error_ctr += check_tag("core bytes0", tag, NUL_TAG);
+
+  top_message(top, RFC_KEY, RFC_MSG, 34, tag);
+  error_ctr += check_tag("top rfc8439", tag, RFC_TAG);
+  top_message(top, RFC_KEY, RFC_MSG, 0, tag);
+  error_ctr += check_tag("top bytes0", tag, NUL_TAG);
+
+  return error_ctr;
+}
+
+
+//------------------------------------------------------------------
+// sweep()
+//
+// Process the benchmark message sizes with the core and top
+// models. The message data is the same as in the Verilator
+// benchmark.
+//------------------------------------------------------------------
+static void sweep(int final_latency, uint64_t *core_cycles, uint64_t *top_cycles) {
+  Poly1305CoreModel core(final_latency);
+  Poly1305TopModel top(final_latency);
+  std::vector<uint8_t> msg(MESSAGE_SIZES[NUM_SIZES - 1]);
+  uint8_t tag[16];
+
+  uint32_t lfsr = 0x13050001;
+  for (size_t i = 0 ; i < msg.size() ; i++) {
+    lfsr = lfsr * 1664525 + 1013904223;
+    msg[i] = lfsr >> 24;
+  }
+
+  // Same reset sequence as in the benchmark.
+  for (int i = 0 ; i < 2 ; i++)
+    top.idle();
+
+  printf("%8s %12s %12s %14s %14s\n", "bytes", "core cycles",
+         "bus cycles", "core cyc/byte", "bus cyc/byte");
+
+  for (uint32_t i = 0 ; i < NUM_SIZES ; i++) {
+    uint32_t len = MESSAGE_SIZES[i];
+
+    core_cycles[i] = core_message(core, RFC_KEY, &msg[0], len, tag);
+    top_cycles[i]  = top_message(top, RFC_KEY, &msg[0], len, tag);
+
+    if (len > 0)
+      printf("%8u %12llu %12llu %14.3f %14.3f\n", len,
+             (unsigned long long) core_cycles[i], (unsigned long long) top_cycles[i],
+             (double) core_cycles[i] / len, (double) top_cycles[i] / len);
+    else
+      printf("%8u %12llu %12llu %14s %14s\n", len,
+             (unsigned long long) core_cycles[i], (unsigned long long) top_cycles[i],
+             "-", "-");
+  }
+}
+
+
+//------------------------------------------------------------------
+// check_file()
+//
+// Compare the cycles against a file in the baseline format used
+// by the Verilator benchmark. The cycles must match exactly.
+//------------------------------------------------------------------
+static int check_file(const char *fname, const uint64_t *core_cycles,
+                      const uint64_t *top_cycles) {
+  std::ifstream f(fname);
+  std::string line;
+  int error_ctr = 0;
+  int match_ctr = 0;
+
+  if (!f) {
+    printf("Error: Could not open %s\n", fname);
+    return 1;
+  }
+
+  while (std::getline(f, line)) {
+    std::istringstream ss(line);
+    std::string name;
+    uint32_t size;
+    unsigned long long cycles;
+    const uint64_t *model = NULL;
+
+    if (line.empty() || (line[0] == '#'))
+      continue;
+
+    if (!(ss >> name >> size >> cycles))
+      continue;
+
+    if (name == "core")
+      model = core_cycles;
+    else if (name == "top")
+      model = top_cycles;
+    else
+      continue;
+
+    for (uint32_t i = 0 ; i < NUM_SIZES ; i++) {
+      if (MESSAGE_SIZES[i] != size)
+        continue;
+
+      match_ctr++;
+      if (model[i] != cycles) {
+        printf("Mismatch: %s at %u bytes. Model: %llu, file: %llu cycles.\n",
+               name.c_str(), size, (unsigned long long) model[i], cycles);
+        error_ctr++;
+      }
+    }
+  }
+
+  if (match_ctr == 0) {
+    printf("Error: No cycle counts found in %s\n", fname);
+    return 1;
+  }
+
+  printf("Checked %d cycle counts against %s: %s\n", match_ctr, fname,
+         (error_ctr == 0) ? "all match" : "mismatch");
+  return error_ctr;
+}
+
+
+//------------------------------------------------------------------
+// run_mix()
+//
+// Estimate the throughput for a message mix given as
+// size:count[,size:count...].
+//------------------------------------------------------------------
+static int run_mix(const char *mix, int final_latency, double freq_mhz) {
+  Poly1305CoreModel core(final_latency);
+  Poly1305TopModel top(final_latency);
+  std::vector<uint8_t> msg;
+  std::string s(mix);
+  std::stringstream ss(s);
+  std::string item;
+  uint64_t bytes       = 0;
+  uint64_t messages    = 0;
+  uint64_t core_cycles = 0;
+  uint64_t top_cycles  = 0;
+  uint8_t tag[16];
+
+  while (std::getline(ss, item, ',')) {
+    unsigned long size, count;
+
+    if (sscanf(item.c_str(), "%lu:%lu", &size, &count) != 2) {
+      printf("Error: Incorrect mix item '%s'\n", item.c_str());
+      return 1;
+    }
+
+    if (msg.size() < size)
+      msg.resize(size, 0xa5);
+
+    // The cycles only depend on the message length.
+    uint64_t cc = core_message(core, RFC_KEY, msg.data(), size, tag);
+    uint64_t tc = top_message(top, RFC_KEY, msg.data(), size, tag);
+
+    bytes       += (uint64_t) size * count;
+    messages    += count;
+    core_cycles += cc * count;
+    top_cycles  += tc * count;
+  }
+
+  printf("Messages: %llu, bytes: %llu\n", (unsigned long long) messages,
+         (unsigned long long) bytes);
+  printf("Core cycles: %llu, bus cycles: %llu\n",
+         (unsigned long long) core_cycles, (unsigned long long) top_cycles);
+
+  if (bytes > 0) {
+    printf("Core: %.3f cycles/byte, %.1f Mbps at %.1f MHz\n",
+           (double) core_cycles / bytes,
+           8.0 * bytes * freq_mhz / core_cycles, freq_mhz);
+    printf("Top:  %.3f cycles/byte, %.1f Mbps at %.1f MHz\n",
+           (double) top_cycles / bytes,
+           8.0 * bytes * freq_mhz / top_cycles, freq_mhz);
+  }
+
+  return 0;
+}
+
+
+//------------------------------------------------------------------
+// usage()
+//------------------------------------------------------------------
+static void usage(const char *name) {
+  printf("Usage: %s [options]\n", name);
+  printf("  --final-latency <n>  FINAL_LATENCY parameter (0..2, default 0).\n");
+  printf("  --check <file>       Check the cycles against a benchmark baseline file.\n");
+  printf("  --mix <s:n,...>      Estimate throughput for n messages of s bytes.\n");
+  printf("  --freq <MHz>         Clock frequency for the mix estimate (default 100).\n");
+}
+
+
+//------------------------------------------------------------------
+// main()
+//------------------------------------------------------------------
+int main(int argc, char **argv) {
+  int final_latency      = 0;
+  const char *check_name = NULL;
+  const char *mix        = NULL;
+  double freq_mhz        = 100.0;
+  uint64_t core_cycles[NUM_SIZES];
+  uint64_t top_cycles[NUM_SIZES];
+  int error_ctr;
+
+  for (int i = 1 ; i < argc ; i++) {
+    if ((strcmp(argv[i], "--final-latency") == 0) && ((i + 1) < argc))
+      final_latency = atoi(argv[++i]);
+    else if ((strcmp(argv[i], "--check") == 0) && ((i + 1) < argc))
+      check_name = argv[++i];
+    else if ((strcmp(argv[i], "--mix") == 0) && ((i + 1) < argc))
+      mix = argv[++i];
+    else if ((strcmp(argv[i], "--freq") == 0) && ((i + 1) < argc))
+      freq_mhz = atof(argv[++i]);
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if ((final_latency < 0) || (final_latency > 2)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  error_ctr = self_test(final_latency);
+  if (error_ctr)
+    return 1;
+
+  if (mix)
+    return run_mix(mix, final_latency, freq_mhz);
+
+  sweep(final_latency, &core_cycles[0], &top_cycles[0]);
+
+  if (check_name)
+    error_ctr = check_file(check_name, &core_cycles[0], &top_cycles[0]);
+
+  return (error_ctr == 0) ? 0 : 1;
+}
+
+//======================================================================
+// EOF cycle_model.cpp
+//======================================================================
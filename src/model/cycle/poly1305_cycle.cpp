@@ -0,0 +1,596 @@
+//======================================================================
+//
+// poly1305_cycle.cpp
+// ------------------
+// Cycle accurate performance model of the Poly1305 core and the
+// top level register interface.
+//
+// Each module is modelled with a step() function that computes
+// the new register values from the current register values and
+// inputs, and a commit() function that updates the registers.
+// This corresponds to the combinational logic and the reg_update
+// process in the RTL.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+#include <string.h>
+#include "poly1305_cycle.h"
+
+
+//------------------------------------------------------------------
+// Constants mirroring the RTL.
+//------------------------------------------------------------------
+static const int PBLOCK_PRE_CYCLES  = 1;
+static const int PBLOCK_POST_CYCLES = 4;
+static const int FINAL_PIPE_CYCLES  = 6;
+
+
+//------------------------------------------------------------------
+// load32_le()
+// store32_le()
+//------------------------------------------------------------------
+static uint32_t load32_le(const uint8_t *s) {
+  return (uint32_t)s[0] | ((uint32_t)s[1] << 8) |
+    ((uint32_t)s[2] << 16) | ((uint32_t)s[3] << 24);
+}
+
+static void store32_le(uint8_t *out, uint32_t in) {
+  out[0] = in & 0xff;
+  out[1] = (in >> 8) & 0xff;
+  out[2] = (in >> 16) & 0xff;
+  out[3] = (in >> 24) & 0xff;
+}
+
+
+//------------------------------------------------------------------
+// Poly1305Mulacc
+//------------------------------------------------------------------
+void Poly1305Mulacc::reset() {
+  ctrl_reg = CTRL_IDLE;
+  ready    = false;
+}
+
+void Poly1305Mulacc::step(bool start) {
+  ctrl_new  = ctrl_reg;
+  ready_new = ready;
+
+  switch (ctrl_reg) {
+  case CTRL_IDLE:
+    if (start) {
+      ready_new = false;
+      ctrl_new  = CTRL_OP1;
+    }
+    break;
+
+  case CTRL_OP1: ctrl_new = CTRL_OP2; break;
+  case CTRL_OP2: ctrl_new = CTRL_OP3; break;
+  case CTRL_OP3: ctrl_new = CTRL_OP4; break;
+  case CTRL_OP4: ctrl_new = CTRL_SUM; break;
+
+  case CTRL_SUM:
+    ready_new = true;
+    ctrl_new  = CTRL_IDLE;
+    break;
+  }
+}
+
+void Poly1305Mulacc::commit() {
+  ctrl_reg = ctrl_new;
+  ready    = ready_new;
+}
+
+
+//------------------------------------------------------------------
+// Poly1305Pblock
+//------------------------------------------------------------------
+void Poly1305Pblock::reset() {
+  for (int i = 0 ; i < 4 ; i++)
+    mulacc[i].reset();
+
+  ctrl_reg      = CTRL_IDLE;
+  cycle_ctr_reg = 0;
+  ready         = true;
+}
+
+void Poly1305Pblock::step(bool start) {
+  bool mulacc_start = false;
+
+  ctrl_new      = ctrl_reg;
+  cycle_ctr_new = cycle_ctr_reg;
+  ready_new     = ready;
+
+  switch (ctrl_reg) {
+  case CTRL_IDLE:
+    if (start) {
+      ready_new     = false;
+      cycle_ctr_new = 0;
+      ctrl_new      = CTRL_PRE_WAIT;
+    }
+    break;
+
+  case CTRL_PRE_WAIT:
+    cycle_ctr_new = cycle_ctr_reg + 1;
+    if (cycle_ctr_reg == PBLOCK_PRE_CYCLES) {
+      mulacc_start = true;
+      ctrl_new     = CTRL_MULACC;
+    }
+    break;
+
+  case CTRL_MULACC:
+    if (mulacc[0].ready || mulacc[1].ready ||
+        mulacc[2].ready || mulacc[3].ready) {
+      cycle_ctr_new = 0;
+      ctrl_new      = CTRL_POST_WAIT;
+    }
+    break;
+
+  case CTRL_POST_WAIT:
+    cycle_ctr_new = cycle_ctr_reg + 1;
+    if (cycle_ctr_reg == PBLOCK_POST_CYCLES) {
+      ready_new = true;
+      ctrl_new  = CTRL_IDLE;
+    }
+    break;
+  }
+
+  for (int i = 0 ; i < 4 ; i++)
+    mulacc[i].step(mulacc_start);
+}
+
+void Poly1305Pblock::commit() {
+  for (int i = 0 ; i < 4 ; i++)
+    mulacc[i].commit();
+
+  ctrl_reg      = ctrl_new;
+  cycle_ctr_reg = cycle_ctr_new;
+  ready         = ready_new;
+}
+
+
+//------------------------------------------------------------------
+// Poly1305Final
+//------------------------------------------------------------------
+void Poly1305Final::reset() {
+  ctrl_reg      = CTRL_IDLE;
+  cycle_ctr_reg = 0;
+  ready         = true;
+}
+
+void Poly1305Final::step(bool start) {
+  ctrl_new      = ctrl_reg;
+  cycle_ctr_new = cycle_ctr_reg;
+  ready_new     = ready;
+
+  switch (ctrl_reg) {
+  case CTRL_IDLE:
+    if (start) {
+      if (latency == 0) {
+        ready_new     = false;
+        cycle_ctr_new = 0;
+        ctrl_new      = CTRL_PIPE_WAIT;
+      }
+      else if (latency == 2) {
+        ready_new = false;
+        ctrl_new  = CTRL_SELECT;
+      }
+    }
+    break;
+
+  case CTRL_PIPE_WAIT:
+    cycle_ctr_new = cycle_ctr_reg + 1;
+    if (cycle_ctr_reg == FINAL_PIPE_CYCLES) {
+      ready_new = true;
+      ctrl_new  = CTRL_IDLE;
+    }
+    break;
+
+  case CTRL_SELECT:
+    ready_new = true;
+    ctrl_new  = CTRL_IDLE;
+    break;
+  }
+}
+
+void Poly1305Final::commit() {
+  ctrl_reg      = ctrl_new;
+  cycle_ctr_reg = cycle_ctr_new;
+  ready         = ready_new;
+}
+
+
+//------------------------------------------------------------------
+// Poly1305CoreModel
+//------------------------------------------------------------------
+Poly1305CoreModel::Poly1305CoreModel(int final_latency) :
+  final_inst(final_latency), final_latency(final_latency) {
+  reset();
+}
+
+
+void Poly1305CoreModel::reset() {
+  pblock.reset();
+  final_inst.reset();
+
+  init     = false;
+  next     = false;
+  last     = false;
+  finish   = false;
+  blocklen = 0;
+  memset(key, 0, sizeof(key));
+  memset(block, 0, sizeof(block));
+
+  ready    = true;
+  memset(mac, 0, sizeof(mac));
+
+  ctrl_reg = CTRL_IDLE;
+  last_reg = false;
+  memset(h, 0, sizeof(h));
+  memset(c, 0, sizeof(c));
+  memset(r, 0, sizeof(r));
+  memset(s, 0, sizeof(s));
+
+  cycles   = 0;
+}
+
+
+//------------------------------------------------------------------
+// state_init()
+//
+// Same as crypto_poly1305_init() in the Monocypher model.
+//------------------------------------------------------------------
+void Poly1305CoreModel::state_init() {
+  for (int i = 0 ; i < 5 ; i++)
+    h[i] = 0;
+
+  r[0] = load32_le(&key[0]) & 0x0fffffff;
+  for (int i = 1 ; i < 4 ; i++)
+    r[i] = load32_le(&key[i * 4]) & 0x0ffffffc;
+
+  for (int i = 0 ; i < 4 ; i++)
+    s[i] = load32_le(&key[i * 4 + 16]);
+}
+
+
+//------------------------------------------------------------------
+// load_block()
+//
+// Load the block with padding. Only bits 0..3 of blocklen are
+// used, which means that a blocklen of 16 is a full block.
+//------------------------------------------------------------------
+void Poly1305CoreModel::load_block() {
+  uint8_t tmp[16];
+  int len = blocklen & 0xf;
+
+  memset(tmp, 0, sizeof(tmp));
+  if (len > 0) {
+    memcpy(tmp, block, len);
+    tmp[len] = 0x01;
+    c[4] = 0;
+  }
+  else {
+    memcpy(tmp, block, 16);
+    c[4] = 1;
+  }
+
+  for (int i = 0 ; i < 4 ; i++)
+    c[i] = load32_le(&tmp[i * 4]);
+}
+
+
+//------------------------------------------------------------------
+// poly_block()
+//
+// Same arithmetic as poly_block() in the Monocypher model.
+//------------------------------------------------------------------
+void Poly1305CoreModel::poly_block() {
+  uint64_t s0 = h[0] + (uint64_t)c[0];
+  uint64_t s1 = h[1] + (uint64_t)c[1];
+  uint64_t s2 = h[2] + (uint64_t)c[2];
+  uint64_t s3 = h[3] + (uint64_t)c[3];
+  uint32_t s4 = h[4] + c[4];
+
+  uint32_t r0  = r[0];
+  uint32_t r1  = r[1];
+  uint32_t r2  = r[2];
+  uint32_t r3  = r[3];
+  uint32_t rr0 = (r0 >> 2) * 5;
+  uint32_t rr1 = (r1 >> 2) + r1;
+  uint32_t rr2 = (r2 >> 2) + r2;
+  uint32_t rr3 = (r3 >> 2) + r3;
+
+  uint64_t x0 = s0*r0 + s1*rr3 + s2*rr2 + s3*rr1 + s4*rr0;
+  uint64_t x1 = s0*r1 + s1*r0  + s2*rr3 + s3*rr2 + s4*rr1;
+  uint64_t x2 = s0*r2 + s1*r1  + s2*r0  + s3*rr3 + s4*rr2;
+  uint64_t x3 = s0*r3 + s1*r2  + s2*r1  + s3*r0  + s4*rr3;
+  uint32_t x4 = s4 * (r0 & 3);
+
+  uint32_t u5 = x4 + (x3 >> 32);
+  uint64_t u0 = (u5 >>  2) * 5 + (x0 & 0xffffffff);
+  uint64_t u1 = (u0 >> 32)     + (x1 & 0xffffffff) + (x0 >> 32);
+  uint64_t u2 = (u1 >> 32)     + (x2 & 0xffffffff) + (x1 >> 32);
+  uint64_t u3 = (u2 >> 32)     + (x3 & 0xffffffff) + (x2 >> 32);
+  uint64_t u4 = (u3 >> 32)     + (u5 & 3);
+
+  h[0] = u0 & 0xffffffff;
+  h[1] = u1 & 0xffffffff;
+  h[2] = u2 & 0xffffffff;
+  h[3] = u3 & 0xffffffff;
+  h[4] = (uint32_t)u4;
+}
+
+
+//------------------------------------------------------------------
+// poly_final()
+//
+// Same arithmetic as crypto_poly1305_final() in the Monocypher
+// model. The mac has the first byte in mac[0].
+//------------------------------------------------------------------
+void Poly1305CoreModel::poly_final() {
+  uint64_t u0 = (uint64_t)5  + h[0];
+  uint64_t u1 = (u0 >> 32) + h[1];
+  uint64_t u2 = (u1 >> 32) + h[2];
+  uint64_t u3 = (u2 >> 32) + h[3];
+  uint64_t u4 = (u3 >> 32) + h[4];
+
+  uint64_t uu0 = (u4 >> 2) * 5 + h[0] + s[0];
+  uint64_t uu1 = (uu0 >> 32)   + h[1] + s[1];
+  uint64_t uu2 = (uu1 >> 32)   + h[2] + s[2];
+  uint64_t uu3 = (uu2 >> 32)   + h[3] + s[3];
+
+  store32_le(&mac[0],  (uint32_t)uu0);
+  store32_le(&mac[4],  (uint32_t)uu1);
+  store32_le(&mac[8],  (uint32_t)uu2);
+  store32_le(&mac[12], (uint32_t)uu3);
+}
+
+
+//------------------------------------------------------------------
+// tick()
+//
+// One clock cycle of the core. Mirrors poly1305_core_ctrl.
+//------------------------------------------------------------------
+void Poly1305CoreModel::tick() {
+  bool do_init      = false;
+  bool do_load      = false;
+  bool do_update    = false;
+  bool do_mac       = false;
+  bool pblock_start = false;
+  bool final_start  = false;
+  bool ready_new    = ready;
+  int  ctrl_new     = ctrl_reg;
+
+  switch (ctrl_reg) {
+  case CTRL_IDLE:
+    if (init) {
+      do_init   = true;
+      ready_new = false;
+      ctrl_new  = CTRL_READY;
+    }
+
+    if (next) {
+      do_load   = true;
+      ready_new = false;
+
+      if (blocklen > 0)
+        ctrl_new = CTRL_NEXT;
+      else if (last) {
+        final_start = true;
+        ctrl_new    = CTRL_FINAL;
+      }
+      else
+        ctrl_new = CTRL_READY;
+    }
+
+    if (finish) {
+      final_start = true;
+      ready_new   = false;
+      ctrl_new    = CTRL_FINAL;
+    }
+    break;
+
+  case CTRL_NEXT:
+    pblock_start = true;
+    ctrl_new     = CTRL_NEXT_WAIT;
+    break;
+
+  case CTRL_NEXT_WAIT:
+    if (pblock.ready) {
+      do_update = true;
+      if (last_reg && (final_latency > 0))
+        ctrl_new = CTRL_LAST_WAIT;
+      else if (last_reg)
+        ctrl_new = CTRL_LAST;
+      else
+        ctrl_new = CTRL_READY;
+    }
+    break;
+
+  case CTRL_LAST:
+    ctrl_new = CTRL_LAST_WAIT;
+    break;
+
+  case CTRL_LAST_WAIT:
+    final_start = true;
+    ctrl_new    = CTRL_FINAL;
+    break;
+
+  case CTRL_FINAL:
+    if (final_inst.ready) {
+      do_mac    = true;
+      ready_new = true;
+      ctrl_new  = CTRL_IDLE;
+    }
+    break;
+
+  case CTRL_READY:
+    ready_new = true;
+    ctrl_new  = CTRL_IDLE;
+    break;
+  }
+
+  pblock.step(pblock_start);
+  final_inst.step(final_start);
+
+  // Register updates.
+  if (do_init)
+    state_init();
+
+  if (do_load) {
+    load_block();
+    last_reg = last;
+  }
+
+  if (do_update)
+    poly_block();
+
+  if (do_mac)
+    poly_final();
+
+  pblock.commit();
+  final_inst.commit();
+
+  ctrl_reg = ctrl_new;
+  ready    = ready_new;
+  cycles++;
+}
+
+
+//------------------------------------------------------------------
+// Poly1305TopModel
+//------------------------------------------------------------------
+Poly1305TopModel::Poly1305TopModel(int final_latency) :
+  core(final_latency) {
+  reset();
+}
+
+
+void Poly1305TopModel::reset() {
+  core.reset();
+
+  memset(key_reg, 0, sizeof(key_reg));
+  memset(block_reg, 0, sizeof(block_reg));
+  blocklen_reg = 0;
+  init_reg     = false;
+  next_reg     = false;
+  last_reg     = false;
+  finish_reg   = false;
+  ready_reg    = false;
+}
+
+
+//------------------------------------------------------------------
+// tick()
+//
+// One clock cycle of the top, with a possible bus access.
+// The core inputs are driven by the current register values.
+//------------------------------------------------------------------
+void Poly1305TopModel::tick(bool cs, bool we, uint8_t address, uint32_t data) {
+  bool ctrl_we = cs && we && (address == ADDR_CTRL);
+  bool ready_new;
+
+  for (int i = 0 ; i < 8 ; i++) {
+    core.key[i * 4 + 0] = (key_reg[i] >> 24) & 0xff;
+    core.key[i * 4 + 1] = (key_reg[i] >> 16) & 0xff;
+    core.key[i * 4 + 2] = (key_reg[i] >>  8) & 0xff;
+    core.key[i * 4 + 3] = key_reg[i] & 0xff;
+  }
+
+  for (int i = 0 ; i < 4 ; i++) {
+    core.block[i * 4 + 0] = (block_reg[i] >> 24) & 0xff;
+    core.block[i * 4 + 1] = (block_reg[i] >> 16) & 0xff;
+    core.block[i * 4 + 2] = (block_reg[i] >>  8) & 0xff;
+    core.block[i * 4 + 3] = block_reg[i] & 0xff;
+  }
+
+  core.init     = init_reg;
+  core.next     = next_reg;
+  core.last     = last_reg;
+  core.finish   = finish_reg;
+  core.blocklen = blocklen_reg;
+
+  ready_new = core.ready && !init_reg && !next_reg && !finish_reg && !ctrl_we;
+
+  core.tick();
+
+  ready_reg  = ready_new;
+  init_reg   = ctrl_we && (data & CTRL_INIT_BIT);
+  next_reg   = ctrl_we && (data & CTRL_NEXT_BIT);
+  finish_reg = ctrl_we && (data & CTRL_FINISH_BIT);
+  last_reg   = ctrl_we && (data & CTRL_LAST_BIT);
+
+  if (cs && we) {
+    if (address == ADDR_BLOCKLEN)
+      blocklen_reg = data & 0x1f;
+
+    if ((address >= ADDR_KEY0) && (address < (ADDR_KEY0 + 8)))
+      key_reg[address - ADDR_KEY0] = data;
+
+    if ((address >= ADDR_BLOCK0) && (address < (ADDR_BLOCK0 + 4)))
+      block_reg[address - ADDR_BLOCK0] = data;
+  }
+}
+
+
+void Poly1305TopModel::idle() {
+  tick(false, false, 0, 0);
+}
+
+
+void Poly1305TopModel::write(uint8_t address, uint32_t data) {
+  tick(true, true, address, data);
+}
+
+
+//------------------------------------------------------------------
+// read()
+//
+// Only the status and mac registers are modelled.
+//------------------------------------------------------------------
+uint32_t Poly1305TopModel::read(uint8_t address) {
+  uint32_t data = 0;
+
+  if (address == ADDR_STATUS)
+    data = ready_reg ? 1 : 0;
+
+  if ((address >= ADDR_MAC0) && (address < (ADDR_MAC0 + 4))) {
+    const uint8_t *m = &core.mac[(address - ADDR_MAC0) * 4];
+    data = ((uint32_t)m[0] << 24) | ((uint32_t)m[1] << 16) |
+      ((uint32_t)m[2] << 8) | m[3];
+  }
+
+  tick(true, false, address, 0);
+  return data;
+}
+
+//======================================================================
+// EOF poly1305_cycle.cpp
+//======================================================================
@@ -0,0 +1,228 @@
+//======================================================================
+//
+// poly1305_cycle.h
+// ----------------
+// Cycle accurate performance model of the Poly1305 core and the
+// top level register interface. The control FSMs of poly1305_core,
+// poly1305_pblock, poly1305_mulacc and poly1305_final are modelled
+// register by register, and the tag is computed with the same
+// arithmetic as in the Monocypher model.
+//
+// The model covers the default block processing
+// (LOW_LATENCY = 0, HIGH_FMAX = 0) and all FINAL_LATENCY settings.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+#ifndef POLY1305_CYCLE_H
+#define POLY1305_CYCLE_H
+
+#include <stdint.h>
+
+
+//------------------------------------------------------------------
+// Poly1305Mulacc
+//
+// Model of poly1305_mulacc. Five multiply-accumulate operations
+// followed by a sum cycle.
+//------------------------------------------------------------------
+class Poly1305Mulacc {
+public:
+  enum {CTRL_IDLE, CTRL_OP1, CTRL_OP2, CTRL_OP3, CTRL_OP4, CTRL_SUM};
+
+  void reset();
+  void step(bool start);
+  void commit();
+
+  bool ready;
+
+private:
+  int  ctrl_reg;
+  int  ctrl_new;
+  bool ready_new;
+};
+
+
+//------------------------------------------------------------------
+// Poly1305Pblock
+//
+// Model of poly1305_pblock with its four mulacc instances.
+//------------------------------------------------------------------
+class Poly1305Pblock {
+public:
+  enum {CTRL_IDLE, CTRL_PRE_WAIT, CTRL_MULACC, CTRL_POST_WAIT};
+
+  void reset();
+  void step(bool start);
+  void commit();
+
+  bool ready;
+
+private:
+  Poly1305Mulacc mulacc[4];
+
+  int  ctrl_reg;
+  int  ctrl_new;
+  int  cycle_ctr_reg;
+  int  cycle_ctr_new;
+  bool ready_new;
+};
+
+
+//------------------------------------------------------------------
+// Poly1305Final
+//
+// Model of poly1305_final for LATENCY 0, 1 and 2.
+//------------------------------------------------------------------
+class Poly1305Final {
+public:
+  enum {CTRL_IDLE, CTRL_PIPE_WAIT, CTRL_SELECT};
+
+  explicit Poly1305Final(int latency) : latency(latency) {}
+
+  void reset();
+  void step(bool start);
+  void commit();
+
+  bool ready;
+
+private:
+  int  latency;
+  int  ctrl_reg;
+  int  ctrl_new;
+  int  cycle_ctr_reg;
+  int  cycle_ctr_new;
+  bool ready_new;
+};
+
+
+//------------------------------------------------------------------
+// Poly1305CoreModel
+//
+// Model of poly1305_core. The inputs are set by the user before
+// calling tick(), in the same way as for the RTL.
+//------------------------------------------------------------------
+class Poly1305CoreModel {
+public:
+  enum {CTRL_IDLE, CTRL_INIT, CTRL_NEXT, CTRL_NEXT_WAIT,
+        CTRL_FINAL, CTRL_LAST, CTRL_LAST_WAIT, CTRL_READY};
+
+  explicit Poly1305CoreModel(int final_latency = 0);
+
+  void reset();
+  void tick();
+
+  // Inputs. The key and block use the same byte order as
+  // the RTL, with the first byte in key[0] and block[0].
+  bool    init;
+  bool    next;
+  bool    last;
+  bool    finish;
+  uint8_t key[32];
+  uint8_t block[16];
+  uint8_t blocklen;
+
+  // Outputs.
+  bool    ready;
+  uint8_t mac[16];
+
+  uint64_t cycles;
+
+private:
+  void state_init();
+  void load_block();
+  void poly_block();
+  void poly_final();
+
+  Poly1305Pblock pblock;
+  Poly1305Final  final_inst;
+  int            final_latency;
+
+  int  ctrl_reg;
+  bool last_reg;
+
+  uint32_t h[5];
+  uint32_t c[5];
+  uint32_t r[4];
+  uint32_t s[4];
+};
+
+
+//------------------------------------------------------------------
+// Poly1305TopModel
+//
+// Model of the poly1305 top level register interface. Each bus
+// access uses one cycle, and read data is sampled in the cycle
+// of the access, in the same way as for the RTL.
+//------------------------------------------------------------------
+class Poly1305TopModel {
+public:
+  static const uint8_t ADDR_CTRL     = 0x08;
+  static const uint8_t ADDR_STATUS   = 0x09;
+  static const uint8_t ADDR_BLOCKLEN = 0x0a;
+  static const uint8_t ADDR_KEY0     = 0x10;
+  static const uint8_t ADDR_BLOCK0   = 0x20;
+  static const uint8_t ADDR_MAC0     = 0x30;
+
+  static const uint32_t CTRL_INIT_BIT   = 0x01;
+  static const uint32_t CTRL_NEXT_BIT   = 0x02;
+  static const uint32_t CTRL_FINISH_BIT = 0x04;
+  static const uint32_t CTRL_LAST_BIT   = 0x08;
+
+  explicit Poly1305TopModel(int final_latency = 0);
+
+  void reset();
+  void idle();
+  void write(uint8_t address, uint32_t data);
+  uint32_t read(uint8_t address);
+
+  uint64_t cycles() const {return core.cycles;}
+
+private:
+  void tick(bool cs, bool we, uint8_t address, uint32_t data);
+
+  Poly1305CoreModel core;
+
+  uint32_t key_reg[8];
+  uint32_t block_reg[4];
+  uint8_t  blocklen_reg;
+  bool     init_reg;
+  bool     next_reg;
+  bool     last_reg;
+  bool     finish_reg;
+  bool     ready_reg;
+};
+
+#endif // POLY1305_CYCLE_H
+
+//======================================================================
+// EOF poly1305_cycle.h
+//======================================================================
@@ -38,7 +38,13 @@
 
 `default_nettype none
 
-module poly1305(
+module poly1305 #(parameter FIFO_ADDR_BITS = 2,
+                  parameter LOW_LATENCY    = 0,
+                  parameter FINAL_LATENCY  = 0,
+                  parameter HIGH_FMAX      = 0,
+                  parameter PIPE_DEPTH     = 9,
+                  parameter SMALL_CORE     = 0)
+               (
                 input wire           clk,
                 input wire           reset_n,
 
@@ -47,7 +53,9 @@ module poly1305(
 
                 input wire  [7 : 0]  address,
                 input wire  [31 : 0] write_data,
-                output wire [31 : 0] read_data
+                output wire [31 : 0] read_data,
+
+                output wire          irq
                );
 
   //----------------------------------------------------------------
@@ -61,29 +69,87 @@ module poly1305(
   localparam CTRL_INIT_BIT    = 0;
   localparam CTRL_NEXT_BIT    = 1;
   localparam CTRL_FINISH_BIT  = 2;
-
-  localparam ADDR_STATUS      = 8'h09;
-  localparam STATUS_READY_BIT = 0;
+  localparam CTRL_LAST_BIT    = 3;
+  localparam CTRL_VERIFY_BIT  = 4;
+  localparam CTRL_RESTORE_BIT = 5;
+  localparam CTRL_FLUSH_BIT   = 6;
+
+  localparam ADDR_STATUS          = 8'h09;
+  localparam STATUS_READY_BIT     = 0;
+  localparam STATUS_FULL_BIT      = 1;
+  localparam STATUS_EMPTY_BIT     = 2;
+  localparam STATUS_VALID_BIT     = 3;
+  localparam STATUS_PASS_BIT      = 4;
+  localparam STATUS_CTX_ERROR_BIT = 5;
+  localparam STATUS_OVERFLOW_BIT  = 6;
 
   localparam ADDR_BLOCKLEN    = 8'h0a;
 
+  localparam ADDR_CONFIG      = 8'h0b;
+  localparam CONFIG_CHAIN_BIT = 0;
+
+  localparam ADDR_IRQ_ENABLE  = 8'h0c;
+  localparam ADDR_IRQ_MASK    = 8'h0d;
+  localparam ADDR_IRQ_STATUS  = 8'h0e;
+  localparam IRQ_INIT_BIT     = 0;
+  localparam IRQ_BLOCK_BIT    = 1;
+  localparam IRQ_FINAL_BIT    = 2;
+
+  localparam ADDR_CREDITS     = 8'h0f;
+
   localparam ADDR_KEY0        = 8'h10;
   localparam ADDR_KEY7        = 8'h17;
 
+  localparam ADDR_SKEY0       = 8'h18;
+  localparam ADDR_SKEY7       = 8'h1f;
+
   localparam ADDR_BLOCK0      = 8'h20;
   localparam ADDR_BLOCK1      = 8'h21;
   localparam ADDR_BLOCK2      = 8'h22;
   localparam ADDR_BLOCK3      = 8'h23;
 
+  localparam ADDR_FIFO_DATA   = 8'h24;
+  localparam ADDR_LASTLEN     = 8'h25;
+  localparam ADDR_FRAGLEN     = 8'h26;
+  localparam ADDR_FIFO_FRAG   = 8'h27;
+
   localparam ADDR_MAC0        = 8'h30;
   localparam ADDR_MAC1        = 8'h31;
   localparam ADDR_MAC2        = 8'h32;
   localparam ADDR_MAC3        = 8'h33;
 
+  localparam ADDR_TAG0        = 8'h34;
+  localparam ADDR_TAG3        = 8'h37;
+
+  localparam ADDR_PERF_CTRL    = 8'h40;
+  localparam PERF_SNAPSHOT_BIT = 0;
+  localparam PERF_CLEAR_BIT    = 1;
+
+  // Each counter is read as two words, low word first.
+  localparam ADDR_PERF_FIRST  = 8'h44;
+  localparam ADDR_PERF_LAST   = 8'h4f;
+
+  localparam PERF_CYCLES      = 0;
+  localparam PERF_PBLOCK      = 1;
+  localparam PERF_FINAL       = 2;
+  localparam PERF_BLOCKS      = 3;
+  localparam PERF_MESSAGES    = 4;
+  localparam PERF_STALL       = 5;
+  localparam NUM_PERF         = 6;
+
+  localparam ADDR_CTX0        = 8'h50;
+  localparam ADDR_CTX12       = 8'h5c;
+
   localparam CORE_NAME0       = 32'h706f6c79; // "poly"
   localparam CORE_NAME1       = 32'h31333035; // "1305"
   localparam CORE_VERSION     = 32'h312e3030; // "1.00"
 
+  localparam FIFO_DEPTH       = (1 << FIFO_ADDR_BITS);
+
+  localparam DRAIN_IDLE       = 2'h0;
+  localparam DRAIN_NEXT       = 2'h1;
+  localparam DRAIN_WAIT       = 2'h2;
+
 
   //----------------------------------------------------------------
   // Registers including update variables and write enable.
@@ -94,10 +160,15 @@ module poly1305(
   reg next_reg;
   reg next_new;
 
+  reg last_reg;
+  reg last_new;
 
   reg finish_reg;
   reg finish_new;
 
+  reg restore_reg;
+  reg restore_new;
+
   reg [4 : 0]   blocklen_reg;
   reg           blocklen_we;
 
@@ -107,7 +178,68 @@ module poly1305(
   reg [31 : 0]  key_reg [0 : 7];
   reg           key_we;
 
+  reg [31 : 0]  skey_reg [0 : 7];
+  reg           skey_we;
+
+  reg           chain_reg;
+  reg           config_we;
+
+  reg [2 : 0]   fraglen_reg;
+  reg           fraglen_we;
+
+  reg [31 : 0]  tag_reg [0 : 3];
+  reg           tag_we;
+
+  reg [31 : 0]  ctx_reg [0 : 12];
+  reg           ctx_we;
+
+  reg           ctx_error_reg;
+  reg           ctx_error_new;
+  reg           ctx_error_we;
+
+  reg           verify_reg;
+  reg           verify_new;
+  reg           verify_valid_reg;
+  reg           verify_pass_reg;
+
   reg           ready_reg;
+  reg           ready_new;
+
+  reg           overflow_reg;
+  reg           overflow_new;
+
+  reg [127 : 0] fifo_block_mem [0 : (FIFO_DEPTH - 1)];
+  reg [4 : 0]   fifo_len_mem [0 : (FIFO_DEPTH - 1)];
+  reg           fifo_last_mem [0 : (FIFO_DEPTH - 1)];
+  reg [(FIFO_ADDR_BITS - 1) : 0] fifo_wr_ptr_reg;
+  reg [(FIFO_ADDR_BITS - 1) : 0] fifo_rd_ptr_reg;
+  reg [FIFO_ADDR_BITS : 0]       fifo_ctr_reg;
+  reg [FIFO_ADDR_BITS : 0]       fifo_ctr_new;
+
+  reg [1 : 0]   drain_ctrl_reg;
+  reg [1 : 0]   drain_ctrl_new;
+  reg           drain_ctrl_we;
+
+  reg           irq_enable_reg;
+  reg           irq_enable_we;
+
+  reg [2 : 0]   irq_mask_reg;
+  reg           irq_mask_we;
+
+  reg [2 : 0]   irq_status_reg;
+  reg [2 : 0]   irq_status_new;
+
+  reg [2 : 0]   irq_pending_reg;
+  reg [2 : 0]   irq_pending_new;
+
+  reg           irq_reg;
+  reg           core_ready_reg;
+
+  reg [63 : 0]  perf_ctr_reg [0 : (NUM_PERF - 1)];
+  reg [63 : 0]  perf_snap_reg [0 : (NUM_PERF - 1)];
+  reg           perf_snapshot;
+  reg           perf_clear;
+  reg           final_busy_reg;
 
 
   //----------------------------------------------------------------
@@ -115,9 +247,49 @@ module poly1305(
   //----------------------------------------------------------------
   reg [31 : 0]   tmp_read_data;
 
+  reg            fifo_data_we;
+  reg            fifo_last_we;
+  reg            fifo_frag_we;
+  reg            fifo_flush;
+  wire           fifo_push;
+  reg            fifo_pop;
+  wire           fifo_empty;
+  wire           fifo_full;
+  wire           pack_full;
+  wire           fifo_drop;
+
+  wire           pack_valid;
+  wire           pack_ready;
+  wire           pack_busy;
+  wire [2 : 0]   pack_len;
+  wire [127 : 0] pack_block;
+  wire [4 : 0]   pack_blocklen;
+  wire           pack_last;
+  reg            status_clr;
+
+  reg            drain_next;
+  wire           drain_sel;
+
+  reg [(NUM_PERF - 1) : 0] perf_inc;
+
+  reg            irq_status_clr;
+  wire [FIFO_ADDR_BITS : 0] credits;
+
+  reg            verify_start;
+  reg            verify_done;
+
   wire           core_ready;
+  wire           core_pblock_busy;
+  wire           core_final_busy;
   wire [255 : 0] core_key;
+  wire [255 : 0] core_skey;
+  wire [127 : 0] core_tag;
+  wire [415 : 0] core_ctx_in;
+  wire           ctx_valid;
+  wire [415 : 0] core_ctx;
   wire [127 : 0] core_block;
+  wire [4 : 0]   core_blocklen;
+  wire           core_last;
   wire [127 : 0] core_mac;
 
 
@@ -125,29 +297,141 @@ module poly1305(
   // Concurrent connectivity for ports etc.
   //----------------------------------------------------------------
   assign read_data = tmp_read_data;
+  assign irq       = irq_reg;
 
   assign core_key = {key_reg[0], key_reg[1], key_reg[2], key_reg[3],
                      key_reg[4], key_reg[5], key_reg[6], key_reg[7]};
 
-  assign core_block = {block_reg[0], block_reg[1],
-                       block_reg[2], block_reg[3]};
+  assign core_skey = {skey_reg[0], skey_reg[1], skey_reg[2], skey_reg[3],
+                      skey_reg[4], skey_reg[5], skey_reg[6], skey_reg[7]};
+
+  assign core_tag = {tag_reg[0], tag_reg[1], tag_reg[2], tag_reg[3]};
+
+  assign core_ctx_in = {ctx_reg[0], ctx_reg[1], ctx_reg[2], ctx_reg[3],
+                        ctx_reg[4], ctx_reg[5], ctx_reg[6], ctx_reg[7],
+                        ctx_reg[8], ctx_reg[9], ctx_reg[10], ctx_reg[11],
+                        ctx_reg[12]};
+
+  // The pblock datapath is sized for h4 <= 4, which holds for
+  // all contexts read from the core. A context with a larger h4
+  // is not restored.
+  assign ctx_valid = (ctx_reg[4] <= 32'h4);
+
+  assign fifo_empty = (fifo_ctr_reg == 0);
+  assign fifo_full  = (fifo_ctr_reg == FIFO_DEPTH);
+
+  // The packer can't accept a word since a packed block is
+  // pending and the FIFO is full. Words written to the FIFO
+  // addresses are then dropped.
+  assign pack_valid = fifo_data_we || fifo_frag_we || fifo_last_we;
+  assign pack_full  = !pack_ready;
+  assign pack_len   = fifo_last_we ? 3'h0 :
+                      fifo_frag_we ? fraglen_reg : 3'h4;
+  assign fifo_drop  = pack_valid && pack_full;
+
+  // The number of blocks that can be written to the FIFO without
+  // the FIFO becoming full, including a pending packed block.
+  assign credits    = (fifo_full && pack_busy) ? {(FIFO_ADDR_BITS + 1){1'h0}} :
+                      FIFO_DEPTH - fifo_ctr_reg - pack_busy;
+
+  // While the drain logic is issuing a next operation the core
+  // is fed with the block at the head of the FIFO.
+  assign drain_sel     = (drain_ctrl_reg == DRAIN_NEXT);
+
+  assign core_block    = drain_sel ? fifo_block_mem[fifo_rd_ptr_reg] :
+                         {block_reg[0], block_reg[1], block_reg[2], block_reg[3]};
+
+  assign core_blocklen = drain_sel ? fifo_len_mem[fifo_rd_ptr_reg] : blocklen_reg;
+
+  assign core_last     = drain_sel ? fifo_last_mem[fifo_rd_ptr_reg] : last_reg;
+
+
+  //----------------------------------------------------------------
+  // packer instantiation.
+  //
+  // Packs the words written to ADDR_FIFO_DATA and the fragments
+  // written to ADDR_FIFO_FRAG into blocks that are pushed into
+  // the block FIFO. The last full block is held
+  // until the next word or the final block length written to
+  // ADDR_LASTLEN has been received.
+  //----------------------------------------------------------------
+  poly1305_packer packer(
+                         .clk(clk),
+                         .reset_n(reset_n),
+                         .data(write_data),
+                         .len(pack_len),
+                         .last(fifo_last_we),
+                         .valid(pack_valid),
+                         .ready(pack_ready),
+                         .lastlen_we(fifo_last_we),
+                         .lastlen(write_data[4 : 0]),
+                         .flush(fifo_flush),
+                         .busy(pack_busy),
+                         .core_next(fifo_push),
+                         .core_last(pack_last),
+                         .core_block(pack_block),
+                         .core_blocklen(pack_blocklen),
+                         .core_ready(!fifo_full)
+                        );
 
 
   //----------------------------------------------------------------
   // core instantiation.
   //----------------------------------------------------------------
-  poly1305_core core(
-                     .clk(clk),
-                     .reset_n(reset_n),
-                     .init(init_reg),
-                     .next(next_reg),
-                     .finish(finish_reg),
-                     .ready(core_ready),
-                     .key(core_key),
-                     .block(core_block),
-                     .blocklen(blocklen_reg),
-                     .mac(core_mac)
-                    );
+  // The area optimized core is selected with SMALL_CORE. It has
+  // the same interface as poly1305_core, and the LOW_LATENCY,
+  // FINAL_LATENCY, HIGH_FMAX and PIPE_DEPTH parameters are then
+  // not used.
+  generate
+    if (SMALL_CORE)
+      begin : core_small_gen
+        poly1305_core_small core(
+                                 .clk(clk),
+                                 .reset_n(reset_n),
+                                 .init(init_reg),
+                                 .next(next_reg),
+                                 .last(core_last),
+                                 .finish(finish_reg),
+                                 .restore(restore_reg),
+                                 .ready(core_ready),
+                                 .pblock_busy(core_pblock_busy),
+                                 .final_busy(core_final_busy),
+                                 .key(core_key),
+                                 .chain(chain_reg),
+                                 .chain_key(core_skey),
+                                 .block(core_block),
+                                 .blocklen(core_blocklen),
+                                 .ctx_in(core_ctx_in),
+                                 .ctx(core_ctx),
+                                 .mac(core_mac)
+                                );
+      end
+    else
+      begin : core_gen
+        poly1305_core #(.LOW_LATENCY(LOW_LATENCY), .FINAL_LATENCY(FINAL_LATENCY),
+                        .HIGH_FMAX(HIGH_FMAX), .PIPE_DEPTH(PIPE_DEPTH))
+                      core(
+                           .clk(clk),
+                           .reset_n(reset_n),
+                           .init(init_reg),
+                           .next(next_reg),
+                           .last(core_last),
+                           .finish(finish_reg),
+                           .restore(restore_reg),
+                           .ready(core_ready),
+                           .pblock_busy(core_pblock_busy),
+                           .final_busy(core_final_busy),
+                           .key(core_key),
+                           .chain(chain_reg),
+                           .chain_key(core_skey),
+                           .block(core_block),
+                           .blocklen(core_blocklen),
+                           .ctx_in(core_ctx_in),
+                           .ctx(core_ctx),
+                           .mac(core_mac)
+                          );
+      end
+  endgenerate
 
 
   //----------------------------------------------------------------
@@ -166,19 +450,90 @@ module poly1305(
             block_reg[i] <= 32'h0;
 
           for (i = 0 ; i < 8 ; i = i + 1)
-            key_reg[i] <= 32'h0;
+            begin
+              key_reg[i]  <= 32'h0;
+              skey_reg[i] <= 32'h0;
+            end
+
+          for (i = 0 ; i < 13 ; i = i + 1)
+            ctx_reg[i] <= 32'h0;
 
-          blocklen_reg <= 5'h0;
-          init_reg     <= 1'b0;
-          next_reg     <= 1'b0;
-          ready_reg    <= 1'b0;
+          for (i = 0 ; i < 4 ; i = i + 1)
+            tag_reg[i] <= 32'h0;
+
+          for (i = 0 ; i < FIFO_DEPTH ; i = i + 1)
+            begin
+              fifo_block_mem[i] <= 128'h0;
+              fifo_len_mem[i]   <= 5'h0;
+              fifo_last_mem[i]  <= 1'h0;
+            end
+
+          for (i = 0 ; i < NUM_PERF ; i = i + 1)
+            begin
+              perf_ctr_reg[i]  <= 64'h0;
+              perf_snap_reg[i] <= 64'h0;
+            end
+
+          blocklen_reg     <= 5'h0;
+          init_reg         <= 1'b0;
+          next_reg         <= 1'b0;
+          last_reg         <= 1'b0;
+          finish_reg       <= 1'b0;
+          restore_reg      <= 1'b0;
+          chain_reg        <= 1'b0;
+          fraglen_reg      <= 3'h4;
+          verify_reg       <= 1'b0;
+          verify_valid_reg <= 1'b0;
+          verify_pass_reg  <= 1'b0;
+          ctx_error_reg    <= 1'b0;
+          ready_reg        <= 1'b0;
+          overflow_reg     <= 1'h0;
+          fifo_wr_ptr_reg  <= {FIFO_ADDR_BITS{1'h0}};
+          fifo_rd_ptr_reg  <= {FIFO_ADDR_BITS{1'h0}};
+          fifo_ctr_reg     <= {(FIFO_ADDR_BITS + 1){1'h0}};
+          drain_ctrl_reg   <= DRAIN_IDLE;
+          final_busy_reg   <= 1'h0;
+          irq_enable_reg   <= 1'h0;
+          irq_mask_reg     <= 3'h0;
+          irq_status_reg   <= 3'h0;
+          irq_pending_reg  <= 3'h0;
+          irq_reg          <= 1'h0;
+          core_ready_reg   <= 1'h0;
         end
       else
         begin
-          ready_reg  <= core_ready;
-          init_reg   <= init_new;
-          next_reg   <= next_new;
-          finish_reg <= finish_new;
+          final_busy_reg  <= core_final_busy;
+          core_ready_reg  <= core_ready;
+          irq_status_reg  <= irq_status_new;
+          irq_pending_reg <= irq_pending_new;
+          irq_reg         <= irq_enable_reg && |(irq_status_reg & irq_mask_reg);
+
+          if (irq_enable_we)
+            irq_enable_reg <= write_data[0];
+
+          if (irq_mask_we)
+            irq_mask_reg <= write_data[2 : 0];
+
+          for (i = 0 ; i < NUM_PERF ; i = i + 1)
+            begin
+              if (perf_snapshot)
+                perf_snap_reg[i] <= perf_ctr_reg[i];
+
+              if (perf_clear)
+                perf_ctr_reg[i] <= 64'h0;
+              else if (perf_inc[i])
+                perf_ctr_reg[i] <= perf_ctr_reg[i] + 1'h1;
+            end
+
+          verify_reg   <= verify_new;
+          ready_reg    <= ready_new;
+          init_reg     <= init_new;
+          next_reg     <= next_new | drain_next;
+          last_reg     <= last_new;
+          finish_reg   <= finish_new;
+          restore_reg  <= restore_new;
+          fifo_ctr_reg <= fifo_ctr_new;
+          overflow_reg <= overflow_new;
 
           if (blocklen_we)
             blocklen_reg <= write_data[4 : 0];
@@ -186,12 +541,226 @@ module poly1305(
           if (key_we)
             key_reg[address[2 : 0]] <= write_data;
 
+          if (skey_we)
+            skey_reg[address[2 : 0]] <= write_data;
+
+          if (config_we)
+            chain_reg <= write_data[CONFIG_CHAIN_BIT];
+
+          if (fraglen_we)
+            fraglen_reg <= (write_data[2 : 0] > 3'h4) ? 3'h4 : write_data[2 : 0];
+
+          if (tag_we)
+            tag_reg[address[1 : 0]] <= write_data;
+
+          if (ctx_we)
+            ctx_reg[address[3 : 0]] <= write_data;
+
+          if (ctx_error_we)
+            ctx_error_reg <= ctx_error_new;
+
+          if (verify_start)
+            begin
+              verify_valid_reg <= 1'h0;
+              verify_pass_reg  <= 1'h0;
+            end
+
+          if (verify_done)
+            begin
+              verify_valid_reg <= 1'h1;
+              verify_pass_reg  <= ~|(core_mac ^ core_tag);
+            end
+
           if (block_we)
             block_reg[address[1 : 0]] <= write_data;
+
+          if (fifo_push)
+            begin
+              fifo_block_mem[fifo_wr_ptr_reg] <= pack_block;
+              fifo_len_mem[fifo_wr_ptr_reg]   <= pack_blocklen;
+              fifo_last_mem[fifo_wr_ptr_reg]  <= pack_last;
+              fifo_wr_ptr_reg                 <= fifo_wr_ptr_reg + 1'h1;
+            end
+
+          if (fifo_pop)
+            fifo_rd_ptr_reg <= fifo_rd_ptr_reg + 1'h1;
+
+          if (drain_ctrl_we)
+            drain_ctrl_reg <= drain_ctrl_new;
         end
     end // reg_update
 
 
+  //----------------------------------------------------------------
+  // fifo_ctrl
+  //
+  // Updates the number of blocks in the block FIFO when blocks
+  // are pushed by the packer and popped by the drain logic.
+  // Words written to ADDR_FIFO_DATA are packed into blocks by
+  // the packer. A word written to ADDR_FIFO_FRAG is a fragment
+  // with the number of bytes given by ADDR_FRAGLEN (0..4),
+  // starting with the most significant byte. A write to ADDR_LASTLEN gives the length of the
+  // final block (0..15 bytes), which is pushed with last set.
+  // The final block is marked as last, which makes the core
+  // perform the final processing directly after the block.
+  // While the packer can't accept words, new words are dropped.
+  // This is signalled by STATUS_FULL_BIT. A dropped write sets
+  // the sticky STATUS_OVERFLOW_BIT, which is cleared by writing
+  // one to it in ADDR_STATUS.
+  //----------------------------------------------------------------
+  always @*
+    begin : fifo_ctrl
+      fifo_ctr_new = fifo_ctr_reg;
+      overflow_new = overflow_reg;
+
+      if (status_clr && write_data[STATUS_OVERFLOW_BIT])
+        overflow_new = 1'h0;
+
+      if (fifo_drop)
+        overflow_new = 1'h1;
+
+      if (fifo_push && !fifo_pop)
+        fifo_ctr_new = fifo_ctr_reg + 1'h1;
+
+      if (!fifo_push && fifo_pop)
+        fifo_ctr_new = fifo_ctr_reg - 1'h1;
+    end // fifo_ctrl
+
+
+  //----------------------------------------------------------------
+  // drain_ctrl
+  //
+  // Automatically issues next operations to the core for blocks
+  // in the FIFO as soon as the core is ready.
+  //----------------------------------------------------------------
+  always @*
+    begin : drain_ctrl
+      drain_next     = 1'h0;
+      fifo_pop       = 1'h0;
+      drain_ctrl_new = DRAIN_IDLE;
+      drain_ctrl_we  = 1'h0;
+
+      case (drain_ctrl_reg)
+        DRAIN_IDLE:
+          begin
+            if (!fifo_empty && core_ready)
+              begin
+                drain_next     = 1'h1;
+                drain_ctrl_new = DRAIN_NEXT;
+                drain_ctrl_we  = 1'h1;
+              end
+          end
+
+        DRAIN_NEXT:
+          begin
+            fifo_pop       = 1'h1;
+            drain_ctrl_new = DRAIN_WAIT;
+            drain_ctrl_we  = 1'h1;
+          end
+
+        DRAIN_WAIT:
+          begin
+            if (core_ready)
+              begin
+                if (!fifo_empty)
+                  begin
+                    drain_next     = 1'h1;
+                    drain_ctrl_new = DRAIN_NEXT;
+                    drain_ctrl_we  = 1'h1;
+                  end
+                else
+                  begin
+                    drain_ctrl_new = DRAIN_IDLE;
+                    drain_ctrl_we  = 1'h1;
+                  end
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (drain_ctrl_reg)
+    end // drain_ctrl
+
+
+  //----------------------------------------------------------------
+  // perf_events
+  //
+  // The events counted by the performance counters. Blocks are
+  // counted when a next operation with a non zero length is
+  // issued, and messages when the final processing has been
+  // completed. Stall cycles are cycles where the host is
+  // blocked, i.e. status reads that return ready not set, and
+  // writes to the FIFO that are dropped since a packed block is
+  // pending and the FIFO is full. Cycles where the host can
+  // continue writing words while queued blocks are processed
+  // are not counted.
+  //----------------------------------------------------------------
+  always @*
+    begin : perf_events
+      perf_inc                = {NUM_PERF{1'h0}};
+      perf_inc[PERF_CYCLES]   = 1'h1;
+      perf_inc[PERF_PBLOCK]   = core_pblock_busy;
+      perf_inc[PERF_FINAL]    = core_final_busy;
+      perf_inc[PERF_BLOCKS]   = next_reg && (core_blocklen != 5'h0);
+      perf_inc[PERF_MESSAGES] = final_busy_reg && !core_final_busy;
+      perf_inc[PERF_STALL]    = (cs && !we && (address == ADDR_STATUS) && !ready_reg) ||
+                                fifo_drop;
+    end // perf_events
+
+
+  //----------------------------------------------------------------
+  // irq_events
+  //
+  // Each command passed to the core is recorded as a pending
+  // event. A block processed with last set is recorded as a
+  // final event. When the core sets ready the pending events
+  // are moved to the status register. Status bits are cleared
+  // by writing one to them in ADDR_IRQ_STATUS.
+  //----------------------------------------------------------------
+  always @*
+    begin : irq_events
+      irq_status_new  = irq_status_reg;
+      irq_pending_new = irq_pending_reg;
+
+      if (irq_status_clr)
+        irq_status_new = irq_status_reg & ~write_data[2 : 0];
+
+      if (core_ready && !core_ready_reg)
+        begin
+          irq_status_new  = irq_status_new | irq_pending_reg;
+          irq_pending_new = 3'h0;
+        end
+
+      if (init_reg || restore_reg)
+        irq_pending_new[IRQ_INIT_BIT] = 1'h1;
+
+      if (next_reg && !core_last)
+        irq_pending_new[IRQ_BLOCK_BIT] = 1'h1;
+
+      if ((next_reg && core_last) || finish_reg)
+        irq_pending_new[IRQ_FINAL_BIT] = 1'h1;
+    end // irq_events
+
+
+  //----------------------------------------------------------------
+  // verify_ctrl
+  //
+  // A verify command is pending until all commands and queued
+  // blocks have been processed, i.e. until ready is set. The mac
+  // is then compared to the expected tag. The compare is a xor
+  // of all bits followed by an or reduction, evaluated in a
+  // single cycle. The time to get the result is therefore
+  // independent of the mac and tag values, and of the position
+  // of any differing bits.
+  //----------------------------------------------------------------
+  always @*
+    begin : verify_ctrl
+      verify_done = verify_reg && ready_reg;
+      verify_new  = (verify_reg && !verify_done) || verify_start;
+    end // verify_ctrl
+
+
   //----------------------------------------------------------------
   // api
   //
@@ -199,13 +768,42 @@ module poly1305(
   //----------------------------------------------------------------
   always @*
     begin : api
-      init_new      = 1'b0;
-      next_new      = 1'b0;
-      finish_new    = 1'b0;
-      blocklen_we   = 1'b0;
-      key_we        = 1'b0;
-      block_we      = 1'b0;
-      tmp_read_data = 32'h0;
+      init_new       = 1'b0;
+      next_new       = 1'b0;
+      last_new       = 1'b0;
+      finish_new     = 1'b0;
+      restore_new    = 1'b0;
+      blocklen_we    = 1'b0;
+      key_we         = 1'b0;
+      skey_we        = 1'b0;
+      config_we      = 1'b0;
+      fraglen_we     = 1'b0;
+      tag_we         = 1'b0;
+      ctx_we         = 1'b0;
+      ctx_error_new  = 1'b0;
+      ctx_error_we   = 1'b0;
+      verify_start   = 1'b0;
+      block_we       = 1'b0;
+      fifo_data_we   = 1'b0;
+      fifo_last_we   = 1'b0;
+      fifo_frag_we   = 1'b0;
+      fifo_flush     = 1'b0;
+      perf_snapshot  = 1'b0;
+      perf_clear     = 1'b0;
+      irq_enable_we  = 1'b0;
+      irq_mask_we    = 1'b0;
+      irq_status_clr = 1'b0;
+      status_clr     = 1'b0;
+      tmp_read_data  = 32'h0;
+
+      // Ready is only signalled when all queued blocks
+      // have been processed by the core. Ready is also cleared
+      // directly when a command is written and while it is
+      // passed to the core. This ensures that a status read
+      // in the cycle after a command will not see a stale ready.
+      ready_new = core_ready && fifo_empty && !pack_busy &&
+                  (drain_ctrl_reg == DRAIN_IDLE) &&
+                  !init_reg && !next_reg && !finish_reg && !restore_reg;
 
       if (cs)
         begin
@@ -213,19 +811,75 @@ module poly1305(
             begin
               if (address == ADDR_CTRL)
                 begin
-                  init_new   = write_data[CTRL_INIT_BIT];
-                  next_new   = write_data[CTRL_NEXT_BIT];
-                  finish_new = write_data[CTRL_FINISH_BIT];
+                  init_new     = write_data[CTRL_INIT_BIT];
+                  next_new     = write_data[CTRL_NEXT_BIT];
+                  last_new     = write_data[CTRL_LAST_BIT];
+                  finish_new   = write_data[CTRL_FINISH_BIT];
+                  verify_start = write_data[CTRL_VERIFY_BIT];
+                  restore_new  = write_data[CTRL_RESTORE_BIT] && ctx_valid;
+                  fifo_flush   = write_data[CTRL_FLUSH_BIT];
+                  ready_new    = 1'h0;
+
+                  if (write_data[CTRL_RESTORE_BIT])
+                    begin
+                      ctx_error_new = !ctx_valid;
+                      ctx_error_we  = 1'h1;
+                    end
                 end
 
+              if (address == ADDR_STATUS)
+                status_clr = 1'h1;
+
               if (address == ADDR_BLOCKLEN)
                 blocklen_we = 1'h1;
 
+              if (address == ADDR_CONFIG)
+                config_we = 1'h1;
+
+              if (address == ADDR_IRQ_ENABLE)
+                irq_enable_we = 1'h1;
+
+              if (address == ADDR_IRQ_MASK)
+                irq_mask_we = 1'h1;
+
+              if (address == ADDR_IRQ_STATUS)
+                irq_status_clr = 1'h1;
+
               if ((address >= ADDR_KEY0) && (address <= ADDR_KEY7))
                 key_we = 1'b1;
 
+              if ((address >= ADDR_SKEY0) && (address <= ADDR_SKEY7))
+                skey_we = 1'b1;
+
               if ((address >= ADDR_BLOCK0) && (address <= ADDR_BLOCK3))
                 block_we = 1'b1;
+
+              if ((address >= ADDR_TAG0) && (address <= ADDR_TAG3))
+                tag_we = 1'b1;
+
+              if ((address >= ADDR_CTX0) && (address <= ADDR_CTX12))
+                ctx_we = 1'b1;
+
+              if (address == ADDR_FIFO_DATA)
+                fifo_data_we = 1'b1;
+
+              if (address == ADDR_FRAGLEN)
+                fraglen_we = 1'b1;
+
+              if (address == ADDR_FIFO_FRAG)
+                fifo_frag_we = 1'b1;
+
+              if (address == ADDR_LASTLEN)
+                begin
+                  fifo_last_we = 1'b1;
+                  ready_new    = 1'h0;
+                end
+
+              if (address == ADDR_PERF_CTRL)
+                begin
+                  perf_snapshot = write_data[PERF_SNAPSHOT_BIT];
+                  perf_clear    = write_data[PERF_CLEAR_BIT];
+                end
             end // if (we)
 
           else
@@ -240,10 +894,36 @@ module poly1305(
                 tmp_read_data = CORE_VERSION;
 
               if (address == ADDR_STATUS)
-                tmp_read_data = {31'h0, ready_reg};
+                tmp_read_data = {25'h0, overflow_reg, ctx_error_reg,
+                                 verify_pass_reg, verify_valid_reg,
+                                 fifo_empty, pack_full, ready_reg};
+
+              if (address == ADDR_CONFIG)
+                tmp_read_data = {31'h0, chain_reg};
+
+              if (address == ADDR_FRAGLEN)
+                tmp_read_data = {29'h0, fraglen_reg};
+
+              if (address == ADDR_IRQ_ENABLE)
+                tmp_read_data = {31'h0, irq_enable_reg};
+
+              if (address == ADDR_IRQ_MASK)
+                tmp_read_data = {29'h0, irq_mask_reg};
+
+              if (address == ADDR_IRQ_STATUS)
+                tmp_read_data = {29'h0, irq_status_reg};
+
+              if (address == ADDR_CREDITS)
+                tmp_read_data = credits;
 
               if ((address >= ADDR_MAC0) && (address <= ADDR_MAC3))
                 tmp_read_data = core_mac[(3 - (address - ADDR_MAC0)) * 32 +: 32];
+
+              if ((address >= ADDR_CTX0) && (address <= ADDR_CTX12))
+                tmp_read_data = core_ctx[(12 - (address - ADDR_CTX0)) * 32 +: 32];
+
+              if ((address >= ADDR_PERF_FIRST) && (address <= ADDR_PERF_LAST))
+                tmp_read_data = perf_snap_reg[(address - ADDR_PERF_FIRST) >> 1][address[0] * 32 +: 32];
             end
         end
     end // addr_decoder
@@ -0,0 +1,377 @@
+//======================================================================
+//
+// poly1305_aead.v
+// ---------------
+// AEAD framing front end for the Poly1305 core. Pads the AAD and
+// ciphertext and appends the length block as specified in RFC 8439.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_aead(
+                     input wire            clk,
+                     input wire            reset_n,
+
+                     input wire            init,
+                     output wire           ready,
+
+                     input wire [255 : 0]  key,
+                     input wire [63 : 0]   aad_len,
+                     input wire [63 : 0]   ct_len,
+
+                     input wire [127 : 0]  s_aad_tdata,
+                     input wire            s_aad_tvalid,
+                     output wire           s_aad_tready,
+
+                     input wire [127 : 0]  s_ct_tdata,
+                     input wire            s_ct_tvalid,
+                     output wire           s_ct_tready,
+
+                     output wire [127 : 0] m_axis_tdata,
+                     output wire           m_axis_tvalid,
+                     input wire            m_axis_tready
+                    );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam CTRL_IDLE        = 3'h0;
+  localparam CTRL_INIT        = 3'h1;
+  localparam CTRL_AAD         = 3'h2;
+  localparam CTRL_CT          = 3'h3;
+  localparam CTRL_LEN         = 3'h4;
+  localparam CTRL_FINISH_WAIT = 3'h5;
+
+
+  //----------------------------------------------------------------
+  // Internal functions.
+  //----------------------------------------------------------------
+  // The first byte in a stream beat is in the least significant
+  // byte lane. The core expects the first byte in the most
+  // significant byte of the block and mac.
+  function [127 : 0] bswap(input [127 : 0] w);
+    integer i;
+    begin
+      for (i = 0 ; i < 16 ; i = i + 1)
+        bswap[(15 - i) * 8 +: 8] = w[i * 8 +: 8];
+    end
+  endfunction // bswap
+
+  // Clear the byte lanes beyond the remaining number of bytes.
+  // This gives the zero padding of the final block of a stream.
+  function [127 : 0] pad(input [127 : 0] w, input [63 : 0] rem);
+    integer i;
+    begin
+      for (i = 0 ; i < 16 ; i = i + 1)
+        pad[i * 8 +: 8] = (rem > i) ? w[i * 8 +: 8] : 8'h0;
+    end
+  endfunction // pad
+
+  // The remaining number of bytes after a beat.
+  function [63 : 0] dec_rem(input [63 : 0] rem);
+    begin
+      if (rem > 64'h10)
+        dec_rem = rem - 64'h10;
+      else
+        dec_rem = 64'h0;
+    end
+  endfunction // dec_rem
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [63 : 0]  aad_len_reg;
+  reg [63 : 0]  ct_len_reg;
+  reg           len_we;
+
+  reg [63 : 0]  aad_rem_reg;
+  reg [63 : 0]  aad_rem_new;
+  reg           aad_rem_we;
+
+  reg [63 : 0]  ct_rem_reg;
+  reg [63 : 0]  ct_rem_new;
+  reg           ct_rem_we;
+
+  reg [127 : 0] tag_reg;
+  reg           tag_we;
+
+  reg           tag_valid_reg;
+  reg           tag_valid_new;
+  reg           tag_valid_we;
+
+  reg [2 : 0]   aead_ctrl_reg;
+  reg [2 : 0]   aead_ctrl_new;
+  reg           aead_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg            core_init;
+  reg            core_next;
+  reg            core_last;
+  reg [127 : 0]  core_block;
+  wire           core_ready;
+  wire [127 : 0] core_mac;
+
+  reg            tmp_s_aad_tready;
+  reg            tmp_s_ct_tready;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign ready         = (aead_ctrl_reg == CTRL_IDLE) && core_ready;
+
+  assign s_aad_tready  = tmp_s_aad_tready;
+  assign s_ct_tready   = tmp_s_ct_tready;
+
+  assign m_axis_tdata  = tag_reg;
+  assign m_axis_tvalid = tag_valid_reg;
+
+
+  //----------------------------------------------------------------
+  // core instantiation.
+  //----------------------------------------------------------------
+  poly1305_core core(
+                     .clk(clk),
+                     .reset_n(reset_n),
+                     .init(core_init),
+                     .next(core_next),
+                     .last(core_last),
+                     .finish(1'h0),
+                     .restore(1'h0),
+                     .ready(core_ready),
+                     .pblock_busy(),
+                     .final_busy(),
+                     .key(key),
+                     .chain(1'h0),
+                     .chain_key(256'h0),
+                     .block(bswap(core_block)),
+                     .blocklen(5'h10),
+                     .ctx_in(416'h0),
+                     .ctx(),
+                     .mac(core_mac)
+                    );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with synchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          aad_len_reg   <= 64'h0;
+          ct_len_reg    <= 64'h0;
+          aad_rem_reg   <= 64'h0;
+          ct_rem_reg    <= 64'h0;
+          tag_reg       <= 128'h0;
+          tag_valid_reg <= 1'h0;
+          aead_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (len_we)
+            begin
+              aad_len_reg <= aad_len;
+              ct_len_reg  <= ct_len;
+            end
+
+          if (aad_rem_we)
+            aad_rem_reg <= aad_rem_new;
+
+          if (ct_rem_we)
+            ct_rem_reg <= ct_rem_new;
+
+          if (tag_we)
+            tag_reg <= bswap(core_mac);
+
+          if (tag_valid_we)
+            tag_valid_reg <= tag_valid_new;
+
+          if (aead_ctrl_we)
+            aead_ctrl_reg <= aead_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // aead_ctrl
+  //
+  // Frames the AAD and the ciphertext as specified in RFC 8439,
+  // section 2.8. The lengths are sampled together with init,
+  // which also starts the core init using the key. The AAD and
+  // ciphertext streams are then processed in turn, with the
+  // final beat of each stream padded with zeros to a full
+  // block. A stream with zero length is skipped. Finally the
+  // length block with the AAD and ciphertext lengths as 64-bit
+  // little endian values is processed with last set, and the
+  // tag is presented on the tag stream.
+  //----------------------------------------------------------------
+  always @*
+    begin : aead_ctrl
+      core_init        = 1'h0;
+      core_next        = 1'h0;
+      core_last        = 1'h0;
+      core_block       = 128'h0;
+      len_we           = 1'h0;
+      aad_rem_new      = 64'h0;
+      aad_rem_we       = 1'h0;
+      ct_rem_new       = 64'h0;
+      ct_rem_we        = 1'h0;
+      tmp_s_aad_tready = 1'h0;
+      tmp_s_ct_tready  = 1'h0;
+      tag_we           = 1'h0;
+      tag_valid_new    = 1'h0;
+      tag_valid_we     = 1'h0;
+      aead_ctrl_new    = CTRL_IDLE;
+      aead_ctrl_we     = 1'h0;
+
+      if (m_axis_tready && tag_valid_reg)
+        begin
+          tag_valid_new = 1'h0;
+          tag_valid_we  = 1'h1;
+        end
+
+      case (aead_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (init && core_ready)
+              begin
+                core_init     = 1'h1;
+                len_we        = 1'h1;
+                aad_rem_new   = aad_len;
+                aad_rem_we    = 1'h1;
+                ct_rem_new    = ct_len;
+                ct_rem_we     = 1'h1;
+                aead_ctrl_new = CTRL_INIT;
+                aead_ctrl_we  = 1'h1;
+              end
+          end
+
+        CTRL_INIT:
+          begin
+            if (core_ready)
+              begin
+                aead_ctrl_new = CTRL_AAD;
+                aead_ctrl_we  = 1'h1;
+              end
+          end
+
+        CTRL_AAD:
+          begin
+            core_block = pad(s_aad_tdata, aad_rem_reg);
+
+            if (aad_rem_reg == 64'h0)
+              begin
+                aead_ctrl_new = CTRL_CT;
+                aead_ctrl_we  = 1'h1;
+              end
+            else
+              begin
+                tmp_s_aad_tready = core_ready;
+
+                if (s_aad_tvalid && core_ready)
+                  begin
+                    core_next   = 1'h1;
+                    aad_rem_new = dec_rem(aad_rem_reg);
+                    aad_rem_we  = 1'h1;
+                  end
+              end
+          end
+
+        CTRL_CT:
+          begin
+            core_block = pad(s_ct_tdata, ct_rem_reg);
+
+            if (ct_rem_reg == 64'h0)
+              begin
+                aead_ctrl_new = CTRL_LEN;
+                aead_ctrl_we  = 1'h1;
+              end
+            else
+              begin
+                tmp_s_ct_tready = core_ready;
+
+                if (s_ct_tvalid && core_ready)
+                  begin
+                    core_next  = 1'h1;
+                    ct_rem_new = dec_rem(ct_rem_reg);
+                    ct_rem_we  = 1'h1;
+                  end
+              end
+          end
+
+        CTRL_LEN:
+          begin
+            core_block = {ct_len_reg, aad_len_reg};
+
+            if (core_ready)
+              begin
+                core_next     = 1'h1;
+                core_last     = 1'h1;
+                aead_ctrl_new = CTRL_FINISH_WAIT;
+                aead_ctrl_we  = 1'h1;
+              end
+          end
+
+        CTRL_FINISH_WAIT:
+          begin
+            if (core_ready && (!tag_valid_reg || m_axis_tready))
+              begin
+                tag_we        = 1'h1;
+                tag_valid_new = 1'h1;
+                tag_valid_we  = 1'h1;
+                aead_ctrl_new = CTRL_IDLE;
+                aead_ctrl_we  = 1'h1;
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (aead_ctrl_reg)
+    end // aead_ctrl
+
+endmodule // poly1305_aead
+
+//======================================================================
+// EOF poly1305_aead.v
+//======================================================================
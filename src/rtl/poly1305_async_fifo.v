@@ -0,0 +1,197 @@
+//======================================================================
+//
+// poly1305_async_fifo.v
+// ---------------------
+// Asynchronous FIFO with gray coded pointers used for clock
+// domain crossing.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_async_fifo #(parameter WIDTH     = 32,
+                             parameter ADDR_BITS = 2)
+                           (
+                            input wire                   wr_clk,
+                            input wire                   wr_reset_n,
+                            input wire                   wr_en,
+                            input wire [(WIDTH - 1) : 0] wr_data,
+                            output wire                  wr_full,
+
+                            input wire                   rd_clk,
+                            input wire                   rd_reset_n,
+                            input wire                   rd_en,
+                            output wire [(WIDTH - 1) : 0] rd_data,
+                            output wire                  rd_empty
+                           );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam DEPTH = (1 << ADDR_BITS);
+
+  // The FIFO is full when the write pointer has wrapped once
+  // more than the synchronized read pointer. In gray code this
+  // means that the two most significant bits differ and the
+  // remaining bits are equal.
+  localparam [ADDR_BITS : 0] FULL_MASK = (3 << (ADDR_BITS - 1));
+
+
+  //----------------------------------------------------------------
+  // Internal functions.
+  //----------------------------------------------------------------
+  function [ADDR_BITS : 0] bin2gray(input [ADDR_BITS : 0] b);
+    begin
+      bin2gray = b ^ (b >> 1);
+    end
+  endfunction // bin2gray
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [(WIDTH - 1) : 0] fifo_mem [0 : (DEPTH - 1)];
+
+  reg [ADDR_BITS : 0]   wr_ptr_reg;
+  reg [ADDR_BITS : 0]   wr_ptr_new;
+  reg [ADDR_BITS : 0]   wr_gray_reg;
+  reg [ADDR_BITS : 0]   wr_rd_gray0_reg;
+  reg [ADDR_BITS : 0]   wr_rd_gray1_reg;
+
+  reg [ADDR_BITS : 0]   rd_ptr_reg;
+  reg [ADDR_BITS : 0]   rd_ptr_new;
+  reg [ADDR_BITS : 0]   rd_gray_reg;
+  reg [ADDR_BITS : 0]   rd_wr_gray0_reg;
+  reg [ADDR_BITS : 0]   rd_wr_gray1_reg;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  wire wr_push;
+  wire rd_pop;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign wr_full  = (wr_gray_reg == (wr_rd_gray1_reg ^ FULL_MASK));
+
+  assign rd_empty = (rd_gray_reg == rd_wr_gray1_reg);
+
+  assign rd_data  = fifo_mem[rd_ptr_reg[(ADDR_BITS - 1) : 0]];
+
+  assign wr_push  = wr_en && !wr_full;
+  assign rd_pop   = rd_en && !rd_empty;
+
+
+  //----------------------------------------------------------------
+  // wr_reg_update
+  //
+  // Registers in the write clock domain. The gray coded read
+  // pointer is synchronized with two flops. Since only one bit
+  // changes for each update of a gray coded pointer, the
+  // synchronized pointer is either the current or the previous
+  // value, which at worst makes the FIFO appear full one or two
+  // cycles longer than needed.
+  //----------------------------------------------------------------
+  always @ (posedge wr_clk)
+    begin : wr_reg_update
+      if (!wr_reset_n)
+        begin
+          wr_ptr_reg      <= {(ADDR_BITS + 1){1'h0}};
+          wr_gray_reg     <= {(ADDR_BITS + 1){1'h0}};
+          wr_rd_gray0_reg <= {(ADDR_BITS + 1){1'h0}};
+          wr_rd_gray1_reg <= {(ADDR_BITS + 1){1'h0}};
+        end
+      else
+        begin
+          wr_rd_gray0_reg <= rd_gray_reg;
+          wr_rd_gray1_reg <= wr_rd_gray0_reg;
+
+          if (wr_push)
+            begin
+              fifo_mem[wr_ptr_reg[(ADDR_BITS - 1) : 0]] <= wr_data;
+              wr_ptr_reg  <= wr_ptr_new;
+              wr_gray_reg <= bin2gray(wr_ptr_new);
+            end
+        end
+    end // wr_reg_update
+
+
+  //----------------------------------------------------------------
+  // rd_reg_update
+  //
+  // Registers in the read clock domain. The gray coded write
+  // pointer is synchronized in the same way as the read pointer.
+  // An entry is only visible in the read domain after the write
+  // pointer has been synchronized, when the data in the memory
+  // is stable.
+  //----------------------------------------------------------------
+  always @ (posedge rd_clk)
+    begin : rd_reg_update
+      if (!rd_reset_n)
+        begin
+          rd_ptr_reg      <= {(ADDR_BITS + 1){1'h0}};
+          rd_gray_reg     <= {(ADDR_BITS + 1){1'h0}};
+          rd_wr_gray0_reg <= {(ADDR_BITS + 1){1'h0}};
+          rd_wr_gray1_reg <= {(ADDR_BITS + 1){1'h0}};
+        end
+      else
+        begin
+          rd_wr_gray0_reg <= wr_gray_reg;
+          rd_wr_gray1_reg <= rd_wr_gray0_reg;
+
+          if (rd_pop)
+            begin
+              rd_ptr_reg  <= rd_ptr_new;
+              rd_gray_reg <= bin2gray(rd_ptr_new);
+            end
+        end
+    end // rd_reg_update
+
+
+  //----------------------------------------------------------------
+  // ptr_logic
+  //----------------------------------------------------------------
+  always @*
+    begin : ptr_logic
+      wr_ptr_new = wr_ptr_reg + 1'h1;
+      rd_ptr_new = rd_ptr_reg + 1'h1;
+    end // ptr_logic
+
+endmodule // poly1305_async_fifo
+
+//======================================================================
+// EOF poly1305_async_fifo.v
+//======================================================================
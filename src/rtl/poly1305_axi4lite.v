@@ -0,0 +1,231 @@
+//======================================================================
+//
+// poly1305_axi4lite.v
+// -------------------
+// AXI4-Lite slave interface for the Poly1305 top level wrapper.
+// Supports back-to-back reads and writes and multiple
+// outstanding write responses.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_axi4lite #(parameter FIFO_ADDR_BITS = 2,
+                           parameter LOW_LATENCY    = 0,
+                           parameter FINAL_LATENCY  = 0,
+                           parameter HIGH_FMAX      = 0,
+                           parameter PIPE_DEPTH     = 9,
+                           parameter SMALL_CORE     = 0)
+                        (
+                         input wire           clk,
+                         input wire           reset_n,
+
+                         input wire [9 : 0]   s_axi_awaddr,
+                         input wire           s_axi_awvalid,
+                         output wire          s_axi_awready,
+
+                         input wire [31 : 0]  s_axi_wdata,
+                         input wire [3 : 0]   s_axi_wstrb,
+                         input wire           s_axi_wvalid,
+                         output wire          s_axi_wready,
+
+                         output wire [1 : 0]  s_axi_bresp,
+                         output wire          s_axi_bvalid,
+                         input wire           s_axi_bready,
+
+                         input wire [9 : 0]   s_axi_araddr,
+                         input wire           s_axi_arvalid,
+                         output wire          s_axi_arready,
+
+                         output wire [31 : 0] s_axi_rdata,
+                         output wire [1 : 0]  s_axi_rresp,
+                         output wire          s_axi_rvalid,
+                         input wire           s_axi_rready,
+
+                         output wire          irq
+                        );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  // Max number of outstanding write responses.
+  localparam MAX_BRESP = 4'hf;
+
+  localparam AXI_OKAY  = 2'h0;
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [3 : 0]  bresp_ctr_reg;
+  reg [3 : 0]  bresp_ctr_new;
+
+  reg [31 : 0] rdata_reg;
+  reg          rdata_we;
+
+  reg          rvalid_reg;
+  reg          rvalid_new;
+  reg          rvalid_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg            write_access;
+  reg            read_access;
+
+  reg            core_cs;
+  reg            core_we;
+  reg [7 : 0]    core_address;
+  wire [31 : 0]  core_read_data;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign s_axi_awready = write_access;
+  assign s_axi_wready  = write_access;
+  assign s_axi_bresp   = AXI_OKAY;
+  assign s_axi_bvalid  = (bresp_ctr_reg > 0);
+
+  assign s_axi_arready = read_access;
+  assign s_axi_rdata   = rdata_reg;
+  assign s_axi_rresp   = AXI_OKAY;
+  assign s_axi_rvalid  = rvalid_reg;
+
+
+  //----------------------------------------------------------------
+  // poly1305 instantiation.
+  //----------------------------------------------------------------
+  poly1305 #(.FIFO_ADDR_BITS(FIFO_ADDR_BITS), .LOW_LATENCY(LOW_LATENCY),
+             .FINAL_LATENCY(FINAL_LATENCY), .HIGH_FMAX(HIGH_FMAX),
+             .PIPE_DEPTH(PIPE_DEPTH), .SMALL_CORE(SMALL_CORE))
+           poly1305_inst(
+                         .clk(clk),
+                         .reset_n(reset_n),
+                         .cs(core_cs),
+                         .we(core_we),
+                         .address(core_address),
+                         .write_data(s_axi_wdata),
+                         .read_data(core_read_data),
+                         .irq(irq)
+                        );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with synchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          bresp_ctr_reg <= 4'h0;
+          rdata_reg     <= 32'h0;
+          rvalid_reg    <= 1'h0;
+        end
+      else
+        begin
+          bresp_ctr_reg <= bresp_ctr_new;
+
+          if (rdata_we)
+            rdata_reg <= core_read_data;
+
+          if (rvalid_we)
+            rvalid_reg <= rvalid_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // axi_ctrl
+  //
+  // A write is performed in the cycle where both the address
+  // and data are valid. The response is queued by counting the
+  // outstanding responses, allowing one write every cycle.
+  // A read is performed when there is no write in the same
+  // cycle and the read data register is free or being
+  // consumed, allowing one read every cycle.
+  // All registers are 32 bits wide and the write strobes are
+  // ignored, i.e. only full word writes are supported.
+  //----------------------------------------------------------------
+  always @*
+    begin : axi_ctrl
+      write_access  = 1'h0;
+      read_access   = 1'h0;
+      core_cs       = 1'h0;
+      core_we       = 1'h0;
+      core_address  = s_axi_araddr[9 : 2];
+      rdata_we      = 1'h0;
+      rvalid_new    = 1'h0;
+      rvalid_we     = 1'h0;
+      bresp_ctr_new = bresp_ctr_reg;
+
+      if (s_axi_awvalid && s_axi_wvalid && (bresp_ctr_reg < MAX_BRESP))
+        begin
+          write_access = 1'h1;
+          core_cs      = 1'h1;
+          core_we      = 1'h1;
+          core_address = s_axi_awaddr[9 : 2];
+        end
+
+      else if (s_axi_arvalid && (!rvalid_reg || s_axi_rready))
+        begin
+          read_access  = 1'h1;
+          core_cs      = 1'h1;
+          rdata_we     = 1'h1;
+          rvalid_new   = 1'h1;
+          rvalid_we    = 1'h1;
+        end
+
+      if (rvalid_reg && s_axi_rready && !read_access)
+        begin
+          rvalid_new = 1'h0;
+          rvalid_we  = 1'h1;
+        end
+
+      if (write_access && !(s_axi_bvalid && s_axi_bready))
+        bresp_ctr_new = bresp_ctr_reg + 1'h1;
+
+      if (!write_access && (s_axi_bvalid && s_axi_bready))
+        bresp_ctr_new = bresp_ctr_reg - 1'h1;
+    end // axi_ctrl
+
+endmodule // poly1305_axi4lite
+
+//======================================================================
+// EOF poly1305_axi4lite.v
+//======================================================================
@@ -0,0 +1,273 @@
+//======================================================================
+//
+// poly1305_axis.v
+// ---------------
+// AXI4-Stream wrapper for the Poly1305 core. The message is
+// received as a stream of 128-bit beats and the tag is delivered
+// on a separate stream.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_axis(
+                     input wire            clk,
+                     input wire            reset_n,
+
+                     input wire [255 : 0]  key,
+
+                     input wire [127 : 0]  s_axis_tdata,
+                     input wire [15 : 0]   s_axis_tkeep,
+                     input wire            s_axis_tlast,
+                     input wire            s_axis_tvalid,
+                     output wire           s_axis_tready,
+
+                     output wire [127 : 0] m_axis_tdata,
+                     output wire           m_axis_tvalid,
+                     input wire            m_axis_tready
+                    );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam CTRL_IDLE        = 3'h0;
+  localparam CTRL_INIT        = 3'h1;
+  localparam CTRL_DATA        = 3'h2;
+  localparam CTRL_FINISH_WAIT = 3'h3;
+
+
+  //----------------------------------------------------------------
+  // Internal functions.
+  //----------------------------------------------------------------
+  // The first byte in a stream beat is in the least significant
+  // byte lane. The core expects the first byte in the most
+  // significant byte of the block and mac.
+  function [127 : 0] bswap(input [127 : 0] w);
+    integer i;
+    begin
+      for (i = 0 ; i < 16 ; i = i + 1)
+        bswap[(15 - i) * 8 +: 8] = w[i * 8 +: 8];
+    end
+  endfunction // bswap
+
+  // The number of valid bytes in a beat. Note that
+  // keep is expected to be contiguous from byte lane zero.
+  function [4 : 0] keep_len(input [15 : 0] keep);
+    integer i;
+    begin
+      keep_len = 5'h0;
+      for (i = 0 ; i < 16 ; i = i + 1)
+        keep_len = keep_len + keep[i];
+    end
+  endfunction // keep_len
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [127 : 0] tag_reg;
+  reg           tag_we;
+
+  reg           tag_valid_reg;
+  reg           tag_valid_new;
+  reg           tag_valid_we;
+
+  reg [2 : 0]   axis_ctrl_reg;
+  reg [2 : 0]   axis_ctrl_new;
+  reg           axis_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg            core_init;
+  reg            core_next;
+  wire           core_ready;
+  wire [4 : 0]   core_blocklen;
+  wire [127 : 0] core_mac;
+
+  reg            tmp_s_axis_tready;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign s_axis_tready = tmp_s_axis_tready;
+
+  assign m_axis_tdata  = tag_reg;
+  assign m_axis_tvalid = tag_valid_reg;
+
+  assign core_blocklen = s_axis_tlast ? keep_len(s_axis_tkeep) : 5'h10;
+
+
+  //----------------------------------------------------------------
+  // core instantiation.
+  //----------------------------------------------------------------
+  poly1305_core core(
+                     .clk(clk),
+                     .reset_n(reset_n),
+                     .init(core_init),
+                     .next(core_next),
+                     .last(s_axis_tlast),
+                     .finish(1'h0),
+                     .restore(1'h0),
+                     .ready(core_ready),
+                     .pblock_busy(),
+                     .final_busy(),
+                     .key(key),
+                     .chain(1'h0),
+                     .chain_key(256'h0),
+                     .block(bswap(s_axis_tdata)),
+                     .blocklen(core_blocklen),
+                     .ctx_in(416'h0),
+                     .ctx(),
+                     .mac(core_mac)
+                    );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with synchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          tag_reg       <= 128'h0;
+          tag_valid_reg <= 1'h0;
+          axis_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (tag_we)
+            tag_reg <= bswap(core_mac);
+
+          if (tag_valid_we)
+            tag_valid_reg <= tag_valid_new;
+
+          if (axis_ctrl_we)
+            axis_ctrl_reg <= axis_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // axis_ctrl
+  //
+  // The first beat of a message triggers init using the key.
+  // Each beat is then accepted as soon as the core is ready
+  // and is processed with next. The last beat is processed
+  // with last set, which makes the core perform the final
+  // processing directly. The tag is then presented on the tag
+  // stream. The tag is held in a separate register, which allows
+  // the next message to start before the tag has been accepted.
+  //----------------------------------------------------------------
+  always @*
+    begin : axis_ctrl
+      core_init         = 1'h0;
+      core_next         = 1'h0;
+      tmp_s_axis_tready = 1'h0;
+      tag_we            = 1'h0;
+      tag_valid_new     = 1'h0;
+      tag_valid_we      = 1'h0;
+      axis_ctrl_new     = CTRL_IDLE;
+      axis_ctrl_we      = 1'h0;
+
+      if (m_axis_tready && tag_valid_reg)
+        begin
+          tag_valid_new = 1'h0;
+          tag_valid_we  = 1'h1;
+        end
+
+      case (axis_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (s_axis_tvalid && core_ready)
+              begin
+                core_init     = 1'h1;
+                axis_ctrl_new = CTRL_INIT;
+                axis_ctrl_we  = 1'h1;
+              end
+          end
+
+        CTRL_INIT:
+          begin
+            if (core_ready)
+              begin
+                axis_ctrl_new = CTRL_DATA;
+                axis_ctrl_we  = 1'h1;
+              end
+          end
+
+        CTRL_DATA:
+          begin
+            tmp_s_axis_tready = core_ready;
+
+            if (s_axis_tvalid && core_ready)
+              begin
+                core_next = 1'h1;
+
+                if (s_axis_tlast)
+                  begin
+                    axis_ctrl_new = CTRL_FINISH_WAIT;
+                    axis_ctrl_we  = 1'h1;
+                  end
+              end
+          end
+
+        CTRL_FINISH_WAIT:
+          begin
+            if (core_ready && (!tag_valid_reg || m_axis_tready))
+              begin
+                tag_we        = 1'h1;
+                tag_valid_new = 1'h1;
+                tag_valid_we  = 1'h1;
+                axis_ctrl_new = CTRL_IDLE;
+                axis_ctrl_we  = 1'h1;
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (axis_ctrl_reg)
+    end // axis_ctrl
+
+endmodule // poly1305_axis
+
+//======================================================================
+// EOF poly1305_axis.v
+//======================================================================
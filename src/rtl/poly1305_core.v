@@ -36,21 +36,35 @@
 
 `default_nettype none
 
-module poly1305_core(
+module poly1305_core #(parameter LOW_LATENCY   = 0,
+                       parameter FINAL_LATENCY = 0,
+                       parameter HIGH_FMAX     = 0,
+                       parameter PIPE_DEPTH    = 9)
+                    (
                      input wire            clk,
                      input wire            reset_n,
 
                      input wire            init,
                      input wire            next,
+                     input wire            last,
                      input wire            finish,
+                     input wire            restore,
 
                      output wire           ready,
+                     output wire           pblock_busy,
+                     output wire           final_busy,
 
                      input wire [255 : 0]  key,
 
+                     input wire            chain,
+                     input wire [255 : 0]  chain_key,
+
                      input wire [127 : 0]  block,
                      input wire [4 : 0]    blocklen,
 
+                     input wire [415 : 0]  ctx_in,
+                     output wire [415 : 0] ctx,
+
                      output wire [127 : 0] mac
                     );
 
@@ -63,6 +77,8 @@ module poly1305_core(
   localparam CTRL_NEXT      = 3'h2;
   localparam CTRL_NEXT_WAIT = 3'h3;
   localparam CTRL_FINAL     = 3'h4;
+  localparam CTRL_LAST      = 3'h5;
+  localparam CTRL_LAST_WAIT = 3'h6;
   localparam CTRL_READY     = 3'h7;
 
 
@@ -89,6 +105,9 @@ module poly1305_core(
   reg [31 : 0]  r_new [0 : 3];
   reg           r_we;
 
+  reg [31 : 0]  rr_reg [0 : 3];
+  reg [31 : 0]  rr_new [0 : 3];
+
   reg [31 : 0]  s_reg [0 : 3];
   reg [31 : 0]  s_new [0 : 3];
   reg           s_we;
@@ -97,6 +116,9 @@ module poly1305_core(
   reg [31 : 0]  mac_new [0 : 3];
   reg           mac_we;
 
+  reg           last_reg;
+  reg           last_we;
+
   reg           ready_reg;
   reg           ready_new;
   reg           ready_we;
@@ -116,6 +138,8 @@ module poly1305_core(
   wire final_ready;
 
   reg state_init;
+  reg chain_init;
+  reg ctx_restore;
   reg state_update;
   reg load_block;
   reg mac_update;
@@ -127,6 +151,8 @@ module poly1305_core(
 
   wire [31 : 0] pblock_h_new [0 : 4];
 
+  wire [255 : 0] init_key;
+
 
   //----------------------------------------------------------------
   // Concurrent connectivity for ports etc.
@@ -138,42 +164,141 @@ module poly1305_core(
 
   assign ready = ready_reg;
 
+  // The context of the message being processed. The rr values
+  // are derived from r and c is loaded for each block, so
+  // these are not part of the context.
+  assign ctx = {h_reg[0], h_reg[1], h_reg[2], h_reg[3], h_reg[4],
+                r_reg[0], r_reg[1], r_reg[2], r_reg[3],
+                s_reg[0], s_reg[1], s_reg[2], s_reg[3]};
+
+  // Status used by the performance counters.
+  assign pblock_busy = (poly1305_core_ctrl_reg == CTRL_NEXT) ||
+                       (poly1305_core_ctrl_reg == CTRL_NEXT_WAIT);
+
+  assign final_busy  = (poly1305_core_ctrl_reg == CTRL_LAST) ||
+                       (poly1305_core_ctrl_reg == CTRL_LAST_WAIT) ||
+                       (poly1305_core_ctrl_reg == CTRL_FINAL);
+
+  // A chained init uses the key for the next message.
+  assign init_key = chain_init ? chain_key : key;
+
 
   //----------------------------------------------------------------
   // Module instantiations.
   //----------------------------------------------------------------
-  poly1305_pblock pblock_inst(
-                              .clk(clk),
-                              .reset_n(reset_n),
-
-                              .start(pblock_start),
-                              .ready(pblock_ready),
-
-                              .h0(h_reg[0]),
-                              .h1(h_reg[1]),
-                              .h2(h_reg[2]),
-                              .h3(h_reg[3]),
-                              .h4(h_reg[4]),
-
-                              .c0(c_reg[0]),
-                              .c1(c_reg[1]),
-                              .c2(c_reg[2]),
-                              .c3(c_reg[3]),
-                              .c4(c_reg[4]),
-
-                              .r0(r_reg[0]),
-                              .r1(r_reg[1]),
-                              .r2(r_reg[2]),
-                              .r3(r_reg[3]),
-
-                              .h0_new(pblock_h_new[0]),
-                              .h1_new(pblock_h_new[1]),
-                              .h2_new(pblock_h_new[2]),
-                              .h3_new(pblock_h_new[3]),
-                              .h4_new(pblock_h_new[4])
-                             );
-
-  poly1305_final final_inst(
+  // The low latency pblock gets the precomputed 5 * r operands
+  // and the block directly when next is asserted. The high Fmax
+  // pblock is pipelined with PIPE_DEPTH pipeline registers.
+  generate
+    if (LOW_LATENCY)
+      begin : pblock_ll_gen
+        poly1305_pblock_ll pblock_inst(
+                                       .clk(clk),
+                                       .reset_n(reset_n),
+
+                                       .start(pblock_start),
+                                       .ready(pblock_ready),
+
+                                       .h0(h_reg[0]),
+                                       .h1(h_reg[1]),
+                                       .h2(h_reg[2]),
+                                       .h3(h_reg[3]),
+                                       .h4(h_reg[4]),
+
+                                       .c0(c_new[0]),
+                                       .c1(c_new[1]),
+                                       .c2(c_new[2]),
+                                       .c3(c_new[3]),
+                                       .c4(c_new[4]),
+
+                                       .r0(r_reg[0]),
+                                       .r1(r_reg[1]),
+                                       .r2(r_reg[2]),
+                                       .r3(r_reg[3]),
+
+                                       .rr0(rr_reg[0]),
+                                       .rr1(rr_reg[1]),
+                                       .rr2(rr_reg[2]),
+                                       .rr3(rr_reg[3]),
+
+                                       .h0_new(pblock_h_new[0]),
+                                       .h1_new(pblock_h_new[1]),
+                                       .h2_new(pblock_h_new[2]),
+                                       .h3_new(pblock_h_new[3]),
+                                       .h4_new(pblock_h_new[4])
+                                      );
+      end
+    else if (HIGH_FMAX)
+      begin : pblock_pipe_gen
+        poly1305_pblock_pipe #(.PIPE_DEPTH(PIPE_DEPTH))
+                             pblock_inst(
+                                         .clk(clk),
+                                         .reset_n(reset_n),
+
+                                         .start(pblock_start),
+                                         .ready(pblock_ready),
+
+                                         .h0(h_reg[0]),
+                                         .h1(h_reg[1]),
+                                         .h2(h_reg[2]),
+                                         .h3(h_reg[3]),
+                                         .h4(h_reg[4]),
+
+                                         .c0(c_reg[0]),
+                                         .c1(c_reg[1]),
+                                         .c2(c_reg[2]),
+                                         .c3(c_reg[3]),
+                                         .c4(c_reg[4]),
+
+                                         .r0(r_reg[0]),
+                                         .r1(r_reg[1]),
+                                         .r2(r_reg[2]),
+                                         .r3(r_reg[3]),
+
+                                         .h0_new(pblock_h_new[0]),
+                                         .h1_new(pblock_h_new[1]),
+                                         .h2_new(pblock_h_new[2]),
+                                         .h3_new(pblock_h_new[3]),
+                                         .h4_new(pblock_h_new[4])
+                                        );
+      end
+    else
+      begin : pblock_gen
+        poly1305_pblock pblock_inst(
+                                    .clk(clk),
+                                    .reset_n(reset_n),
+
+                                    .start(pblock_start),
+                                    .ready(pblock_ready),
+
+                                    .h0(h_reg[0]),
+                                    .h1(h_reg[1]),
+                                    .h2(h_reg[2]),
+                                    .h3(h_reg[3]),
+                                    .h4(h_reg[4]),
+
+                                    .c0(c_reg[0]),
+                                    .c1(c_reg[1]),
+                                    .c2(c_reg[2]),
+                                    .c3(c_reg[3]),
+                                    .c4(c_reg[4]),
+
+                                    .r0(r_reg[0]),
+                                    .r1(r_reg[1]),
+                                    .r2(r_reg[2]),
+                                    .r3(r_reg[3]),
+
+                                    .h0_new(pblock_h_new[0]),
+                                    .h1_new(pblock_h_new[1]),
+                                    .h2_new(pblock_h_new[2]),
+                                    .h3_new(pblock_h_new[3]),
+                                    .h4_new(pblock_h_new[4])
+                                   );
+      end
+  endgenerate
+
+  poly1305_final #(.LATENCY(FINAL_LATENCY))
+                 final_inst(
                             .clk(clk),
                             .reset_n(reset_n),
 
@@ -219,15 +344,20 @@ module poly1305_core(
           for (i = 0 ; i < 4 ; i = i + 1)
             begin
               r_reg[i]   <= 32'h0;
+              rr_reg[i]  <= 32'h0;
               s_reg[i]   <= 32'h0;
               mac_reg[i] <= 32'h0;
             end
 
+          last_reg               <= 1'h0;
           ready_reg              <= 1'h1;
           poly1305_core_ctrl_reg <= CTRL_IDLE;
         end
       else
         begin
+          if (last_we)
+            last_reg <= last;
+
           if (ready_we)
             ready_reg <= ready_new;
 
@@ -246,7 +376,10 @@ module poly1305_core(
           if (r_we)
             begin
               for (i = 0 ; i < 4 ; i = i + 1)
-                r_reg[i] <= r_new[i];
+                begin
+                  r_reg[i]  <= r_new[i];
+                  rr_reg[i] <= rr_new[i];
+                end
             end
 
           if (s_we)
@@ -287,7 +420,10 @@ module poly1305_core(
       c_we = 1'h0;
 
       for (i = 0 ; i < 4 ; i = i + 1)
-        r_new[i] = 32'h0;
+        begin
+          r_new[i]  = 32'h0;
+          rr_new[i] = 32'h0;
+        end
       r_we = 1'h0;
 
       for (i = 0 ; i < 4 ; i = i + 1)
@@ -309,19 +445,54 @@ module poly1305_core(
           h_we     = 1'h1;
 
           // Clamping of the key when assigning r.
-          r_new[0] = le(key[255 : 224]) & 32'h0fffffff;
-          r_new[1] = le(key[223 : 192]) & 32'h0ffffffc;
-          r_new[2] = le(key[191 : 160]) & 32'h0ffffffc;
-          r_new[3] = le(key[159 : 128]) & 32'h0ffffffc;
+          r_new[0] = le(init_key[255 : 224]) & 32'h0fffffff;
+          r_new[1] = le(init_key[223 : 192]) & 32'h0ffffffc;
+          r_new[2] = le(init_key[191 : 160]) & 32'h0ffffffc;
+          r_new[3] = le(init_key[159 : 128]) & 32'h0ffffffc;
+          r_we     = 1'h1;
+
+          s_new[0] = le(init_key[127 : 096]);
+          s_new[1] = le(init_key[095 : 064]);
+          s_new[2] = le(init_key[063 : 032]);
+          s_new[3] = le(init_key[031 : 000]);
+          s_we     = 1'h1;
+        end
+
+      // Restore of a saved context. The r values are clamped
+      // in the same way as when assigned from the key. The
+      // context must have been read from ctx, the pblock
+      // datapath is sized for h4 <= 4.
+      if (ctx_restore)
+        begin
+          c_we     = 1'h1;
+
+          h_new[0] = ctx_in[415 : 384];
+          h_new[1] = ctx_in[383 : 352];
+          h_new[2] = ctx_in[351 : 320];
+          h_new[3] = ctx_in[319 : 288];
+          h_new[4] = ctx_in[287 : 256];
+          h_we     = 1'h1;
+
+          r_new[0] = ctx_in[255 : 224] & 32'h0fffffff;
+          r_new[1] = ctx_in[223 : 192] & 32'h0ffffffc;
+          r_new[2] = ctx_in[191 : 160] & 32'h0ffffffc;
+          r_new[3] = ctx_in[159 : 128] & 32'h0ffffffc;
           r_we     = 1'h1;
 
-          s_new[0] = le(key[127 : 096]);
-          s_new[1] = le(key[095 : 064]);
-          s_new[2] = le(key[063 : 032]);
-          s_new[3] = le(key[031 : 000]);
+          s_new[0] = ctx_in[127 : 096];
+          s_new[1] = ctx_in[095 : 064];
+          s_new[2] = ctx_in[063 : 032];
+          s_new[3] = ctx_in[031 : 000];
           s_we     = 1'h1;
         end
 
+      // Precalculated 5 * r operands used by the low
+      // latency pblock.
+      rr_new[0] = {2'h0, r_new[0][31 : 2]} * 32'h5;
+      rr_new[1] = {2'h0, r_new[1][31 : 2]} + r_new[1];
+      rr_new[2] = {2'h0, r_new[2][31 : 2]} + r_new[2];
+      rr_new[3] = {2'h0, r_new[3][31 : 2]} + r_new[3];
+
       // Note that we only check bits 0..3 in blocklen.
       // This means that a blocklen of 0 and 16 are
       // handled the same way.
@@ -460,11 +631,14 @@ module poly1305_core(
   always @*
     begin : poly1305_core_ctrl
       state_init             = 1'h0;
+      chain_init             = 1'h0;
+      ctx_restore            = 1'h0;
       load_block             = 1'h0;
       state_update           = 1'h0;
       pblock_start           = 1'h0;
       final_start            = 1'h0;
       mac_update             = 1'h0;
+      last_we                = 1'h0;
       ready_new              = 1'h0;
       ready_we               = 1'h0;
       poly1305_core_ctrl_new = CTRL_IDLE;
@@ -483,15 +657,39 @@ module poly1305_core(
                 poly1305_core_ctrl_we  = 1'h1;
               end
 
+            if (restore)
+              begin
+                ctx_restore            = 1'h1;
+                ready_new              = 1'h0;
+                ready_we               = 1'h1;
+                poly1305_core_ctrl_new = CTRL_READY;
+                poly1305_core_ctrl_we  = 1'h1;
+              end
+
+            // A next with last set performs the final processing
+            // directly after the block has been processed.
             if (next)
               begin
                 load_block             = 1'h1;
+                last_we                = 1'h1;
                 ready_new              = 1'h0;
                 ready_we               = 1'h1;
 
                 if (blocklen > 0)
                   begin
-                    poly1305_core_ctrl_new = CTRL_NEXT;
+                    poly1305_core_ctrl_we  = 1'h1;
+                    if (LOW_LATENCY)
+                      begin
+                        pblock_start           = 1'h1;
+                        poly1305_core_ctrl_new = CTRL_NEXT_WAIT;
+                      end
+                    else
+                      poly1305_core_ctrl_new = CTRL_NEXT;
+                  end
+                else if (last)
+                  begin
+                    final_start            = 1'h1;
+                    poly1305_core_ctrl_new = CTRL_FINAL;
                     poly1305_core_ctrl_we  = 1'h1;
                   end
                 else
@@ -525,21 +723,60 @@ module poly1305_core(
             if (pblock_ready)
               begin
                 state_update           = 1'h1;
-                poly1305_core_ctrl_new = CTRL_READY;
                 poly1305_core_ctrl_we  = 1'h1;
+                if (last_reg && (FINAL_LATENCY > 0))
+                  poly1305_core_ctrl_new = CTRL_LAST_WAIT;
+                else if (last_reg)
+                  poly1305_core_ctrl_new = CTRL_LAST;
+                else if (LOW_LATENCY)
+                  begin
+                    ready_new              = 1'h1;
+                    ready_we               = 1'h1;
+                    poly1305_core_ctrl_new = CTRL_IDLE;
+                  end
+                else
+                  poly1305_core_ctrl_new = CTRL_READY;
               end
           end
 
 
+        // The final pipeline (FINAL_LATENCY zero) requires h to
+        // be stable for one cycle before being started.
+        CTRL_LAST:
+          begin
+            poly1305_core_ctrl_new = CTRL_LAST_WAIT;
+            poly1305_core_ctrl_we  = 1'h1;
+          end
+
+
+        CTRL_LAST_WAIT:
+          begin
+            final_start            = 1'h1;
+            poly1305_core_ctrl_new = CTRL_FINAL;
+            poly1305_core_ctrl_we  = 1'h1;
+          end
+
+
+        // In chain mode the core is initialized with the chain
+        // key in the same cycle as the mac is updated.
         CTRL_FINAL:
           begin
             if (final_ready)
               begin
                 mac_update             = 1'h1;
-                ready_new              = 1'h1;
-                ready_we               = 1'h1;
-                poly1305_core_ctrl_new = CTRL_IDLE;
                 poly1305_core_ctrl_we  = 1'h1;
+                if (chain)
+                  begin
+                    state_init             = 1'h1;
+                    chain_init             = 1'h1;
+                    poly1305_core_ctrl_new = CTRL_READY;
+                  end
+                else
+                  begin
+                    ready_new              = 1'h1;
+                    ready_we               = 1'h1;
+                    poly1305_core_ctrl_new = CTRL_IDLE;
+                  end
               end
           end
 
@@ -0,0 +1,911 @@
+//======================================================================
+//
+// poly1305_core_small.v
+// ---------------------
+// Area optimized version of the Poly1305 core with the same
+// interface as poly1305_core. The block and final processing
+// use a single 32x32 bit multiplier and one accumulator,
+// controlled by a microcoded schedule.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_core_small(
+                           input wire            clk,
+                           input wire            reset_n,
+
+                           input wire            init,
+                           input wire            next,
+                           input wire            last,
+                           input wire            finish,
+                           input wire            restore,
+
+                           output wire           ready,
+                           output wire           pblock_busy,
+                           output wire           final_busy,
+
+                           input wire [255 : 0]  key,
+
+                           input wire            chain,
+                           input wire [255 : 0]  chain_key,
+
+                           input wire [127 : 0]  block,
+                           input wire [4 : 0]    blocklen,
+
+                           input wire [415 : 0]  ctx_in,
+                           output wire [415 : 0] ctx,
+
+                           output wire [127 : 0] mac
+                          );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam CTRL_IDLE   = 3'h0;
+  localparam CTRL_MAC    = 3'h1;
+  localparam CTRL_REDUCE = 3'h2;
+  localparam CTRL_FINAL  = 3'h3;
+  localparam CTRL_READY  = 3'h4;
+
+  localparam BASE_ZERO  = 2'h0;
+  localparam BASE_ACC   = 2'h1;
+  localparam BASE_CARRY = 2'h2;
+
+  localparam REDUCE_STEPS = 4'h7;
+  localparam FINAL_STEPS  = 4'ha;
+
+
+  //----------------------------------------------------------------
+  // Internal functions.
+  //----------------------------------------------------------------
+  function [31 : 0] le(input [31 : 0] w);
+    le = {w[7 : 0], w[15 : 8], w[23 : 16], w[31 : 24]};
+  endfunction // le
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg  [31 : 0] h_reg [0 : 4];
+  reg  [31 : 0] h_new [0 : 4];
+  reg           h_we;
+
+  reg [31 : 0]  c_reg [0 : 4];
+  reg [31 : 0]  c_new [0 : 4];
+  reg           c_we;
+
+  reg [31 : 0]  r_reg [0 : 3];
+  reg [31 : 0]  r_new [0 : 3];
+  reg           r_we;
+
+  reg [31 : 0]  rr_reg [0 : 3];
+  reg [31 : 0]  rr_new [0 : 3];
+
+  reg [31 : 0]  s_reg [0 : 3];
+  reg [31 : 0]  s_new [0 : 3];
+  reg           s_we;
+
+  reg [31 : 0]  mac_reg [0 : 3];
+  reg [31 : 0]  mac_new [0 : 3];
+  reg           mac_we;
+
+  reg [63 : 0]  acc_reg;
+  reg [63 : 0]  acc_new;
+  reg           acc_we;
+
+  reg [63 : 0]  x_reg [0 : 3];
+  reg           x_we;
+
+  reg [1 : 0]   u5_reg;
+  reg           u5_we;
+
+  reg [1 : 0]   word_ctr_reg;
+  reg [1 : 0]   word_ctr_new;
+  reg           word_ctr_we;
+  reg           word_ctr_rst;
+  reg           word_ctr_inc;
+
+  reg [3 : 0]   step_ctr_reg;
+  reg [3 : 0]   step_ctr_new;
+  reg           step_ctr_we;
+  reg           step_ctr_rst;
+  reg           step_ctr_inc;
+
+  reg           last_reg;
+  reg           last_we;
+
+  reg           ready_reg;
+  reg           ready_new;
+  reg           ready_we;
+
+  reg [2 : 0]   poly1305_core_ctrl_reg;
+  reg [2 : 0]   poly1305_core_ctrl_new;
+  reg           poly1305_core_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg           state_init;
+  reg           chain_init;
+  reg           ctx_restore;
+  reg           load_block;
+
+  reg [1 : 0]   base_sel;
+  reg [31 : 0]  mul_a;
+  reg [31 : 0]  mul_b;
+  reg [63 : 0]  add_op;
+
+  reg           h_word_we;
+  reg           mac_word_we;
+  reg [2 : 0]   word_idx;
+
+  wire [255 : 0] init_key;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign mac[031 : 000] = mac_reg[0];
+  assign mac[063 : 032] = mac_reg[1];
+  assign mac[095 : 064] = mac_reg[2];
+  assign mac[127 : 096] = mac_reg[3];
+
+  assign ready = ready_reg;
+
+  // Status used by the performance counters.
+  assign pblock_busy = (poly1305_core_ctrl_reg == CTRL_MAC) ||
+                       (poly1305_core_ctrl_reg == CTRL_REDUCE);
+
+  assign final_busy  = (poly1305_core_ctrl_reg == CTRL_FINAL);
+
+  // The context of the message being processed, in the same
+  // format as for poly1305_core.
+  assign ctx = {h_reg[0], h_reg[1], h_reg[2], h_reg[3], h_reg[4],
+                r_reg[0], r_reg[1], r_reg[2], r_reg[3],
+                s_reg[0], s_reg[1], s_reg[2], s_reg[3]};
+
+  // A chained init uses the key for the next message.
+  assign init_key = chain_init ? chain_key : key;
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with synchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      integer i;
+      if (!reset_n)
+        begin
+          for (i = 0 ; i < 5 ; i = i + 1)
+            begin
+              h_reg[i] <= 32'h0;
+              c_reg[i] <= 32'h0;
+            end
+
+          for (i = 0 ; i < 4 ; i = i + 1)
+            begin
+              r_reg[i]   <= 32'h0;
+              rr_reg[i]  <= 32'h0;
+              s_reg[i]   <= 32'h0;
+              mac_reg[i] <= 32'h0;
+              x_reg[i]   <= 64'h0;
+            end
+
+          acc_reg                <= 64'h0;
+          u5_reg                 <= 2'h0;
+          word_ctr_reg           <= 2'h0;
+          step_ctr_reg           <= 4'h0;
+          last_reg               <= 1'h0;
+          ready_reg              <= 1'h1;
+          poly1305_core_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (last_we)
+            last_reg <= last;
+
+          if (ready_we)
+            ready_reg <= ready_new;
+
+          if (h_we)
+            begin
+              for (i = 0 ; i < 5 ; i = i + 1)
+                h_reg[i] <= h_new[i];
+            end
+
+          if (c_we)
+            begin
+              for (i = 0 ; i < 5 ; i = i + 1)
+                c_reg[i] <= c_new[i];
+            end
+
+          if (r_we)
+            begin
+              for (i = 0 ; i < 4 ; i = i + 1)
+                begin
+                  r_reg[i]  <= r_new[i];
+                  rr_reg[i] <= rr_new[i];
+                end
+            end
+
+          if (s_we)
+            begin
+              for (i = 0 ; i < 4 ; i = i + 1)
+                s_reg[i] <= s_new[i];
+            end
+
+          if (mac_we)
+            begin
+              for (i = 0 ; i < 4 ; i = i + 1)
+                mac_reg[i] <= mac_new[i];
+            end
+
+          if (acc_we)
+            acc_reg <= acc_new;
+
+          if (x_we)
+            x_reg[word_ctr_reg] <= acc_new;
+
+          if (u5_we)
+            u5_reg <= acc_new[1 : 0];
+
+          if (word_ctr_we)
+            word_ctr_reg <= word_ctr_new;
+
+          if (step_ctr_we)
+            step_ctr_reg <= step_ctr_new;
+
+          if (poly1305_core_ctrl_we)
+            poly1305_core_ctrl_reg <= poly1305_core_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // poly1305_core_logic
+  //----------------------------------------------------------------
+  always @*
+    begin : poly1305_core_logic
+      integer i;
+      reg [31 : 0] b0;
+      reg [31 : 0] b1;
+      reg [31 : 0] b2;
+      reg [31 : 0] b3;
+
+      for (i = 0 ; i < 5 ; i = i + 1)
+        h_new[i] = 32'h0;
+      h_we = 1'h0;
+
+      for (i = 0 ; i < 5 ; i = i + 1)
+        c_new[i] = 32'h0;
+      c_we = 1'h0;
+
+      for (i = 0 ; i < 4 ; i = i + 1)
+        r_new[i] = 32'h0;
+      r_we = 1'h0;
+
+      for (i = 0 ; i < 4 ; i = i + 1)
+        s_new[i] = 32'h0;
+      s_we = 1'h0;
+
+      for (i = 0 ; i < 4 ; i = i + 1)
+        mac_new[i] = 32'h0;
+      mac_we = 1'h0;
+
+      b0 = le(block[031 : 000]);
+      b1 = le(block[063 : 032]);
+      b2 = le(block[095 : 064]);
+      b3 = le(block[127 : 096]);
+
+      if (state_init)
+        begin
+          c_we     = 1'h1;
+          h_we     = 1'h1;
+
+          // Clamping of the key when assigning r.
+          r_new[0] = le(init_key[255 : 224]) & 32'h0fffffff;
+          r_new[1] = le(init_key[223 : 192]) & 32'h0ffffffc;
+          r_new[2] = le(init_key[191 : 160]) & 32'h0ffffffc;
+          r_new[3] = le(init_key[159 : 128]) & 32'h0ffffffc;
+          r_we     = 1'h1;
+
+          s_new[0] = le(init_key[127 : 096]);
+          s_new[1] = le(init_key[095 : 064]);
+          s_new[2] = le(init_key[063 : 032]);
+          s_new[3] = le(init_key[031 : 000]);
+          s_we     = 1'h1;
+        end
+
+      // Restore of a saved context. The r values are clamped
+      // in the same way as when assigned from the key.
+      if (ctx_restore)
+        begin
+          c_we     = 1'h1;
+
+          h_new[0] = ctx_in[415 : 384];
+          h_new[1] = ctx_in[383 : 352];
+          h_new[2] = ctx_in[351 : 320];
+          h_new[3] = ctx_in[319 : 288];
+          h_new[4] = ctx_in[287 : 256];
+          h_we     = 1'h1;
+
+          r_new[0] = ctx_in[255 : 224] & 32'h0fffffff;
+          r_new[1] = ctx_in[223 : 192] & 32'h0ffffffc;
+          r_new[2] = ctx_in[191 : 160] & 32'h0ffffffc;
+          r_new[3] = ctx_in[159 : 128] & 32'h0ffffffc;
+          r_we     = 1'h1;
+
+          s_new[0] = ctx_in[127 : 096];
+          s_new[1] = ctx_in[095 : 064];
+          s_new[2] = ctx_in[063 : 032];
+          s_new[3] = ctx_in[031 : 000];
+          s_we     = 1'h1;
+        end
+
+      // Precalculated 5 * r operands.
+      rr_new[0] = {2'h0, r_new[0][31 : 2]} * 32'h5;
+      rr_new[1] = {2'h0, r_new[1][31 : 2]} + r_new[1];
+      rr_new[2] = {2'h0, r_new[2][31 : 2]} + r_new[2];
+      rr_new[3] = {2'h0, r_new[3][31 : 2]} + r_new[3];
+
+      // Note that we only check bits 0..3 in blocklen.
+      // This means that a blocklen of 0 and 16 are
+      // handled the same way.
+      if (load_block)
+        begin
+          if (blocklen[3 : 0] > 0)
+            begin
+              // Handling of partial (final) blocks.
+              case (blocklen[3 : 0])
+                0: begin
+                  c_new[0] = 32'h1;
+                end
+
+                1: begin
+                  c_new[0] = {24'h1, b3[7 : 0]};
+                end
+
+                2: begin
+                  c_new[0] = {16'h1, b3[15 : 0]};
+                end
+
+                3: begin
+                  c_new[0] = {8'h1, b3[23 : 0]};
+                end
+
+                4: begin
+                  c_new[0] = b3;
+                  c_new[1] = 32'h1;
+                end
+
+                5: begin
+                  c_new[0] = b3;
+                  c_new[1] = {24'h1, b2[7 : 0]};
+                end
+
+                6: begin
+                  c_new[0] = b3;
+                  c_new[1] = {16'h1, b2[15 : 0]};
+                end
+
+                7: begin
+                  c_new[0] = b3;
+                  c_new[1] = {8'h1, b2[23 : 0]};
+                end
+
+                8: begin
+                  c_new[0] = b3;
+                  c_new[1] = b2;
+                  c_new[2] = 32'h1;
+                end
+
+                9: begin
+                  c_new[0] = b3;
+                  c_new[1] = b2;
+                  c_new[2] = {24'h1, b1[7 : 0]};
+                end
+
+                10: begin
+                  c_new[0] = b3;
+                  c_new[1] = b2;
+                  c_new[2] = {16'h1, b1[15 : 0]};
+                end
+
+                11: begin
+                  c_new[0] = b3;
+                  c_new[1] = b2;
+                  c_new[2] = {8'h1, b1[23 : 0]};
+                end
+
+                12: begin
+                  c_new[0] = b3;
+                  c_new[1] = b2;
+                  c_new[2] = b1;
+                  c_new[3] = 32'h1;
+                end
+
+                13: begin
+                  c_new[0] = b3;
+                  c_new[1] = b2;
+                  c_new[2] = b1;
+                  c_new[3] = {24'h1, b0[7 : 0]};
+                end
+
+                14: begin
+                  c_new[0] = b3;
+                  c_new[1] = b2;
+                  c_new[2] = b1;
+                  c_new[3] = {16'h1, b0[15 : 0]};
+                end
+
+                15: begin
+                  c_new[0] = b3;
+                  c_new[1] = b2;
+                  c_new[2] = b1;
+                  c_new[3] = {8'h1, b0[23 : 0]};
+                end
+              endcase // case (blocklen[3 : 0])
+              c_new[4] = 32'h0;
+              c_we     = 1'h1;
+            end
+          else
+            begin
+              // Handling of full blocks.
+              c_new[0] = b3;
+              c_new[1] = b2;
+              c_new[2] = b1;
+              c_new[3] = b0;
+              c_new[4] = 32'h1;
+              c_we     = 1'h1;
+            end
+        end
+
+      // The words of h and the MAC are written one at
+      // a time from the accumulator.
+      if (h_word_we)
+        begin
+          for (i = 0 ; i < 5 ; i = i + 1)
+            h_new[i] = h_reg[i];
+          h_new[word_idx] = acc_reg[31 : 0];
+          h_we = 1'h1;
+        end
+
+      if (mac_word_we)
+        begin
+          for (i = 0 ; i < 4 ; i = i + 1)
+            mac_new[i] = mac_reg[i];
+          mac_new[word_idx] = le(acc_reg[31 : 0]);
+          mac_we = 1'h1;
+        end
+    end // poly1305_core_logic
+
+
+  //----------------------------------------------------------------
+  // datapath_logic
+  //
+  // The single multiplier and the accumulator adder. In each
+  // cycle the accumulator is updated with:
+  // base + mul_a * mul_b + add_op
+  // where base is zero, the accumulator or the carry word
+  // (upper 32 bits) of the accumulator.
+  //----------------------------------------------------------------
+  always @*
+    begin : datapath_logic
+      reg [63 : 0] base;
+      reg [63 : 0] prod;
+
+      case (base_sel)
+        BASE_ACC:   base = acc_reg;
+        BASE_CARRY: base = {32'h0, acc_reg[63 : 32]};
+        default:    base = 64'h0;
+      endcase // case (base_sel)
+
+      prod    = mul_a * mul_b;
+      acc_new = base + prod + add_op;
+    end // datapath_logic
+
+
+  //----------------------------------------------------------------
+  // microcode
+  //
+  // The schedule for the datapath.
+  //
+  // CTRL_MAC: Multiply-accumulate of x0..x3. In step k of word i
+  // s_k = h_k + c_k is multiplied with r_(i - k) or rr_(i - k + 4).
+  // s_k may be 33 bits. Bit 32 is handled by adding the r operand
+  // shifted 32 bits.
+  //
+  // CTRL_REDUCE: Partial reduction modulo 2^130 - 5. The
+  // multiplier is used with operand one to add the upper word
+  // of x. The new h words are written from the accumulator.
+  // 0: acc = x4 = s4 * (r0 & 3)
+  // 1: acc = u5 = x4 + x3[63 : 32]
+  // 2: acc = u0 = (u5 >> 2) * 5 + x0[31 : 0]
+  // 3: acc = u1 = u0[63 : 32] + x0[63 : 32] + x1[31 : 0], h0 = u0
+  // 4: acc = u2 = u1[63 : 32] + x1[63 : 32] + x2[31 : 0], h1 = u1
+  // 5: acc = u3 = u2[63 : 32] + x2[63 : 32] + x3[31 : 0], h2 = u2
+  // 6: acc = u4 = u3[63 : 32] + u5[1 : 0], h3 = u3
+  // 7: h4 = u4
+  //
+  // CTRL_FINAL: The final processing.
+  // 0..4: acc = u = h + 5, one word at a time.
+  // 5:    acc = (u4 >> 2) * 5 + h0
+  // 6:    acc = uu0 = acc + s0
+  // 7..9: acc = uu1..uu3, mac words 0..2 written.
+  // 10:   mac word 3 written.
+  //----------------------------------------------------------------
+  always @*
+    begin : microcode
+      reg [32 : 0] sv;
+
+      base_sel    = BASE_ZERO;
+      mul_a       = 32'h0;
+      mul_b       = 32'h0;
+      add_op      = 64'h0;
+      acc_we      = 1'h0;
+      x_we        = 1'h0;
+      u5_we       = 1'h0;
+      h_word_we   = 1'h0;
+      mac_word_we = 1'h0;
+      word_idx    = 3'h0;
+      sv          = 33'h0;
+
+      case (poly1305_core_ctrl_reg)
+        CTRL_MAC:
+          begin
+            sv = {1'h0, h_reg[step_ctr_reg]} + {1'h0, c_reg[step_ctr_reg]};
+
+            if (step_ctr_reg <= word_ctr_reg)
+              mul_a = r_reg[word_ctr_reg - step_ctr_reg];
+            else
+              mul_a = rr_reg[word_ctr_reg + 4 - step_ctr_reg];
+
+            mul_b  = sv[31 : 0];
+            add_op = sv[32] ? {mul_a, 32'h0} : 64'h0;
+
+            if (step_ctr_reg > 0)
+              base_sel = BASE_ACC;
+
+            acc_we = 1'h1;
+            x_we   = (step_ctr_reg == 4'h4);
+          end
+
+        CTRL_REDUCE:
+          begin
+            acc_we = 1'h1;
+            case (step_ctr_reg)
+              0:
+                begin
+                  sv     = {1'h0, h_reg[4]} + {1'h0, c_reg[4]};
+                  mul_a  = {30'h0, r_reg[0][1 : 0]};
+                  mul_b  = sv[31 : 0];
+                  add_op = sv[32] ? {30'h0, r_reg[0][1 : 0], 32'h0} : 64'h0;
+                end
+
+              1:
+                begin
+                  base_sel = BASE_ACC;
+                  mul_a    = x_reg[3][63 : 32];
+                  mul_b    = 32'h1;
+                  u5_we    = 1'h1;
+                end
+
+              2:
+                begin
+                  mul_a  = {2'h0, acc_reg[31 : 2]};
+                  mul_b  = 32'h5;
+                  add_op = {32'h0, x_reg[0][31 : 0]};
+                end
+
+              3, 4, 5:
+                begin
+                  base_sel  = BASE_CARRY;
+                  mul_a     = x_reg[step_ctr_reg - 3][63 : 32];
+                  mul_b     = 32'h1;
+                  add_op    = {32'h0, x_reg[step_ctr_reg - 2][31 : 0]};
+                  h_word_we = 1'h1;
+                  word_idx  = step_ctr_reg - 3;
+                end
+
+              6:
+                begin
+                  base_sel  = BASE_CARRY;
+                  add_op    = {62'h0, u5_reg};
+                  h_word_we = 1'h1;
+                  word_idx  = 3'h3;
+                end
+
+              default:
+                begin
+                  acc_we    = 1'h0;
+                  h_word_we = 1'h1;
+                  word_idx  = 3'h4;
+                end
+            endcase // case (step_ctr_reg)
+          end
+
+        CTRL_FINAL:
+          begin
+            acc_we = 1'h1;
+            case (step_ctr_reg)
+              0:
+                begin
+                  mul_a  = h_reg[0];
+                  mul_b  = 32'h1;
+                  add_op = 64'h5;
+                end
+
+              1, 2, 3, 4:
+                begin
+                  base_sel = BASE_CARRY;
+                  mul_a    = h_reg[step_ctr_reg];
+                  mul_b    = 32'h1;
+                end
+
+              5:
+                begin
+                  mul_a  = acc_reg[33 : 2];
+                  mul_b  = 32'h5;
+                  add_op = {32'h0, h_reg[0]};
+                end
+
+              6:
+                begin
+                  base_sel = BASE_ACC;
+                  mul_a    = s_reg[0];
+                  mul_b    = 32'h1;
+                end
+
+              7, 8, 9:
+                begin
+                  base_sel    = BASE_CARRY;
+                  mul_a       = h_reg[step_ctr_reg - 6];
+                  mul_b       = 32'h1;
+                  add_op      = {32'h0, s_reg[step_ctr_reg - 6]};
+                  mac_word_we = 1'h1;
+                  word_idx    = 10 - step_ctr_reg;
+                end
+
+              default:
+                begin
+                  acc_we      = 1'h0;
+                  mac_word_we = 1'h1;
+                  word_idx    = 3'h0;
+                end
+            endcase // case (step_ctr_reg)
+          end
+
+        default:
+          begin
+          end
+      endcase // case (poly1305_core_ctrl_reg)
+    end // microcode
+
+
+  //----------------------------------------------------------------
+  // word_ctr
+  //----------------------------------------------------------------
+  always @*
+    begin : word_ctr
+      word_ctr_new = 2'h0;
+      word_ctr_we  = 1'h0;
+
+      if (word_ctr_rst)
+        begin
+          word_ctr_new = 2'h0;
+          word_ctr_we  = 1'h1;
+        end
+      else if (word_ctr_inc)
+        begin
+          word_ctr_new = word_ctr_reg + 1'h1;
+          word_ctr_we  = 1'h1;
+        end
+    end
+
+
+  //----------------------------------------------------------------
+  // step_ctr
+  //----------------------------------------------------------------
+  always @*
+    begin : step_ctr
+      step_ctr_new = 4'h0;
+      step_ctr_we  = 1'h0;
+
+      if (step_ctr_rst)
+        begin
+          step_ctr_new = 4'h0;
+          step_ctr_we  = 1'h1;
+        end
+      else if (step_ctr_inc)
+        begin
+          step_ctr_new = step_ctr_reg + 1'h1;
+          step_ctr_we  = 1'h1;
+        end
+    end
+
+
+  //----------------------------------------------------------------
+  // poly1305_core_ctrl
+  //----------------------------------------------------------------
+  always @*
+    begin : poly1305_core_ctrl
+      state_init             = 1'h0;
+      chain_init             = 1'h0;
+      ctx_restore            = 1'h0;
+      load_block             = 1'h0;
+      last_we                = 1'h0;
+      word_ctr_rst           = 1'h0;
+      word_ctr_inc           = 1'h0;
+      step_ctr_rst           = 1'h0;
+      step_ctr_inc           = 1'h0;
+      ready_new              = 1'h0;
+      ready_we               = 1'h0;
+      poly1305_core_ctrl_new = CTRL_IDLE;
+      poly1305_core_ctrl_we  = 1'h0;
+
+
+      case (poly1305_core_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            word_ctr_rst = 1'h1;
+            step_ctr_rst = 1'h1;
+
+            if (init)
+              begin
+                state_init             = 1'h1;
+                ready_new              = 1'h0;
+                ready_we               = 1'h1;
+                poly1305_core_ctrl_new = CTRL_READY;
+                poly1305_core_ctrl_we  = 1'h1;
+              end
+
+            if (restore)
+              begin
+                ctx_restore            = 1'h1;
+                ready_new              = 1'h0;
+                ready_we               = 1'h1;
+                poly1305_core_ctrl_new = CTRL_READY;
+                poly1305_core_ctrl_we  = 1'h1;
+              end
+
+            if (next)
+              begin
+                load_block             = 1'h1;
+                last_we                = 1'h1;
+                ready_new              = 1'h0;
+                ready_we               = 1'h1;
+                poly1305_core_ctrl_we  = 1'h1;
+
+                if (blocklen > 0)
+                  poly1305_core_ctrl_new = CTRL_MAC;
+                else if (last)
+                  poly1305_core_ctrl_new = CTRL_FINAL;
+                else
+                  poly1305_core_ctrl_new = CTRL_READY;
+              end
+
+            if (finish)
+              begin
+                ready_new              = 1'h0;
+                ready_we               = 1'h1;
+                poly1305_core_ctrl_new = CTRL_FINAL;
+                poly1305_core_ctrl_we  = 1'h1;
+              end
+          end
+
+
+        CTRL_MAC:
+          begin
+            if (step_ctr_reg == 4'h4)
+              begin
+                step_ctr_rst = 1'h1;
+                word_ctr_inc = 1'h1;
+                if (word_ctr_reg == 2'h3)
+                  begin
+                    poly1305_core_ctrl_new = CTRL_REDUCE;
+                    poly1305_core_ctrl_we  = 1'h1;
+                  end
+              end
+            else
+              step_ctr_inc = 1'h1;
+          end
+
+
+        CTRL_REDUCE:
+          begin
+            step_ctr_inc = 1'h1;
+            if (step_ctr_reg == REDUCE_STEPS)
+              begin
+                step_ctr_rst           = 1'h1;
+                poly1305_core_ctrl_we  = 1'h1;
+                if (last_reg)
+                  poly1305_core_ctrl_new = CTRL_FINAL;
+                else
+                  begin
+                    ready_new              = 1'h1;
+                    ready_we               = 1'h1;
+                    poly1305_core_ctrl_new = CTRL_IDLE;
+                  end
+              end
+          end
+
+
+        // In chain mode the core is initialized with the chain
+        // key in the same cycle as the last mac word is written.
+        CTRL_FINAL:
+          begin
+            step_ctr_inc = 1'h1;
+            if (step_ctr_reg == FINAL_STEPS)
+              begin
+                poly1305_core_ctrl_we  = 1'h1;
+                if (chain)
+                  begin
+                    state_init             = 1'h1;
+                    chain_init             = 1'h1;
+                    poly1305_core_ctrl_new = CTRL_READY;
+                  end
+                else
+                  begin
+                    ready_new              = 1'h1;
+                    ready_we               = 1'h1;
+                    poly1305_core_ctrl_new = CTRL_IDLE;
+                  end
+              end
+          end
+
+
+        CTRL_READY:
+          begin
+            ready_new              = 1'h1;
+            ready_we               = 1'h1;
+            poly1305_core_ctrl_new = CTRL_IDLE;
+            poly1305_core_ctrl_we  = 1'h1;
+          end
+
+        default:
+          begin
+          end
+      endcase // case (poly1305_core_ctrl_reg)
+    end
+
+endmodule // poly1305_core_small
+
+//======================================================================
+// EOF poly1305_core_small.v
+//======================================================================
@@ -0,0 +1,362 @@
+//======================================================================
+//
+// poly1305_dc.v
+// -------------
+// Dual clock version of the Poly1305 AXI4-Stream wrapper. The
+// core runs in a separate clock domain and is connected to the
+// stream interfaces through asynchronous FIFOs.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_dc #(parameter FIFO_ADDR_BITS = 2,
+                     parameter LOW_LATENCY    = 0,
+                     parameter FINAL_LATENCY  = 0,
+                     parameter HIGH_FMAX      = 0,
+                     parameter PIPE_DEPTH     = 9)
+                   (
+                    input wire            clk,
+                    input wire            reset_n,
+
+                    input wire            core_clk,
+                    input wire            core_reset_n,
+
+                    input wire [255 : 0]  key,
+
+                    input wire [127 : 0]  s_axis_tdata,
+                    input wire [15 : 0]   s_axis_tkeep,
+                    input wire            s_axis_tlast,
+                    input wire            s_axis_tvalid,
+                    output wire           s_axis_tready,
+
+                    output wire [127 : 0] m_axis_tdata,
+                    output wire           m_axis_tvalid,
+                    input wire            m_axis_tready
+                   );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam CTRL_IDLE     = 1'h0;
+  localparam CTRL_TAG_WAIT = 1'h1;
+
+  // Command FIFO entry: first, last, blocklen and block.
+  localparam CMD_WIDTH     = 135;
+
+
+  //----------------------------------------------------------------
+  // Internal functions.
+  //----------------------------------------------------------------
+  // The first byte in a stream beat is in the least significant
+  // byte lane. The core expects the first byte in the most
+  // significant byte of the block and mac.
+  function [127 : 0] bswap(input [127 : 0] w);
+    integer i;
+    begin
+      for (i = 0 ; i < 16 ; i = i + 1)
+        bswap[(15 - i) * 8 +: 8] = w[i * 8 +: 8];
+    end
+  endfunction // bswap
+
+  // The number of valid bytes in a beat. Note that
+  // keep is expected to be contiguous from byte lane zero.
+  function [4 : 0] keep_len(input [15 : 0] keep);
+    integer i;
+    begin
+      keep_len = 5'h0;
+      for (i = 0 ; i < 16 ; i = i + 1)
+        keep_len = keep_len + keep[i];
+    end
+  endfunction // keep_len
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  // Bus clock domain.
+  reg           first_reg;
+
+  // Core clock domain.
+  reg           init_done_reg;
+  reg           init_done_new;
+  reg           init_done_we;
+
+  reg           dc_ctrl_reg;
+  reg           dc_ctrl_new;
+  reg           dc_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  wire                     s_axis_push;
+  wire [4 : 0]             s_axis_len;
+
+  wire                     key_full;
+  wire                     key_empty;
+  reg                      key_rd_en;
+  wire [255 : 0]           key_rd_data;
+
+  wire                     cmd_full;
+  wire                     cmd_empty;
+  reg                      cmd_rd_en;
+  wire [(CMD_WIDTH - 1) : 0] cmd_wr_data;
+  wire [(CMD_WIDTH - 1) : 0] cmd_rd_data;
+  wire                     cmd_first;
+  wire                     cmd_last;
+
+  wire                     tag_full;
+  wire                     tag_empty;
+  reg                      tag_wr_en;
+  wire [127 : 0]           tag_rd_data;
+
+  reg                      core_init;
+  reg                      core_next;
+  wire                     core_ready;
+  wire [127 : 0]           core_mac;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  // The first beat of a message also pushes the key.
+  assign s_axis_tready = !cmd_full && (!first_reg || !key_full);
+  assign s_axis_push   = s_axis_tvalid && s_axis_tready;
+  assign s_axis_len    = s_axis_tlast ? keep_len(s_axis_tkeep) : 5'h10;
+
+  assign cmd_wr_data   = {first_reg, s_axis_tlast, s_axis_len, bswap(s_axis_tdata)};
+  assign cmd_first     = cmd_rd_data[134];
+  assign cmd_last      = cmd_rd_data[133];
+
+  assign m_axis_tdata  = bswap(tag_rd_data);
+  assign m_axis_tvalid = !tag_empty;
+
+
+  //----------------------------------------------------------------
+  // Clock domain crossing FIFOs.
+  //----------------------------------------------------------------
+  poly1305_async_fifo #(.WIDTH(256), .ADDR_BITS(1))
+                      key_fifo(
+                               .wr_clk(clk),
+                               .wr_reset_n(reset_n),
+                               .wr_en(s_axis_push && first_reg),
+                               .wr_data(key),
+                               .wr_full(key_full),
+
+                               .rd_clk(core_clk),
+                               .rd_reset_n(core_reset_n),
+                               .rd_en(key_rd_en),
+                               .rd_data(key_rd_data),
+                               .rd_empty(key_empty)
+                              );
+
+
+  poly1305_async_fifo #(.WIDTH(CMD_WIDTH), .ADDR_BITS(FIFO_ADDR_BITS))
+                      cmd_fifo(
+                               .wr_clk(clk),
+                               .wr_reset_n(reset_n),
+                               .wr_en(s_axis_push),
+                               .wr_data(cmd_wr_data),
+                               .wr_full(cmd_full),
+
+                               .rd_clk(core_clk),
+                               .rd_reset_n(core_reset_n),
+                               .rd_en(cmd_rd_en),
+                               .rd_data(cmd_rd_data),
+                               .rd_empty(cmd_empty)
+                              );
+
+
+  poly1305_async_fifo #(.WIDTH(128), .ADDR_BITS(1))
+                      tag_fifo(
+                               .wr_clk(core_clk),
+                               .wr_reset_n(core_reset_n),
+                               .wr_en(tag_wr_en),
+                               .wr_data(core_mac),
+                               .wr_full(tag_full),
+
+                               .rd_clk(clk),
+                               .rd_reset_n(reset_n),
+                               .rd_en(m_axis_tready),
+                               .rd_data(tag_rd_data),
+                               .rd_empty(tag_empty)
+                              );
+
+
+  //----------------------------------------------------------------
+  // core instantiation.
+  //----------------------------------------------------------------
+  poly1305_core #(.LOW_LATENCY(LOW_LATENCY), .FINAL_LATENCY(FINAL_LATENCY),
+                  .HIGH_FMAX(HIGH_FMAX), .PIPE_DEPTH(PIPE_DEPTH))
+                core(
+                     .clk(core_clk),
+                     .reset_n(core_reset_n),
+                     .init(core_init),
+                     .next(core_next),
+                     .last(cmd_last),
+                     .finish(1'h0),
+                     .restore(1'h0),
+                     .ready(core_ready),
+                     .pblock_busy(),
+                     .final_busy(),
+                     .key(key_rd_data),
+                     .chain(1'h0),
+                     .chain_key(256'h0),
+                     .block(cmd_rd_data[127 : 0]),
+                     .blocklen(cmd_rd_data[132 : 128]),
+                     .ctx_in(416'h0),
+                     .ctx(),
+                     .mac(core_mac)
+                    );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for the registers in the bus clock
+  // domain. All registers are positive edge triggered with
+  // synchronous active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          first_reg <= 1'h1;
+        end
+      else
+        begin
+          if (s_axis_push)
+            first_reg <= s_axis_tlast;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // core_reg_update
+  //
+  // Update functionality for the registers in the core clock
+  // domain.
+  //----------------------------------------------------------------
+  always @ (posedge core_clk)
+    begin : core_reg_update
+      if (!core_reset_n)
+        begin
+          init_done_reg <= 1'h0;
+          dc_ctrl_reg   <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (init_done_we)
+            init_done_reg <= init_done_new;
+
+          if (dc_ctrl_we)
+            dc_ctrl_reg <= dc_ctrl_new;
+        end
+    end // core_reg_update
+
+
+  //----------------------------------------------------------------
+  // dc_ctrl
+  //
+  // Control in the core clock domain. When the entry at the
+  // head of the command FIFO is the first block of a message,
+  // the core is initialized with the key at the head of the key
+  // FIFO before the block is processed. The final block is
+  // processed with last set and the mac is then pushed to the
+  // tag FIFO.
+  //----------------------------------------------------------------
+  always @*
+    begin : dc_ctrl
+      core_init     = 1'h0;
+      core_next     = 1'h0;
+      key_rd_en     = 1'h0;
+      cmd_rd_en     = 1'h0;
+      tag_wr_en     = 1'h0;
+      init_done_new = 1'h0;
+      init_done_we  = 1'h0;
+      dc_ctrl_new   = CTRL_IDLE;
+      dc_ctrl_we    = 1'h0;
+
+      case (dc_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (!cmd_empty && core_ready)
+              begin
+                if (cmd_first && !init_done_reg)
+                  begin
+                    if (!key_empty)
+                      begin
+                        core_init     = 1'h1;
+                        key_rd_en     = 1'h1;
+                        init_done_new = 1'h1;
+                        init_done_we  = 1'h1;
+                      end
+                  end
+                else
+                  begin
+                    core_next     = 1'h1;
+                    cmd_rd_en     = 1'h1;
+                    init_done_new = 1'h0;
+                    init_done_we  = 1'h1;
+
+                    if (cmd_last)
+                      begin
+                        dc_ctrl_new = CTRL_TAG_WAIT;
+                        dc_ctrl_we  = 1'h1;
+                      end
+                  end
+              end
+          end
+
+        CTRL_TAG_WAIT:
+          begin
+            if (core_ready && !tag_full)
+              begin
+                tag_wr_en   = 1'h1;
+                dc_ctrl_new = CTRL_IDLE;
+                dc_ctrl_we  = 1'h1;
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (dc_ctrl_reg)
+    end // dc_ctrl
+
+endmodule // poly1305_dc
+
+//======================================================================
+// EOF poly1305_dc.v
+//======================================================================
@@ -0,0 +1,666 @@
+//======================================================================
+//
+// poly1305_dma.v
+// --------------
+// Descriptor driven DMA front end for the Poly1305 core.
+// The engine walks a ring of descriptors in memory, fetches
+// the key and message for each descriptor, and writes the
+// tag back to memory.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_dma(
+                    input wire           clk,
+                    input wire           reset_n,
+
+                    input wire           cs,
+                    input wire           we,
+                    input wire  [7 : 0]  address,
+                    input wire  [31 : 0] write_data,
+                    output wire [31 : 0] read_data,
+
+                    output wire          irq,
+
+                    output wire          mem_cs,
+                    output wire          mem_we,
+                    output wire [31 : 0] mem_address,
+                    output wire [31 : 0] mem_write_data,
+                    input wire  [31 : 0] mem_read_data,
+                    input wire           mem_ready
+                   );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam ADDR_NAME0       = 8'h00;
+  localparam ADDR_NAME1       = 8'h01;
+  localparam ADDR_VERSION     = 8'h02;
+
+  localparam ADDR_CTRL        = 8'h08;
+  localparam CTRL_ENABLE_BIT  = 0;
+  localparam CTRL_IRQ_ACK_BIT = 1;
+
+  localparam ADDR_STATUS      = 8'h09;
+  localparam STATUS_IDLE_BIT  = 0;
+  localparam STATUS_DONE_BIT  = 1;
+
+  localparam ADDR_RING_BASE   = 8'h10;
+  localparam ADDR_RING_SIZE   = 8'h11;
+  localparam ADDR_RING_HEAD   = 8'h12;
+  localparam ADDR_RING_TAIL   = 8'h13;
+
+  localparam CORE_NAME0       = 32'h706f6c79; // "poly"
+  localparam CORE_NAME1       = 32'h646d6120; // "dma "
+  localparam CORE_VERSION     = 32'h312e3030; // "1.00"
+
+  // Each descriptor in the ring is four words: Address of the
+  // 32 byte key, address of the message, message length in
+  // bytes and address of the 16 byte tag. All addresses must
+  // be word aligned. The descriptor at index i is located at
+  // ring base + 16 * i.
+  localparam DESC_KEY         = 2'h0;
+  localparam DESC_MSG         = 2'h1;
+  localparam DESC_LEN         = 2'h2;
+  localparam DESC_TAG         = 2'h3;
+
+  localparam CTRL_IDLE        = 4'h0;
+  localparam CTRL_DESC        = 4'h1;
+  localparam CTRL_KEY         = 4'h2;
+  localparam CTRL_INIT        = 4'h3;
+  localparam CTRL_DATA        = 4'h4;
+  localparam CTRL_NEXT        = 4'h5;
+  localparam CTRL_FINISH      = 4'h6;
+  localparam CTRL_FINISH_WAIT = 4'h7;
+  localparam CTRL_TAG         = 4'h8;
+  localparam CTRL_DONE        = 4'h9;
+
+
+  //----------------------------------------------------------------
+  // Internal functions.
+  //----------------------------------------------------------------
+  // Memory words are little endian, the core expects the first
+  // byte of keys and blocks in the most significant byte.
+  function [31 : 0] bswap(input [31 : 0] w);
+    bswap = {w[7 : 0], w[15 : 8], w[23 : 16], w[31 : 24]};
+  endfunction // bswap
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg           enable_reg;
+  reg           enable_we;
+
+  reg           done_reg;
+  reg           done_new;
+  reg           done_we;
+
+  reg [31 : 0]  ring_base_reg;
+  reg           ring_base_we;
+
+  reg [31 : 0]  ring_size_reg;
+  reg           ring_size_we;
+
+  reg [31 : 0]  ring_head_reg;
+  reg           ring_head_we;
+
+  reg [31 : 0]  ring_tail_reg;
+  reg [31 : 0]  ring_tail_new;
+  reg           ring_tail_we;
+
+  reg [31 : 0]  desc_reg [0 : 3];
+  reg           desc_we;
+
+  reg [31 : 0]  key_reg [0 : 7];
+  reg           key_we;
+
+  reg [31 : 0]  block_reg [0 : 3];
+  reg           block_we;
+  reg           block_rst;
+
+  reg [31 : 0]  msg_addr_reg;
+  reg [31 : 0]  msg_addr_new;
+  reg           msg_addr_we;
+
+  reg [31 : 0]  msg_len_reg;
+  reg [31 : 0]  msg_len_new;
+  reg           msg_len_we;
+
+  reg [2 : 0]   word_ctr_reg;
+  reg [2 : 0]   word_ctr_new;
+  reg           word_ctr_we;
+  reg           word_ctr_rst;
+  reg           word_ctr_inc;
+
+  reg [3 : 0]   dma_ctrl_reg;
+  reg [3 : 0]   dma_ctrl_new;
+  reg           dma_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg [31 : 0]   tmp_read_data;
+  reg            tmp_mem_cs;
+  reg            tmp_mem_we;
+  reg [31 : 0]   tmp_mem_address;
+  reg [31 : 0]   tmp_mem_write_data;
+
+  reg            core_init;
+  reg            core_next;
+  reg            core_last;
+  reg            core_finish;
+  wire           core_ready;
+  wire [255 : 0] core_key;
+  wire [127 : 0] core_block;
+  reg [4 : 0]    core_blocklen;
+  wire [127 : 0] core_mac;
+
+  reg            load_msg;
+  reg            update_msg;
+  reg [2 : 0]    block_words;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign read_data      = tmp_read_data;
+  assign irq            = done_reg;
+
+  assign mem_cs         = tmp_mem_cs;
+  assign mem_we         = tmp_mem_we;
+  assign mem_address    = tmp_mem_address;
+  assign mem_write_data = tmp_mem_write_data;
+
+  assign core_key = {key_reg[0], key_reg[1], key_reg[2], key_reg[3],
+                     key_reg[4], key_reg[5], key_reg[6], key_reg[7]};
+
+  assign core_block = {block_reg[0], block_reg[1], block_reg[2], block_reg[3]};
+
+
+  //----------------------------------------------------------------
+  // core instantiation.
+  //----------------------------------------------------------------
+  poly1305_core core(
+                     .clk(clk),
+                     .reset_n(reset_n),
+                     .init(core_init),
+                     .next(core_next),
+                     .last(core_last),
+                     .finish(core_finish),
+                     .restore(1'h0),
+                     .ready(core_ready),
+                     .pblock_busy(),
+                     .final_busy(),
+                     .key(core_key),
+                     .chain(1'h0),
+                     .chain_key(256'h0),
+                     .block(core_block),
+                     .blocklen(core_blocklen),
+                     .ctx_in(416'h0),
+                     .ctx(),
+                     .mac(core_mac)
+                    );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with synchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      integer i;
+
+      if (!reset_n)
+        begin
+          for (i = 0 ; i < 4 ; i = i + 1)
+            begin
+              desc_reg[i]  <= 32'h0;
+              block_reg[i] <= 32'h0;
+            end
+
+          for (i = 0 ; i < 8 ; i = i + 1)
+            key_reg[i] <= 32'h0;
+
+          enable_reg    <= 1'h0;
+          done_reg      <= 1'h0;
+          ring_base_reg <= 32'h0;
+          ring_size_reg <= 32'h0;
+          ring_head_reg <= 32'h0;
+          ring_tail_reg <= 32'h0;
+          msg_addr_reg  <= 32'h0;
+          msg_len_reg   <= 32'h0;
+          word_ctr_reg  <= 3'h0;
+          dma_ctrl_reg  <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (enable_we)
+            enable_reg <= write_data[CTRL_ENABLE_BIT];
+
+          if (done_we)
+            done_reg <= done_new;
+
+          if (ring_base_we)
+            ring_base_reg <= write_data;
+
+          if (ring_size_we)
+            ring_size_reg <= write_data;
+
+          if (ring_head_we)
+            ring_head_reg <= write_data;
+
+          if (ring_tail_we)
+            ring_tail_reg <= ring_tail_new;
+
+          if (desc_we)
+            desc_reg[word_ctr_reg[1 : 0]] <= mem_read_data;
+
+          if (key_we)
+            key_reg[word_ctr_reg] <= bswap(mem_read_data);
+
+          if (block_rst)
+            begin
+              for (i = 0 ; i < 4 ; i = i + 1)
+                block_reg[i] <= 32'h0;
+            end
+
+          if (block_we)
+            block_reg[word_ctr_reg[1 : 0]] <= bswap(mem_read_data);
+
+          if (msg_addr_we)
+            msg_addr_reg <= msg_addr_new;
+
+          if (msg_len_we)
+            msg_len_reg <= msg_len_new;
+
+          if (word_ctr_we)
+            word_ctr_reg <= word_ctr_new;
+
+          if (dma_ctrl_we)
+            dma_ctrl_reg <= dma_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // msg_logic
+  //
+  // Tracks the address and remaining length of the message
+  // and decides the number of words and length of each block.
+  //----------------------------------------------------------------
+  always @*
+    begin : msg_logic
+      msg_addr_new = 32'h0;
+      msg_addr_we  = 1'h0;
+      msg_len_new  = 32'h0;
+      msg_len_we   = 1'h0;
+
+      if (msg_len_reg >= 32'h10)
+        begin
+          core_blocklen = 5'h10;
+          block_words   = 3'h4;
+        end
+      else
+        begin
+          core_blocklen = msg_len_reg[4 : 0];
+          block_words   = msg_len_reg[4 : 2] + (msg_len_reg[1 : 0] != 2'h0);
+        end
+
+      if (load_msg)
+        begin
+          msg_addr_new = desc_reg[DESC_MSG];
+          msg_addr_we  = 1'h1;
+          msg_len_new  = desc_reg[DESC_LEN];
+          msg_len_we   = 1'h1;
+        end
+
+      if (update_msg)
+        begin
+          msg_addr_new = msg_addr_reg + 32'h10;
+          msg_addr_we  = 1'h1;
+          msg_len_new  = msg_len_reg - core_blocklen;
+          msg_len_we   = 1'h1;
+        end
+    end // msg_logic
+
+
+  //----------------------------------------------------------------
+  // mem_mux
+  //
+  // Selects the memory address and write data based on
+  // the current transfer.
+  //----------------------------------------------------------------
+  always @*
+    begin : mem_mux
+      tmp_mem_write_data = bswap(core_mac[(3 - word_ctr_reg[1 : 0]) * 32 +: 32]);
+
+      case (dma_ctrl_reg)
+        CTRL_DESC:
+          tmp_mem_address = ring_base_reg + {ring_tail_reg[27 : 0], 4'h0} +
+                            {word_ctr_reg, 2'h0};
+
+        CTRL_KEY:
+          tmp_mem_address = desc_reg[DESC_KEY] + {word_ctr_reg, 2'h0};
+
+        CTRL_TAG:
+          tmp_mem_address = desc_reg[DESC_TAG] + {word_ctr_reg, 2'h0};
+
+        default:
+          tmp_mem_address = msg_addr_reg + {word_ctr_reg, 2'h0};
+      endcase // case (dma_ctrl_reg)
+    end // mem_mux
+
+
+  //----------------------------------------------------------------
+  // word_ctr
+  //----------------------------------------------------------------
+  always @*
+    begin : word_ctr
+      word_ctr_new = 3'h0;
+      word_ctr_we  = 1'h0;
+
+      if (word_ctr_rst)
+        begin
+          word_ctr_new = 3'h0;
+          word_ctr_we  = 1'h1;
+        end
+      else if (word_ctr_inc)
+        begin
+          word_ctr_new = word_ctr_reg + 1'h1;
+          word_ctr_we  = 1'h1;
+        end
+    end // word_ctr
+
+
+  //----------------------------------------------------------------
+  // dma_ctrl
+  //
+  // Fetches descriptors from the ring while the head differs
+  // from the tail. For each descriptor the key is fetched and
+  // the core initialized. Each block is fetched while the
+  // previous block is being processed by the core. The final
+  // block is processed with last set, which makes the core
+  // perform the final processing directly. Messages without
+  // blocks are completed using finish. The tag is then written
+  // to memory, the tail advanced and completion signalled.
+  //----------------------------------------------------------------
+  always @*
+    begin : dma_ctrl
+      tmp_mem_cs    = 1'h0;
+      tmp_mem_we    = 1'h0;
+      core_init     = 1'h0;
+      core_next     = 1'h0;
+      core_last     = 1'h0;
+      core_finish   = 1'h0;
+      desc_we       = 1'h0;
+      key_we        = 1'h0;
+      block_we      = 1'h0;
+      block_rst     = 1'h0;
+      load_msg      = 1'h0;
+      update_msg    = 1'h0;
+      word_ctr_rst  = 1'h0;
+      word_ctr_inc  = 1'h0;
+      ring_tail_new = 32'h0;
+      ring_tail_we  = 1'h0;
+      done_new      = 1'h0;
+      done_we       = 1'h0;
+      dma_ctrl_new  = CTRL_IDLE;
+      dma_ctrl_we   = 1'h0;
+
+      if (cs && we && (address == ADDR_CTRL) && write_data[CTRL_IRQ_ACK_BIT])
+        begin
+          done_new = 1'h0;
+          done_we  = 1'h1;
+        end
+
+      case (dma_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (enable_reg && (ring_head_reg != ring_tail_reg))
+              begin
+                word_ctr_rst = 1'h1;
+                dma_ctrl_new = CTRL_DESC;
+                dma_ctrl_we  = 1'h1;
+              end
+          end
+
+
+        CTRL_DESC:
+          begin
+            tmp_mem_cs = 1'h1;
+            if (mem_ready)
+              begin
+                desc_we      = 1'h1;
+                word_ctr_inc = 1'h1;
+                if (word_ctr_reg == 3'h3)
+                  begin
+                    word_ctr_rst = 1'h1;
+                    dma_ctrl_new = CTRL_KEY;
+                    dma_ctrl_we  = 1'h1;
+                  end
+              end
+          end
+
+
+        CTRL_KEY:
+          begin
+            tmp_mem_cs = 1'h1;
+            if (mem_ready)
+              begin
+                key_we       = 1'h1;
+                word_ctr_inc = 1'h1;
+                if (word_ctr_reg == 3'h7)
+                  begin
+                    dma_ctrl_new = CTRL_INIT;
+                    dma_ctrl_we  = 1'h1;
+                  end
+              end
+          end
+
+
+        CTRL_INIT:
+          begin
+            if (core_ready)
+              begin
+                core_init    = 1'h1;
+                load_msg     = 1'h1;
+                block_rst    = 1'h1;
+                word_ctr_rst = 1'h1;
+                dma_ctrl_we  = 1'h1;
+                if (desc_reg[DESC_LEN] == 32'h0)
+                  dma_ctrl_new = CTRL_FINISH;
+                else
+                  dma_ctrl_new = CTRL_DATA;
+              end
+          end
+
+
+        CTRL_DATA:
+          begin
+            tmp_mem_cs = 1'h1;
+            if (mem_ready)
+              begin
+                block_we     = 1'h1;
+                word_ctr_inc = 1'h1;
+                if (word_ctr_reg == (block_words - 1'h1))
+                  begin
+                    dma_ctrl_new = CTRL_NEXT;
+                    dma_ctrl_we  = 1'h1;
+                  end
+              end
+          end
+
+
+        CTRL_NEXT:
+          begin
+            if (core_ready)
+              begin
+                core_next    = 1'h1;
+                update_msg   = 1'h1;
+                block_rst    = 1'h1;
+                word_ctr_rst = 1'h1;
+                dma_ctrl_we  = 1'h1;
+                if (msg_len_reg == {27'h0, core_blocklen})
+                  begin
+                    core_last    = 1'h1;
+                    dma_ctrl_new = CTRL_FINISH_WAIT;
+                  end
+                else
+                  dma_ctrl_new = CTRL_DATA;
+              end
+          end
+
+
+        CTRL_FINISH:
+          begin
+            if (core_ready)
+              begin
+                core_finish  = 1'h1;
+                dma_ctrl_new = CTRL_FINISH_WAIT;
+                dma_ctrl_we  = 1'h1;
+              end
+          end
+
+
+        CTRL_FINISH_WAIT:
+          begin
+            if (core_ready)
+              begin
+                word_ctr_rst = 1'h1;
+                dma_ctrl_new = CTRL_TAG;
+                dma_ctrl_we  = 1'h1;
+              end
+          end
+
+
+        CTRL_TAG:
+          begin
+            tmp_mem_cs = 1'h1;
+            tmp_mem_we = 1'h1;
+            if (mem_ready)
+              begin
+                word_ctr_inc = 1'h1;
+                if (word_ctr_reg == 3'h3)
+                  begin
+                    dma_ctrl_new = CTRL_DONE;
+                    dma_ctrl_we  = 1'h1;
+                  end
+              end
+          end
+
+
+        CTRL_DONE:
+          begin
+            if (ring_tail_reg == (ring_size_reg - 1'h1))
+              ring_tail_new = 32'h0;
+            else
+              ring_tail_new = ring_tail_reg + 1'h1;
+            ring_tail_we = 1'h1;
+            done_new     = 1'h1;
+            done_we      = 1'h1;
+            dma_ctrl_new = CTRL_IDLE;
+            dma_ctrl_we  = 1'h1;
+          end
+
+        default:
+          begin
+          end
+      endcase // case (dma_ctrl_reg)
+    end // dma_ctrl
+
+
+  //----------------------------------------------------------------
+  // api
+  //
+  // The interface command decoding logic.
+  //----------------------------------------------------------------
+  always @*
+    begin : api
+      enable_we     = 1'h0;
+      ring_base_we  = 1'h0;
+      ring_size_we  = 1'h0;
+      ring_head_we  = 1'h0;
+      tmp_read_data = 32'h0;
+
+      if (cs)
+        begin
+          if (we)
+            begin
+              // A write with the irq ack bit set only clears done
+              // and leaves the enable bit unchanged.
+              if ((address == ADDR_CTRL) && !write_data[CTRL_IRQ_ACK_BIT])
+                enable_we = 1'h1;
+
+              if (address == ADDR_RING_BASE)
+                ring_base_we = 1'h1;
+
+              if (address == ADDR_RING_SIZE)
+                ring_size_we = 1'h1;
+
+              if (address == ADDR_RING_HEAD)
+                ring_head_we = 1'h1;
+            end // if (we)
+
+          else
+            begin
+              case (address)
+                ADDR_NAME0:     tmp_read_data = CORE_NAME0;
+                ADDR_NAME1:     tmp_read_data = CORE_NAME1;
+                ADDR_VERSION:   tmp_read_data = CORE_VERSION;
+                ADDR_CTRL:      tmp_read_data = {31'h0, enable_reg};
+                ADDR_STATUS:    tmp_read_data = {30'h0, done_reg,
+                                                 ((dma_ctrl_reg == CTRL_IDLE) &&
+                                                  (ring_head_reg == ring_tail_reg))};
+                ADDR_RING_BASE: tmp_read_data = ring_base_reg;
+                ADDR_RING_SIZE: tmp_read_data = ring_size_reg;
+                ADDR_RING_HEAD: tmp_read_data = ring_head_reg;
+                ADDR_RING_TAIL: tmp_read_data = ring_tail_reg;
+                default:
+                  begin
+                  end
+              endcase // case (address)
+            end
+        end
+    end // api
+
+endmodule // poly1305_dma
+
+//======================================================================
+// EOF poly1305_dma.v
+//======================================================================
@@ -4,6 +4,14 @@
 // ----------------
 // Implementation of the final processing.
 //
+// The LATENCY parameter selects the implementation. With LATENCY
+// zero the final processing is a ripple of 32-bit adds that is
+// given a fixed number of cycles to settle. With LATENCY one or
+// two, h + s and h + s + 5 are computed in parallel using carry
+// select adders and the result is selected based on the bits
+// above 2^130 in h + 5. The result is then available one or two
+// cycles after start.
+//
 // Copyright (c) 2020, Assured AB
 // Joachim Strömbergson
 //
@@ -36,7 +44,8 @@
 
 `default_nettype none
 
-module poly1305_final(
+module poly1305_final #(parameter LATENCY = 0)
+                     (
                       input wire          clk,
                       input wire          reset_n,
 
@@ -69,6 +78,7 @@ module poly1305_final(
 
   localparam CTRL_IDLE      = 2'h0;
   localparam CTRL_PIPE_WAIT = 2'h1;
+  localparam CTRL_SELECT    = 2'h2;
 
 
   //----------------------------------------------------------------
@@ -93,6 +103,37 @@ module poly1305_final(
   reg [63 : 0] uu2_new;
   reg [63 : 0] uu3_reg;
   reg [63 : 0] uu3_new;
+  reg          uu_we;
+
+  reg [32 : 0]  l0a_reg;
+  reg [32 : 0]  l0a_new;
+  reg [33 : 0]  l0b_reg;
+  reg [33 : 0]  l0b_new;
+  reg [33 : 0]  l1c0_reg;
+  reg [33 : 0]  l1c0_new;
+  reg [33 : 0]  l1c1_reg;
+  reg [33 : 0]  l1c1_new;
+  reg [33 : 0]  l1c2_reg;
+  reg [33 : 0]  l1c2_new;
+  reg [33 : 0]  l2c0_reg;
+  reg [33 : 0]  l2c0_new;
+  reg [33 : 0]  l2c1_reg;
+  reg [33 : 0]  l2c1_new;
+  reg [33 : 0]  l2c2_reg;
+  reg [33 : 0]  l2c2_new;
+  reg [33 : 0]  l3c0_reg;
+  reg [33 : 0]  l3c0_new;
+  reg [33 : 0]  l3c1_reg;
+  reg [33 : 0]  l3c1_new;
+  reg [33 : 0]  l3c2_reg;
+  reg [33 : 0]  l3c2_new;
+  reg           q_reg;
+  reg           q_new;
+  reg           lane_we;
+
+  reg [127 : 0] res_reg;
+  reg [127 : 0] res_new;
+  reg           res_we;
 
   reg [3 : 0]  cycle_ctr_reg;
   reg [3 : 0]  cycle_ctr_new;
@@ -114,10 +155,10 @@ module poly1305_final(
   //----------------------------------------------------------------
   assign ready = ready_reg;
 
-  assign hres0 = uu0_reg[31 : 0];
-  assign hres1 = uu1_reg[31 : 0];
-  assign hres2 = uu2_reg[31 : 0];
-  assign hres3 = uu3_reg[31 : 0];
+  assign hres0 = (LATENCY == 0) ? uu0_reg[31 : 0] : res_reg[031 : 000];
+  assign hres1 = (LATENCY == 0) ? uu1_reg[31 : 0] : res_reg[063 : 032];
+  assign hres2 = (LATENCY == 0) ? uu2_reg[31 : 0] : res_reg[095 : 064];
+  assign hres3 = (LATENCY == 0) ? uu3_reg[31 : 0] : res_reg[127 : 096];
 
 
   //----------------------------------------------------------------
@@ -126,6 +167,11 @@ module poly1305_final(
   // Update functionality for all registers in the core.
   // All registers are positive edge triggered with synchronous
   // active low reset.
+  //
+  // The u registers are only used with LATENCY zero. They must
+  // follow h also before start, since the core starts the final
+  // processing one cycle after h has been updated. The uu
+  // registers are only written from start until ready.
   //----------------------------------------------------------------
    always @ (posedge clk)
      begin : reg_update
@@ -140,22 +186,60 @@ module poly1305_final(
            uu1_reg       <= 64'h0;
            uu2_reg       <= 64'h0;
            uu3_reg       <= 64'h0;
+           l0a_reg       <= 33'h0;
+           l0b_reg       <= 34'h0;
+           l1c0_reg      <= 34'h0;
+           l1c1_reg      <= 34'h0;
+           l1c2_reg      <= 34'h0;
+           l2c0_reg      <= 34'h0;
+           l2c1_reg      <= 34'h0;
+           l2c2_reg      <= 34'h0;
+           l3c0_reg      <= 34'h0;
+           l3c1_reg      <= 34'h0;
+           l3c2_reg      <= 34'h0;
+           q_reg         <= 1'h0;
+           res_reg       <= 128'h0;
           cycle_ctr_reg  <= 4'h0;
           ready_reg      <= 1'h1;
           final_ctrl_reg <= CTRL_IDLE;
          end
        else
          begin
-           u0_reg  <= u0_new;
-           u1_reg  <= u1_new;
-           u2_reg  <= u2_new;
-           u3_reg  <= u3_new;
-           u4_reg  <= u4_new;
-
-           uu0_reg <= uu0_new;
-           uu1_reg <= uu1_new;
-           uu2_reg <= uu2_new;
-           uu3_reg <= uu3_new;
+           if (LATENCY == 0)
+             begin
+               u0_reg <= u0_new;
+               u1_reg <= u1_new;
+               u2_reg <= u2_new;
+               u3_reg <= u3_new;
+               u4_reg <= u4_new;
+             end
+
+           if (uu_we)
+             begin
+               uu0_reg <= uu0_new;
+               uu1_reg <= uu1_new;
+               uu2_reg <= uu2_new;
+               uu3_reg <= uu3_new;
+             end
+
+           if (lane_we)
+             begin
+               l0a_reg  <= l0a_new;
+               l0b_reg  <= l0b_new;
+               l1c0_reg <= l1c0_new;
+               l1c1_reg <= l1c1_new;
+               l1c2_reg <= l1c2_new;
+               l2c0_reg <= l2c0_new;
+               l2c1_reg <= l2c1_new;
+               l2c2_reg <= l2c2_new;
+               l3c0_reg <= l3c0_new;
+               l3c1_reg <= l3c1_new;
+               l3c2_reg <= l3c2_new;
+               q_reg    <= q_new;
+             end
+
+           if (res_we)
+             res_reg <= res_new;
 
            if (cycle_ctr_we)
              cycle_ctr_reg <= cycle_ctr_new;
@@ -187,6 +271,118 @@ module poly1305_final(
      end
 
 
+   //----------------------------------------------------------------
+   // lane_logic
+   //
+   // The 32-bit lane adds for the carry select adders. Lane zero
+   // computes h0 + s0 and h0 + s0 + 5. The other lanes compute
+   // hi + si with carry in 0, 1 and 2. A carry of two is possible
+   // in h + s + 5.
+   //
+   // q is set if h + 5 >= 2^130, i.e. if h >= 2^130 - 5.
+   // The pblock ensures that h4 <= 4 which means that q is
+   // at most one.
+   //----------------------------------------------------------------
+   always @*
+     begin : lane_logic
+       l0a_new  = {1'h0, h0} + {1'h0, s0};
+       l0b_new  = {2'h0, h0} + {2'h0, s0} + 34'h5;
+
+       l1c0_new = {2'h0, h1} + {2'h0, s1};
+       l1c1_new = {2'h0, h1} + {2'h0, s1} + 34'h1;
+       l1c2_new = {2'h0, h1} + {2'h0, s1} + 34'h2;
+
+       l2c0_new = {2'h0, h2} + {2'h0, s2};
+       l2c1_new = {2'h0, h2} + {2'h0, s2} + 34'h1;
+       l2c2_new = {2'h0, h2} + {2'h0, s2} + 34'h2;
+
+       l3c0_new = {2'h0, h3} + {2'h0, s3};
+       l3c1_new = {2'h0, h3} + {2'h0, s3} + 34'h1;
+       l3c2_new = {2'h0, h3} + {2'h0, s3} + 34'h2;
+
+       q_new = (h4[31 : 2] != 30'h0) ||
+               ((h4[1 : 0] == 2'h3) && (h0 > 32'hfffffffa) &&
+                (&h1) && (&h2) && (&h3));
+     end
+
+
+   //----------------------------------------------------------------
+   // select_logic
+   //
+   // Carry selection between the lanes and selection between
+   // h + s and h + s + 5. With LATENCY two the lane results are
+   // taken from the lane registers, otherwise directly from the
+   // lane adders.
+   //----------------------------------------------------------------
+   always @*
+     begin : select_logic
+       reg [32 : 0] l0a;
+       reg [33 : 0] l0b;
+       reg [33 : 0] l1c0;
+       reg [33 : 0] l1c1;
+       reg [33 : 0] l1c2;
+       reg [33 : 0] l2c0;
+       reg [33 : 0] l2c1;
+       reg [33 : 0] l2c2;
+       reg [33 : 0] l3c0;
+       reg [33 : 0] l3c1;
+       reg [33 : 0] l3c2;
+       reg          q;
+       reg [33 : 0] a1;
+       reg [33 : 0] a2;
+       reg [33 : 0] a3;
+       reg [33 : 0] b1;
+       reg [33 : 0] b2;
+       reg [33 : 0] b3;
+
+       if (LATENCY == 2)
+         begin
+           l0a  = l0a_reg;
+           l0b  = l0b_reg;
+           l1c0 = l1c0_reg;
+           l1c1 = l1c1_reg;
+           l1c2 = l1c2_reg;
+           l2c0 = l2c0_reg;
+           l2c1 = l2c1_reg;
+           l2c2 = l2c2_reg;
+           l3c0 = l3c0_reg;
+           l3c1 = l3c1_reg;
+           l3c2 = l3c2_reg;
+           q    = q_reg;
+         end
+       else
+         begin
+           l0a  = l0a_new;
+           l0b  = l0b_new;
+           l1c0 = l1c0_new;
+           l1c1 = l1c1_new;
+           l1c2 = l1c2_new;
+           l2c0 = l2c0_new;
+           l2c1 = l2c1_new;
+           l2c2 = l2c2_new;
+           l3c0 = l3c0_new;
+           l3c1 = l3c1_new;
+           l3c2 = l3c2_new;
+           q    = q_new;
+         end
+
+       // h + s
+       a1 = l0a[32] ? l1c1 : l1c0;
+       a2 = a1[32]  ? l2c1 : l2c0;
+       a3 = a2[32]  ? l3c1 : l3c0;
+
+       // h + s + 5
+       b1 = l0b[33] ? l1c2 : l0b[32] ? l1c1 : l1c0;
+       b2 = b1[33]  ? l2c2 : b1[32]  ? l2c1 : l2c0;
+       b3 = b2[33]  ? l3c2 : b2[32]  ? l3c1 : l3c0;
+
+       if (q)
+         res_new = {b3[31 : 0], b2[31 : 0], b1[31 : 0], l0b[31 : 0]};
+       else
+         res_new = {a3[31 : 0], a2[31 : 0], a1[31 : 0], l0a[31 : 0]};
+     end
+
+
   //----------------------------------------------------------------
   // cycle_ctr
   //----------------------------------------------------------------
@@ -215,6 +411,9 @@ module poly1305_final(
     begin : final_ctrl
       ready_new      = 1'h1;
       ready_we       = 1'h0;
+      uu_we          = 1'h0;
+      lane_we        = 1'h0;
+      res_we         = 1'h0;
       cycle_ctr_rst  = 1'h0;
       cycle_ctr_inc  = 1'h0;
       final_ctrl_new = CTRL_IDLE;
@@ -225,16 +424,35 @@ module poly1305_final(
           begin
             if (start)
               begin
-                ready_new      = 1'h0;
-                ready_we       = 1'h1;
-                cycle_ctr_rst  = 1'h1;
-                final_ctrl_new = CTRL_PIPE_WAIT;
-                final_ctrl_we  = 1'h1;
+                if (LATENCY == 0)
+                  begin
+                    uu_we          = 1'h1;
+                    ready_new      = 1'h0;
+                    ready_we       = 1'h1;
+                    cycle_ctr_rst  = 1'h1;
+                    final_ctrl_new = CTRL_PIPE_WAIT;
+                    final_ctrl_we  = 1'h1;
+                  end
+
+                // The result is registered directly and ready
+                // is kept set.
+                else if (LATENCY == 1)
+                  res_we = 1'h1;
+
+                else
+                  begin
+                    lane_we        = 1'h1;
+                    ready_new      = 1'h0;
+                    ready_we       = 1'h1;
+                    final_ctrl_new = CTRL_SELECT;
+                    final_ctrl_we  = 1'h1;
+                  end
               end
           end
 
         CTRL_PIPE_WAIT:
           begin
+            uu_we         = 1'h1;
             cycle_ctr_inc = 1'h1;
             if (cycle_ctr_reg == PIPE_CYCLES)
               begin
@@ -245,6 +463,15 @@ module poly1305_final(
               end
           end
 
+        CTRL_SELECT:
+          begin
+            res_we         = 1'h1;
+            ready_new      = 1'h1;
+            ready_we       = 1'h1;
+            final_ctrl_new = CTRL_IDLE;
+            final_ctrl_we  = 1'h1;
+          end
+
         default:
           begin
           end
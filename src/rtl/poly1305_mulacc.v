@@ -4,6 +4,10 @@
 // -----------------
 // Multiply-accumulate with five sets of operands.
 //
+// The OPB_WIDTH parameter sets the width of the b operands. The
+// products and the sum are 64 bits, and the operands must be
+// bounded such that the sum of the products fits in 64 bits.
+//
 //
 // Copyright (c) 2020, Assured AB
 // Joachim Strömbergson
@@ -37,29 +41,30 @@
 
 `default_nettype none
 
-module poly1305_mulacc(
-                       input wire           clk,
-                       input wire           reset_n,
+module poly1305_mulacc #(parameter OPB_WIDTH = 64)
+                      (
+                       input wire                        clk,
+                       input wire                        reset_n,
 
-                       input wire           start,
-                       output wire          ready,
+                       input wire                        start,
+                       output wire                       ready,
 
-                       input wire [31 : 0]  opa0,
-                       input wire [63 : 0]  opb0,
+                       input wire [31 : 0]               opa0,
+                       input wire [(OPB_WIDTH - 1) : 0]  opb0,
 
-                       input wire [31 : 0]  opa1,
-                       input wire [63 : 0]  opb1,
+                       input wire [31 : 0]               opa1,
+                       input wire [(OPB_WIDTH - 1) : 0]  opb1,
 
-                       input wire [31 : 0]  opa2,
-                       input wire [63 : 0]  opb2,
+                       input wire [31 : 0]               opa2,
+                       input wire [(OPB_WIDTH - 1) : 0]  opb2,
 
-                       input wire [31 : 0]  opa3,
-                       input wire [63 : 0]  opb3,
+                       input wire [31 : 0]               opa3,
+                       input wire [(OPB_WIDTH - 1) : 0]  opb3,
 
-                       input wire [31 : 0]  opa4,
-                       input wire [63 : 0]  opb4,
+                       input wire [31 : 0]               opa4,
+                       input wire [(OPB_WIDTH - 1) : 0]  opb4,
 
-                       output wire [63 : 0] sum
+                       output wire [63 : 0]              sum
                       );
 
 
@@ -148,11 +153,11 @@ module poly1305_mulacc(
   //----------------------------------------------------------------
   always @*
     begin : mulacc_logic
-      reg [31 : 0] mul_opa;
-      reg [63 : 0] mul_opb;
+      reg [31 : 0]              mul_opa;
+      reg [(OPB_WIDTH - 1) : 0] mul_opb;
 
       mul_opa = 32'h0;
-      mul_opb = 64'h0;
+      mul_opb = {OPB_WIDTH{1'h0}};
       mul_new = 64'h0;
       mul_we  = 1'h0;
       sum_new = 64'h0;
@@ -196,6 +201,15 @@ module poly1305_mulacc(
       endcase // case (mulop_select)
 
 
+      // The multiplier operands are held at zero when the
+      // multiplier result is not used.
+      if (!update_mul)
+        begin
+          mul_opa = 32'h0;
+          mul_opb = {OPB_WIDTH{1'h0}};
+        end
+
+
       if (update_mul)
         begin
           mul_new = mul_opa * mul_opb;
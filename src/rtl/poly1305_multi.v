@@ -0,0 +1,591 @@
+//======================================================================
+//
+// poly1305_multi.v
+// ----------------
+// Multi core version of Poly1305 with a stream job interface.
+// Each job (message) is assigned to one of NUM_CORES cores, and
+// the tags are returned in job order or identified by the job ID.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_multi #(parameter NUM_CORES      = 4,
+                        parameter ID_BITS        = 8,
+                        parameter IN_ORDER       = 1,
+                        parameter FIFO_ADDR_BITS = 2,
+                        parameter LOW_LATENCY    = 0,
+                        parameter FINAL_LATENCY  = 0,
+                        parameter HIGH_FMAX      = 0,
+                        parameter PIPE_DEPTH     = 9)
+                      (
+                       input wire                     clk,
+                       input wire                     reset_n,
+
+                       input wire [255 : 0]           key,
+
+                       input wire [127 : 0]           s_axis_tdata,
+                       input wire [15 : 0]            s_axis_tkeep,
+                       input wire [(ID_BITS - 1) : 0] s_axis_tid,
+                       input wire                     s_axis_tlast,
+                       input wire                     s_axis_tvalid,
+                       output wire                    s_axis_tready,
+
+                       output wire [127 : 0]           m_axis_tdata,
+                       output wire [(ID_BITS - 1) : 0] m_axis_tid,
+                       output wire                     m_axis_tvalid,
+                       input wire                      m_axis_tready
+                      );
+
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam FIFO_DEPTH     = (1 << FIFO_ADDR_BITS);
+
+  localparam CTRL_IDLE      = 1'h0;
+  localparam CTRL_DATA      = 1'h1;
+
+  localparam LANE_IDLE      = 2'h0;
+  localparam LANE_DATA      = 2'h1;
+  localparam LANE_TAG_WAIT  = 2'h2;
+  localparam LANE_DONE      = 2'h3;
+
+
+  //----------------------------------------------------------------
+  // Internal functions.
+  //----------------------------------------------------------------
+  // The first byte in a stream beat is in the least significant
+  // byte lane. The core expects the first byte in the most
+  // significant byte of the block and mac.
+  function [127 : 0] bswap(input [127 : 0] w);
+    integer i;
+    begin
+      for (i = 0 ; i < 16 ; i = i + 1)
+        bswap[(15 - i) * 8 +: 8] = w[i * 8 +: 8];
+    end
+  endfunction // bswap
+
+  // The number of valid bytes in a beat. Note that
+  // keep is expected to be contiguous from byte lane zero.
+  function [4 : 0] keep_len(input [15 : 0] keep);
+    integer i;
+    begin
+      keep_len = 5'h0;
+      for (i = 0 ; i < 16 ; i = i + 1)
+        keep_len = keep_len + keep[i];
+    end
+  endfunction // keep_len
+
+  // Lane indices wrap around at NUM_CORES, which
+  // does not have to be a power of two.
+  function [7 : 0] lane_inc(input [7 : 0] lane);
+    begin
+      if (lane == (NUM_CORES - 1))
+        lane_inc = 8'h0;
+      else
+        lane_inc = lane + 1'h1;
+    end
+  endfunction // lane_inc
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [7 : 0]             in_lane_reg;
+  reg [7 : 0]             in_lane_new;
+  reg                     in_lane_we;
+
+  reg [7 : 0]             rr_lane_reg;
+  reg [7 : 0]             rr_lane_new;
+  reg                     rr_lane_we;
+
+  reg                     in_ctrl_reg;
+  reg                     in_ctrl_new;
+  reg                     in_ctrl_we;
+
+  reg [7 : 0]             ord_mem [0 : (NUM_CORES - 1)];
+  reg [7 : 0]             ord_wr_ptr_reg;
+  reg [7 : 0]             ord_rd_ptr_reg;
+  reg [7 : 0]             ord_ctr_reg;
+  reg [7 : 0]             ord_ctr_new;
+  reg                     ord_push;
+  reg                     ord_pop;
+
+  reg [7 : 0]             out_lane_reg;
+  reg [7 : 0]             out_lane_new;
+  reg                     out_lane_we;
+
+  reg [127 : 0]           tag_reg;
+  reg [(ID_BITS - 1) : 0] tid_reg;
+  reg                     tag_we;
+
+  reg                     tag_valid_reg;
+  reg                     tag_valid_new;
+  reg                     tag_valid_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg [(NUM_CORES - 1) : 0]             lane_start;
+  reg [(NUM_CORES - 1) : 0]             lane_push;
+  reg [(NUM_CORES - 1) : 0]             lane_ack;
+  wire [(NUM_CORES - 1) : 0]            lane_free;
+  wire [(NUM_CORES - 1) : 0]            lane_full;
+  wire [(NUM_CORES - 1) : 0]            lane_done;
+  wire [(NUM_CORES * 128 - 1) : 0]      lane_tag;
+  wire [(NUM_CORES * ID_BITS - 1) : 0]  lane_id;
+
+  wire [127 : 0]                        in_block;
+  wire [4 : 0]                          in_blocklen;
+
+  reg [7 : 0]                           ack_lane;
+
+  reg                                   tmp_s_axis_tready;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign s_axis_tready = tmp_s_axis_tready;
+
+  assign m_axis_tdata  = tag_reg;
+  assign m_axis_tid    = tid_reg;
+  assign m_axis_tvalid = tag_valid_reg;
+
+  assign in_block      = bswap(s_axis_tdata);
+  assign in_blocklen   = s_axis_tlast ? keep_len(s_axis_tkeep) : 5'h10;
+
+
+  //----------------------------------------------------------------
+  // Lanes. Each lane has a core, a block FIFO and the ID of the
+  // job being processed. The FIFO allows the message stream to
+  // move on to the next job while the core processes the blocks.
+  //----------------------------------------------------------------
+  genvar l;
+  generate
+    for (l = 0 ; l < NUM_CORES ; l = l + 1)
+      begin : lane_gen
+        reg [127 : 0]                  block_mem [0 : (FIFO_DEPTH - 1)];
+        reg [4 : 0]                    len_mem [0 : (FIFO_DEPTH - 1)];
+        reg                            last_mem [0 : (FIFO_DEPTH - 1)];
+        reg [(FIFO_ADDR_BITS - 1) : 0] wr_ptr_reg;
+        reg [(FIFO_ADDR_BITS - 1) : 0] rd_ptr_reg;
+        reg [FIFO_ADDR_BITS : 0]       ctr_reg;
+        reg [FIFO_ADDR_BITS : 0]       ctr_new;
+
+        reg [(ID_BITS - 1) : 0]        id_reg;
+
+        reg [1 : 0]                    lane_ctrl_reg;
+        reg [1 : 0]                    lane_ctrl_new;
+        reg                            lane_ctrl_we;
+
+        reg                            pop;
+        reg                            core_next;
+        wire                           core_ready;
+        wire [127 : 0]                 core_mac;
+
+
+        assign lane_free[l] = (lane_ctrl_reg == LANE_IDLE);
+        assign lane_full[l] = (ctr_reg == FIFO_DEPTH);
+        assign lane_done[l] = (lane_ctrl_reg == LANE_DONE);
+        assign lane_tag[(l * 128) +: 128]        = core_mac;
+        assign lane_id[(l * ID_BITS) +: ID_BITS] = id_reg;
+
+
+        poly1305_core #(.LOW_LATENCY(LOW_LATENCY),
+                        .FINAL_LATENCY(FINAL_LATENCY),
+                        .HIGH_FMAX(HIGH_FMAX),
+                        .PIPE_DEPTH(PIPE_DEPTH))
+                      core(
+                           .clk(clk),
+                           .reset_n(reset_n),
+                           .init(lane_start[l]),
+                           .next(core_next),
+                           .last(last_mem[rd_ptr_reg]),
+                           .finish(1'h0),
+                           .restore(1'h0),
+                           .ready(core_ready),
+                           .pblock_busy(),
+                           .final_busy(),
+                           .key(key),
+                           .chain(1'h0),
+                           .chain_key(256'h0),
+                           .block(block_mem[rd_ptr_reg]),
+                           .blocklen(len_mem[rd_ptr_reg]),
+                           .ctx_in(416'h0),
+                           .ctx(),
+                           .mac(core_mac)
+                          );
+
+
+        always @ (posedge clk)
+          begin : lane_reg_update
+            integer i;
+
+            if (!reset_n)
+              begin
+                for (i = 0 ; i < FIFO_DEPTH ; i = i + 1)
+                  begin
+                    block_mem[i] <= 128'h0;
+                    len_mem[i]   <= 5'h0;
+                    last_mem[i]  <= 1'h0;
+                  end
+
+                wr_ptr_reg    <= {FIFO_ADDR_BITS{1'h0}};
+                rd_ptr_reg    <= {FIFO_ADDR_BITS{1'h0}};
+                ctr_reg       <= {(FIFO_ADDR_BITS + 1){1'h0}};
+                id_reg        <= {ID_BITS{1'h0}};
+                lane_ctrl_reg <= LANE_IDLE;
+              end
+            else
+              begin
+                ctr_reg <= ctr_new;
+
+                if (lane_start[l])
+                  id_reg <= s_axis_tid;
+
+                if (lane_push[l])
+                  begin
+                    block_mem[wr_ptr_reg] <= in_block;
+                    len_mem[wr_ptr_reg]   <= in_blocklen;
+                    last_mem[wr_ptr_reg]  <= s_axis_tlast;
+                    wr_ptr_reg            <= wr_ptr_reg + 1'h1;
+                  end
+
+                if (pop)
+                  rd_ptr_reg <= rd_ptr_reg + 1'h1;
+
+                if (lane_ctrl_we)
+                  lane_ctrl_reg <= lane_ctrl_new;
+              end
+          end // lane_reg_update
+
+
+        //----------------------------------------------------------
+        // lane_ctrl
+        //
+        // The core is initialized when the job is started. The
+        // blocks are then processed as soon as they are in the
+        // FIFO and the core is ready. The final block is
+        // processed with last set. The tag is held in the core
+        // until it has been collected by the output logic.
+        //----------------------------------------------------------
+        always @*
+          begin : lane_ctrl
+            pop           = 1'h0;
+            core_next     = 1'h0;
+            ctr_new       = ctr_reg;
+            lane_ctrl_new = LANE_IDLE;
+            lane_ctrl_we  = 1'h0;
+
+            case (lane_ctrl_reg)
+              LANE_IDLE:
+                begin
+                  if (lane_start[l])
+                    begin
+                      lane_ctrl_new = LANE_DATA;
+                      lane_ctrl_we  = 1'h1;
+                    end
+                end
+
+              LANE_DATA:
+                begin
+                  if ((ctr_reg > 0) && core_ready)
+                    begin
+                      pop       = 1'h1;
+                      core_next = 1'h1;
+
+                      if (last_mem[rd_ptr_reg])
+                        begin
+                          lane_ctrl_new = LANE_TAG_WAIT;
+                          lane_ctrl_we  = 1'h1;
+                        end
+                    end
+                end
+
+              LANE_TAG_WAIT:
+                begin
+                  if (core_ready)
+                    begin
+                      lane_ctrl_new = LANE_DONE;
+                      lane_ctrl_we  = 1'h1;
+                    end
+                end
+
+              LANE_DONE:
+                begin
+                  if (lane_ack[l])
+                    begin
+                      lane_ctrl_new = LANE_IDLE;
+                      lane_ctrl_we  = 1'h1;
+                    end
+                end
+
+              default:
+                begin
+                end
+            endcase // case (lane_ctrl_reg)
+
+            if (lane_push[l] && !pop)
+              ctr_new = ctr_reg + 1'h1;
+
+            if (!lane_push[l] && pop)
+              ctr_new = ctr_reg - 1'h1;
+          end // lane_ctrl
+      end // lane_gen
+  endgenerate
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with synchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      integer i;
+
+      if (!reset_n)
+        begin
+          for (i = 0 ; i < NUM_CORES ; i = i + 1)
+            ord_mem[i] <= 8'h0;
+
+          in_lane_reg    <= 8'h0;
+          rr_lane_reg    <= 8'h0;
+          in_ctrl_reg    <= CTRL_IDLE;
+          ord_wr_ptr_reg <= 8'h0;
+          ord_rd_ptr_reg <= 8'h0;
+          ord_ctr_reg    <= 8'h0;
+          out_lane_reg   <= 8'h0;
+          tag_reg        <= 128'h0;
+          tid_reg        <= {ID_BITS{1'h0}};
+          tag_valid_reg  <= 1'h0;
+        end
+      else
+        begin
+          ord_ctr_reg <= ord_ctr_new;
+
+          if (in_lane_we)
+            in_lane_reg <= in_lane_new;
+
+          if (rr_lane_we)
+            rr_lane_reg <= rr_lane_new;
+
+          if (in_ctrl_we)
+            in_ctrl_reg <= in_ctrl_new;
+
+          if (ord_push)
+            begin
+              ord_mem[ord_wr_ptr_reg] <= in_lane_new;
+              ord_wr_ptr_reg          <= lane_inc(ord_wr_ptr_reg);
+            end
+
+          if (ord_pop)
+            ord_rd_ptr_reg <= lane_inc(ord_rd_ptr_reg);
+
+          if (out_lane_we)
+            out_lane_reg <= out_lane_new;
+
+          if (tag_we)
+            begin
+              tag_reg <= bswap(lane_tag[(ack_lane * 128) +: 128]);
+              tid_reg <= lane_id[(ack_lane * ID_BITS) +: ID_BITS];
+            end
+
+          if (tag_valid_we)
+            tag_valid_reg <= tag_valid_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // dispatch
+  //
+  // The first beat of a job is assigned to the first free lane,
+  // searching round robin from the lane after the lane used for
+  // the previous job. The core in the lane is initialized using
+  // the key and the beats of the job are then pushed into the
+  // FIFO of the lane. In order mode the lane is also recorded
+  // in the order queue.
+  //----------------------------------------------------------------
+  always @*
+    begin : dispatch
+      integer i;
+      reg [7 : 0] lane;
+      reg         found;
+
+      lane_start        = {NUM_CORES{1'h0}};
+      lane_push         = {NUM_CORES{1'h0}};
+      tmp_s_axis_tready = 1'h0;
+      ord_push          = 1'h0;
+      in_lane_new       = 8'h0;
+      in_lane_we        = 1'h0;
+      rr_lane_new       = 8'h0;
+      rr_lane_we        = 1'h0;
+      in_ctrl_new       = CTRL_IDLE;
+      in_ctrl_we        = 1'h0;
+
+      found = 1'h0;
+      lane  = rr_lane_reg;
+      for (i = 0 ; i < NUM_CORES ; i = i + 1)
+        begin
+          if (!found && lane_free[lane])
+            begin
+              found       = 1'h1;
+              in_lane_new = lane;
+            end
+          lane = lane_inc(lane);
+        end
+
+      case (in_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            tmp_s_axis_tready = found;
+
+            if (s_axis_tvalid && found)
+              begin
+                lane_start[in_lane_new] = 1'h1;
+                lane_push[in_lane_new]  = 1'h1;
+                ord_push                = (IN_ORDER != 0);
+                in_lane_we              = 1'h1;
+                rr_lane_new             = lane_inc(in_lane_new);
+                rr_lane_we              = 1'h1;
+
+                if (!s_axis_tlast)
+                  begin
+                    in_ctrl_new = CTRL_DATA;
+                    in_ctrl_we  = 1'h1;
+                  end
+              end
+          end
+
+        CTRL_DATA:
+          begin
+            tmp_s_axis_tready = !lane_full[in_lane_reg];
+
+            if (s_axis_tvalid && !lane_full[in_lane_reg])
+              begin
+                lane_push[in_lane_reg] = 1'h1;
+
+                if (s_axis_tlast)
+                  begin
+                    in_ctrl_new = CTRL_IDLE;
+                    in_ctrl_we  = 1'h1;
+                  end
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (in_ctrl_reg)
+    end // dispatch
+
+
+  //----------------------------------------------------------------
+  // collect
+  //
+  // Moves a tag from a lane to the tag stream when the tag
+  // register is free or being accepted. In order mode the tag
+  // is taken from the lane at the head of the order queue.
+  // Otherwise the first lane with a tag is taken, searching
+  // round robin, and the tag is identified by the job ID.
+  //----------------------------------------------------------------
+  always @*
+    begin : collect
+      integer i;
+      reg [7 : 0] lane;
+      reg         found;
+
+      lane_ack      = {NUM_CORES{1'h0}};
+      ord_pop       = 1'h0;
+      ord_ctr_new   = ord_ctr_reg;
+      out_lane_new  = 8'h0;
+      out_lane_we   = 1'h0;
+      tag_we        = 1'h0;
+      tag_valid_new = 1'h0;
+      tag_valid_we  = 1'h0;
+
+      found    = 1'h0;
+      ack_lane = 8'h0;
+      if (IN_ORDER)
+        begin
+          ack_lane = ord_mem[ord_rd_ptr_reg];
+          found    = (ord_ctr_reg > 0) && lane_done[ack_lane];
+        end
+      else
+        begin
+          lane = out_lane_reg;
+          for (i = 0 ; i < NUM_CORES ; i = i + 1)
+            begin
+              if (!found && lane_done[lane])
+                begin
+                  found    = 1'h1;
+                  ack_lane = lane;
+                end
+              lane = lane_inc(lane);
+            end
+        end
+
+      if (m_axis_tready && tag_valid_reg)
+        begin
+          tag_valid_new = 1'h0;
+          tag_valid_we  = 1'h1;
+        end
+
+      if (found && (!tag_valid_reg || m_axis_tready))
+        begin
+          lane_ack[ack_lane] = 1'h1;
+          tag_we             = 1'h1;
+          tag_valid_new      = 1'h1;
+          tag_valid_we       = 1'h1;
+          ord_pop            = (IN_ORDER != 0);
+          out_lane_new       = lane_inc(ack_lane);
+          out_lane_we        = 1'h1;
+        end
+
+      if (ord_push && !ord_pop)
+        ord_ctr_new = ord_ctr_reg + 1'h1;
+
+      if (!ord_push && ord_pop)
+        ord_ctr_new = ord_ctr_reg - 1'h1;
+    end // collect
+
+endmodule // poly1305_multi
+
+//======================================================================
+// EOF poly1305_multi.v
+//======================================================================
@@ -0,0 +1,286 @@
+//======================================================================
+//
+// poly1305_packer.v
+// -----------------
+// Byte granular input packer for the Poly1305 core. Packs message
+// fragments of zero to four bytes into blocks for the core. Used
+// in front of the block FIFO in the top level wrapper.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_packer(
+                       input wire            clk,
+                       input wire            reset_n,
+
+                       input wire [31 : 0]   data,
+                       input wire [2 : 0]    len,
+                       input wire            last,
+                       input wire            valid,
+                       output wire           ready,
+
+                       input wire            lastlen_we,
+                       input wire [4 : 0]    lastlen,
+                       input wire            flush,
+                       output wire           busy,
+
+                       output wire           core_next,
+                       output wire           core_last,
+                       output wire [127 : 0] core_block,
+                       output wire [4 : 0]   core_blocklen,
+                       input wire            core_ready
+                      );
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [159 : 0] acc_reg;
+  reg [159 : 0] acc_new;
+  reg           acc_we;
+
+  reg [4 : 0]   cnt_reg;
+  reg [4 : 0]   cnt_new;
+  reg           cnt_we;
+
+  reg           last_pending_reg;
+  reg           last_pending_new;
+  reg           last_pending_we;
+
+  reg           flush_pending_reg;
+  reg           flush_pending_new;
+  reg           flush_pending_we;
+
+  reg [127 : 0] block_reg;
+  reg [4 : 0]   blocklen_reg;
+  reg           block_last_reg;
+  reg           block_we;
+
+  reg           block_valid_reg;
+  reg           block_valid_new;
+  reg           block_valid_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  reg tmp_ready;
+  reg tmp_core_next;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign ready         = tmp_ready;
+  assign busy          = block_valid_reg || last_pending_reg ||
+                         flush_pending_reg || (cnt_reg > 5'h10);
+
+  assign core_next     = tmp_core_next;
+  assign core_last     = block_last_reg;
+  assign core_block    = block_reg;
+  assign core_blocklen = blocklen_reg;
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with synchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          acc_reg           <= 160'h0;
+          cnt_reg           <= 5'h0;
+          last_pending_reg  <= 1'h0;
+          flush_pending_reg <= 1'h0;
+          block_reg         <= 128'h0;
+          blocklen_reg      <= 5'h0;
+          block_last_reg    <= 1'h0;
+          block_valid_reg   <= 1'h0;
+        end
+      else
+        begin
+          if (acc_we)
+            acc_reg <= acc_new;
+
+          if (cnt_we)
+            cnt_reg <= cnt_new;
+
+          if (last_pending_we)
+            last_pending_reg <= last_pending_new;
+
+          if (flush_pending_we)
+            flush_pending_reg <= flush_pending_new;
+
+          if (block_we)
+            begin
+              block_reg      <= acc_reg[159 : 32];
+              blocklen_reg   <= (cnt_reg > 5'h10) ? 5'h10 : cnt_reg;
+              block_last_reg <= last_pending_reg && (cnt_reg <= 5'h10);
+            end
+
+          if (block_valid_we)
+            block_valid_reg <= block_valid_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // packer_logic
+  //
+  // The accumulator holds up to 20 bytes, with the first byte
+  // in the most significant byte. A full block is only moved to
+  // the block register when more bytes have been received, or
+  // when the end of the message is known. This allows the final
+  // block to always be processed with last set. A message ending
+  // on a block boundary is thus not followed by a separate final
+  // operation. The message must be ended with last, possibly
+  // with zero valid bytes.
+  //
+  // The block register is also free in the cycle where its block
+  // is passed to the core, and input words are accepted when the
+  // accumulator holds at most 16 bytes after any block move in
+  // the same cycle. This allows one word to be accepted every
+  // cycle as long as the core can take the blocks.
+  //
+  // If lastlen_we is set together with last, the number of bytes
+  // in the final block is set to lastlen, where zero means that
+  // the message ends on a block boundary. This allows words with
+  // padding bytes to be used for the final block. A flush moves
+  // a held full block to the block register without last, so
+  // that all bytes received have been passed to the core when
+  // busy is cleared.
+  //----------------------------------------------------------------
+  always @*
+    begin : packer_logic
+      reg [31 : 0]  masked_data;
+      reg [159 : 0] acc_base;
+      reg [4 : 0]   cnt_base;
+      reg           last_base;
+      reg           block_free;
+
+      acc_new           = 160'h0;
+      acc_we            = 1'h0;
+      cnt_new           = 5'h0;
+      cnt_we            = 1'h0;
+      last_pending_new  = 1'h0;
+      last_pending_we   = 1'h0;
+      flush_pending_new = 1'h0;
+      flush_pending_we  = 1'h0;
+      block_we          = 1'h0;
+      block_valid_new   = 1'h0;
+      block_valid_we    = 1'h0;
+      tmp_core_next     = 1'h0;
+
+      masked_data = data & ~(32'hffffffff >> (len * 8));
+
+      if (block_valid_reg && core_ready)
+        begin
+          tmp_core_next   = 1'h1;
+          block_valid_new = 1'h0;
+          block_valid_we  = 1'h1;
+        end
+
+      block_free = !block_valid_reg || core_ready;
+      acc_base   = acc_reg;
+      cnt_base   = cnt_reg;
+      last_base  = last_pending_reg;
+
+      if (flush)
+        begin
+          flush_pending_new = 1'h1;
+          flush_pending_we  = 1'h1;
+        end
+
+      if (block_free)
+        begin
+          if ((cnt_reg > 5'h10) ||
+              (flush_pending_reg && !last_pending_reg && (cnt_reg == 5'h10)))
+            begin
+              block_we        = 1'h1;
+              block_valid_new = 1'h1;
+              block_valid_we  = 1'h1;
+              acc_base        = {acc_reg[31 : 0], 128'h0};
+              cnt_base        = cnt_reg - 5'h10;
+            end
+          else if (last_pending_reg)
+            begin
+              block_we        = 1'h1;
+              block_valid_new = 1'h1;
+              block_valid_we  = 1'h1;
+              acc_base        = 160'h0;
+              cnt_base        = 5'h0;
+              last_base       = 1'h0;
+            end
+
+          // A flush is completed when no full block is held.
+          if (flush_pending_reg && !flush && (cnt_reg <= 5'h10))
+            begin
+              flush_pending_new = 1'h0;
+              flush_pending_we  = 1'h1;
+            end
+        end
+
+      tmp_ready = (cnt_base <= 5'h10) && !last_base;
+
+      acc_new          = acc_base;
+      cnt_new          = cnt_base;
+      last_pending_new = last_base;
+
+      if (valid && tmp_ready)
+        begin
+          acc_new = acc_base | ({masked_data, 128'h0} >> (cnt_base * 8));
+          cnt_new = cnt_base + len;
+
+          if (last)
+            begin
+              last_pending_new = 1'h1;
+
+              if (lastlen_we)
+                cnt_new = (lastlen == 5'h0) ? (cnt_new & 5'h10) : lastlen;
+            end
+        end
+
+      acc_we          = block_we || (valid && tmp_ready);
+      cnt_we          = acc_we;
+      last_pending_we = acc_we;
+    end // packer_logic
+
+endmodule // poly1305_packer
+
+//======================================================================
+// EOF poly1305_packer.v
+//======================================================================
@@ -72,7 +72,7 @@ module poly1305_pblock(
   // Parameters and symbolic values.
   //----------------------------------------------------------------
   localparam PRE_CYCLES  = 4'h1;
-  localparam POST_CYCLES = 4'h2;
+  localparam POST_CYCLES = 4'h4;
 
   localparam CTRL_IDLE      = 4'h0;
   localparam CTRL_PRE_WAIT  = 4'h1;
@@ -83,29 +83,29 @@ module poly1305_pblock(
   //----------------------------------------------------------------
   // Registers (Variables)
   //----------------------------------------------------------------
-  reg [63 : 0] u0_reg;
-  reg [63 : 0] u0_new;
-  reg [63 : 0] u1_reg;
-  reg [63 : 0] u1_new;
-  reg [63 : 0] u2_reg;
-  reg [63 : 0] u2_new;
-  reg [63 : 0] u3_reg;
-  reg [63 : 0] u3_new;
-  reg [31 : 0] u4_reg;
-  reg [31 : 0] u4_new;
-  reg [63 : 0] u5_reg;
-  reg [63 : 0] u5_new;
-
-  reg [63 : 0] s0_reg;
-  reg [63 : 0] s0_new;
-  reg [63 : 0] s1_reg;
-  reg [63 : 0] s1_new;
-  reg [63 : 0] s2_reg;
-  reg [63 : 0] s2_new;
-  reg [63 : 0] s3_reg;
-  reg [63 : 0] s3_new;
-  reg [63 : 0] s4_reg;
-  reg [63 : 0] s4_new;
+  reg [32 : 0] u0_reg;
+  reg [32 : 0] u0_new;
+  reg [32 : 0] u1_reg;
+  reg [32 : 0] u1_new;
+  reg [32 : 0] u2_reg;
+  reg [32 : 0] u2_new;
+  reg [32 : 0] u3_reg;
+  reg [32 : 0] u3_new;
+  reg [2 : 0]  u4_reg;
+  reg [2 : 0]  u4_new;
+  reg [31 : 0] u5_reg;
+  reg [31 : 0] u5_new;
+
+  reg [32 : 0] s0_reg;
+  reg [32 : 0] s0_new;
+  reg [32 : 0] s1_reg;
+  reg [32 : 0] s1_new;
+  reg [32 : 0] s2_reg;
+  reg [32 : 0] s2_new;
+  reg [32 : 0] s3_reg;
+  reg [32 : 0] s3_new;
+  reg [2 : 0]  s4_reg;
+  reg [2 : 0]  s4_new;
 
   reg [31 : 0] rr0_reg;
   reg [31 : 0] rr0_new;
@@ -120,8 +120,8 @@ module poly1305_pblock(
   wire [63 : 0] x1_new;
   wire [63 : 0] x2_new;
   wire [63 : 0] x3_new;
-  reg [63 : 0]  x4_reg;
-  reg [63 : 0]  x4_new;
+  reg [3 : 0]   x4_reg;
+  reg [3 : 0]   x4_new;
 
   reg [3 : 0]   cycle_ctr_reg;
   reg [3 : 0]   cycle_ctr_new;
@@ -142,6 +142,9 @@ module poly1305_pblock(
   // Wires.
   //----------------------------------------------------------------
   reg  mulacc_start;
+  reg  operand_we;
+  reg  x4_we;
+  reg  u_we;
   wire mulacc0_ready;
   wire mulacc1_ready;
   wire mulacc2_ready;
@@ -157,13 +160,14 @@ module poly1305_pblock(
   assign h1_new  = u1_reg[31 : 0];
   assign h2_new  = u2_reg[31 : 0];
   assign h3_new  = u3_reg[31 : 0];
-  assign h4_new  = u4_reg;
+  assign h4_new  = {29'h0, u4_reg};
 
 
   //----------------------------------------------------------------
   // mulacc instances.
   //----------------------------------------------------------------
-  poly1305_mulacc mulacc0(
+  poly1305_mulacc #(.OPB_WIDTH(33))
+                  mulacc0(
                           .clk(clk),
                           .reset_n(reset_n),
                           .start(mulacc_start),
@@ -177,11 +181,12 @@ module poly1305_pblock(
                           .opa3(rr1_reg),
                           .opb3(s3_reg),
                           .opa4(rr0_reg),
-                          .opb4(s4_reg),
+                          .opb4({30'h0, s4_reg}),
                           .sum(x0_new)
                           );
 
-  poly1305_mulacc mulacc1(
+  poly1305_mulacc #(.OPB_WIDTH(33))
+                  mulacc1(
                           .clk(clk),
                           .reset_n(reset_n),
                           .start(mulacc_start),
@@ -195,11 +200,12 @@ module poly1305_pblock(
                           .opa3(rr2_reg),
                           .opb3(s3_reg),
                           .opa4(rr1_reg),
-                          .opb4(s4_reg),
+                          .opb4({30'h0, s4_reg}),
                           .sum(x1_new)
                           );
 
-  poly1305_mulacc mulacc2(
+  poly1305_mulacc #(.OPB_WIDTH(33))
+                  mulacc2(
                           .clk(clk),
                           .reset_n(reset_n),
                           .start(mulacc_start),
@@ -213,11 +219,12 @@ module poly1305_pblock(
                           .opa3(rr3_reg),
                           .opb3(s3_reg),
                           .opa4(rr2_reg),
-                          .opb4(s4_reg),
+                          .opb4({30'h0, s4_reg}),
                           .sum(x2_new)
                           );
 
-  poly1305_mulacc mulacc3(
+  poly1305_mulacc #(.OPB_WIDTH(33))
+                  mulacc3(
                           .clk(clk),
                           .reset_n(reset_n),
                           .start(mulacc_start),
@@ -231,7 +238,7 @@ module poly1305_pblock(
                           .opa3(r0),
                           .opb3(s3_reg),
                           .opa4(rr3_reg),
-                          .opb4(s4_reg),
+                          .opb4({30'h0, s4_reg}),
                           .sum(x3_new)
                           );
 
@@ -242,52 +249,63 @@ module poly1305_pblock(
   // Update functionality for all registers in the core.
   // All registers are positive edge triggered with synchronous
   // active low reset.
+  //
+  // The datapath registers are only written in the cycles where
+  // their values are used, as controlled by pblock_ctrl. When
+  // idle the registers, and the mulacc operands, are stable.
   //----------------------------------------------------------------
   always @ (posedge clk)
     begin : reg_update
       if (!reset_n)
         begin
-          s0_reg          <= 64'h0;
-          s1_reg          <= 64'h0;
-          s2_reg          <= 64'h0;
-          s3_reg          <= 64'h0;
-          s4_reg          <= 64'h0;
+          s0_reg          <= 33'h0;
+          s1_reg          <= 33'h0;
+          s2_reg          <= 33'h0;
+          s3_reg          <= 33'h0;
+          s4_reg          <= 3'h0;
           rr0_reg         <= 32'h0;
           rr1_reg         <= 32'h0;
           rr2_reg         <= 32'h0;
           rr3_reg         <= 32'h0;
-          x4_reg          <= 64'h0;
-          u0_reg          <= 64'h0;
-          u1_reg          <= 64'h0;
-          u2_reg          <= 64'h0;
-          u3_reg          <= 64'h0;
-          u4_reg          <= 32'h0;
-          u5_reg          <= 64'h0;
+          x4_reg          <= 4'h0;
+          u0_reg          <= 33'h0;
+          u1_reg          <= 33'h0;
+          u2_reg          <= 33'h0;
+          u3_reg          <= 33'h0;
+          u4_reg          <= 3'h0;
+          u5_reg          <= 32'h0;
           cycle_ctr_reg   <= 4'h0;
           ready_reg       <= 1'h1;
           pblock_ctrl_reg <= CTRL_IDLE;
         end
       else
         begin
-          s0_reg  <= s0_new;
-          s1_reg  <= s1_new;
-          s2_reg  <= s2_new;
-          s3_reg  <= s3_new;
-          s4_reg  <= s4_new;
-
-          rr0_reg <= rr0_new;
-          rr1_reg <= rr1_new;
-          rr2_reg <= rr2_new;
-          rr3_reg <= rr3_new;
-
-          x4_reg  <= x4_new;
-
-          u0_reg  <= u0_new;
-          u1_reg  <= u1_new;
-          u2_reg  <= u2_new;
-          u3_reg  <= u3_new;
-          u4_reg  <= u4_new;
-          u5_reg  <= u5_new;
+          if (operand_we)
+            begin
+              s0_reg  <= s0_new;
+              s1_reg  <= s1_new;
+              s2_reg  <= s2_new;
+              s3_reg  <= s3_new;
+              s4_reg  <= s4_new;
+
+              rr0_reg <= rr0_new;
+              rr1_reg <= rr1_new;
+              rr2_reg <= rr2_new;
+              rr3_reg <= rr3_new;
+            end
+
+          if (x4_we)
+            x4_reg <= x4_new;
+
+          if (u_we)
+            begin
+              u0_reg  <= u0_new;
+              u1_reg  <= u1_new;
+              u2_reg  <= u2_new;
+              u3_reg  <= u3_new;
+              u4_reg  <= u4_new;
+              u5_reg  <= u5_new;
+            end
 
           if (cycle_ctr_we)
             cycle_ctr_reg <= cycle_ctr_new;
@@ -303,15 +321,21 @@ module poly1305_pblock(
 
   //----------------------------------------------------------------
   // pblock_logic
+  //
+  // The datapath widths are given by the bounds for poly_block()
+  // in the model, h <= 4_ffffffff_ffffffff_ffffffff_ffffffff,
+  // c <= 1_ffffffff_ffffffff_ffffffff_ffffffff and r clamped.
+  // This gives s0..s3 <= 1_fffffffe, s4 <= 5, x4 <= f,
+  // u5 <= 7ffffff5, u0..u3 <= 1_9ffffff0 and u4 <= 4.
   //----------------------------------------------------------------
   always @*
     begin : pblock_logic
       // s = h + c, no carry propagation.
-      s0_new = {32'h0, h0} + {32'h0, c0};
-      s1_new = {32'h0, h1} + {32'h0, c1};
-      s2_new = {32'h0, h2} + {32'h0, c2};
-      s3_new = {32'h0, h3} + {32'h0, c3};
-      s4_new = {32'h0, h4} + {32'h0, c4};
+      s0_new = {1'h0, h0} + {1'h0, c0};
+      s1_new = {1'h0, h1} + {1'h0, c1};
+      s2_new = {1'h0, h2} + {1'h0, c2};
+      s3_new = {1'h0, h3} + {1'h0, c3};
+      s4_new = h4[2 : 0] + c4[2 : 0];
 
 
       // Multiply r.
@@ -323,16 +347,16 @@ module poly1305_pblock(
 
       // x0..x3 are calculated by the mulacc modules.
       // We don't need registers for x0..x3.
-      x4_new = s4_reg * {32'h0, (r0 & 32'h3)};
+      x4_new = {1'h0, s4_reg} * {2'h0, r0[1 : 0]};
 
 
       // partial reduction modulo 2^130 - 5
-      u5_new = x4_reg + {32'h0, x3_new[63 : 32]};
-      u0_new = ({2'h0, u5_reg[31 : 2]} * 5) + {32'h0, x0_new[31 : 0]};
-      u1_new = {32'h0, u0_reg[63 : 32]} + {32'h0, x1_new[31 : 0]} + {32'h0, x0_new[63 : 32]};
-      u2_new = {32'h0, u1_reg[63 : 32]} + {32'h0, x2_new[31 : 0]} + {32'h0, x1_new[63 : 32]};
-      u3_new = {32'h0, u2_reg[63 : 32]} + {32'h0, x3_new[31 : 0]} + {32'h0, x2_new[63 : 32]};
-      u4_new = u3_reg[63 : 32] + {30'h0, (u5_reg[1 : 0] & 2'h3)};
+      u5_new = {28'h0, x4_reg} + x3_new[63 : 32];
+      u0_new = ({3'h0, u5_reg[31 : 2]} * 33'h5) + {1'h0, x0_new[31 : 0]};
+      u1_new = {32'h0, u0_reg[32]} + {1'h0, x1_new[31 : 0]} + {1'h0, x0_new[63 : 32]};
+      u2_new = {32'h0, u1_reg[32]} + {1'h0, x2_new[31 : 0]} + {1'h0, x1_new[63 : 32]};
+      u3_new = {32'h0, u2_reg[32]} + {1'h0, x3_new[31 : 0]} + {1'h0, x2_new[63 : 32]};
+      u4_new = {2'h0, u3_reg[32]} + {1'h0, u5_reg[1 : 0]};
     end // pblock_logic
 
 
@@ -359,12 +383,26 @@ module poly1305_pblock(
 
   //----------------------------------------------------------------
   // pblock_ctrl
+  //
+  // The operands s and rr are loaded in the first wait cycle
+  // after start, and x4 when the mulaccs are started. The
+  // reduction registers u are updated from when the mulacc
+  // results are ready until the pblock is ready. The reduction
+  // is a chain of six stages, u5, u0, u1, u2, u3 and u4, where
+  // each stage depends on the previous stage register. The u
+  // registers are therefore updated for six cycles, the cycle
+  // when the mulaccs are ready and POST_CYCLES + 1 cycles in
+  // CTRL_POST_WAIT, so that no stage uses a value from the
+  // previous block.
   //----------------------------------------------------------------
   always @*
     begin : pblock_ctrl
       ready_new       = 1'h1;
       ready_we        = 1'h0;
       mulacc_start    = 1'h0;
+      operand_we      = 1'h0;
+      x4_we           = 1'h0;
+      u_we            = 1'h0;
       cycle_ctr_rst   = 1'h0;
       cycle_ctr_inc   = 1'h0;
       pblock_ctrl_new = CTRL_IDLE;
@@ -386,8 +424,12 @@ module poly1305_pblock(
         CTRL_PRE_WAIT:
           begin
             cycle_ctr_inc = 1'h1;
+            if (cycle_ctr_reg == 4'h0)
+              operand_we = 1'h1;
+
             if (cycle_ctr_reg == PRE_CYCLES)
               begin
+                x4_we           = 1'h1;
                 mulacc_start    = 1'h1;
                 pblock_ctrl_new = CTRL_MULACC;
                 pblock_ctrl_we  = 1'h1;
@@ -399,6 +441,7 @@ module poly1305_pblock(
             if ((mulacc0_ready) || (mulacc1_ready) ||
                 (mulacc2_ready) || (mulacc3_ready))
               begin
+                u_we            = 1'h1;
                 cycle_ctr_rst   = 1'h1;
                 pblock_ctrl_new = CTRL_POST_WAIT;
                 pblock_ctrl_we  = 1'h1;
@@ -407,6 +450,7 @@ module poly1305_pblock(
 
         CTRL_POST_WAIT:
           begin
+            u_we          = 1'h1;
             cycle_ctr_inc = 1'h1;
             if (cycle_ctr_reg == POST_CYCLES)
               begin
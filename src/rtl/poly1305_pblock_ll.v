@@ -0,0 +1,366 @@
+//======================================================================
+//
+// poly1305_pblock_ll.v
+// --------------------
+// Low latency version of the block processing. The 5 * r
+// operands are precomputed by the caller, there are no fixed
+// wait states and the partial reduction is done in one cycle.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_pblock_ll(
+                          input wire          clk,
+                          input wire          reset_n,
+
+                          input wire          start,
+                          output wire         ready,
+
+                          input wire [31 : 0] h0,
+                          input wire [31 : 0] h1,
+                          input wire [31 : 0] h2,
+                          input wire [31 : 0] h3,
+                          input wire [31 : 0] h4,
+
+                          input wire [31 : 0] c0,
+                          input wire [31 : 0] c1,
+                          input wire [31 : 0] c2,
+                          input wire [31 : 0] c3,
+                          input wire [31 : 0] c4,
+
+                          input wire [31 : 0] r0,
+                          input wire [31 : 0] r1,
+                          input wire [31 : 0] r2,
+                          input wire [31 : 0] r3,
+
+                          input wire [31 : 0] rr0,
+                          input wire [31 : 0] rr1,
+                          input wire [31 : 0] rr2,
+                          input wire [31 : 0] rr3,
+
+                          output wire [31 : 0] h0_new,
+                          output wire [31 : 0] h1_new,
+                          output wire [31 : 0] h2_new,
+                          output wire [31 : 0] h3_new,
+                          output wire [31 : 0] h4_new
+                         );
+
+
+  //----------------------------------------------------------------
+  // Parameters and symbolic values.
+  //----------------------------------------------------------------
+  localparam CTRL_IDLE   = 2'h0;
+  localparam CTRL_START  = 2'h1;
+  localparam CTRL_MULACC = 2'h2;
+
+
+  //----------------------------------------------------------------
+  // Registers (Variables)
+  //----------------------------------------------------------------
+  reg [63 : 0] s0_reg;
+  reg [63 : 0] s1_reg;
+  reg [63 : 0] s2_reg;
+  reg [63 : 0] s3_reg;
+  reg [63 : 0] s4_reg;
+  reg          s_we;
+
+  reg [31 : 0] u0_reg;
+  reg [31 : 0] u0_new;
+  reg [31 : 0] u1_reg;
+  reg [31 : 0] u1_new;
+  reg [31 : 0] u2_reg;
+  reg [31 : 0] u2_new;
+  reg [31 : 0] u3_reg;
+  reg [31 : 0] u3_new;
+  reg [31 : 0] u4_reg;
+  reg [31 : 0] u4_new;
+  reg          u_we;
+
+  reg          ready_reg;
+  reg          ready_new;
+  reg          ready_we;
+
+  reg [1 : 0]  pblock_ctrl_reg;
+  reg [1 : 0]  pblock_ctrl_new;
+  reg          pblock_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  wire [63 : 0] x0_new;
+  wire [63 : 0] x1_new;
+  wire [63 : 0] x2_new;
+  wire [63 : 0] x3_new;
+
+  reg  mulacc_start;
+  wire mulacc0_ready;
+  wire mulacc1_ready;
+  wire mulacc2_ready;
+  wire mulacc3_ready;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign ready   = ready_reg;
+
+  assign h0_new  = u0_reg;
+  assign h1_new  = u1_reg;
+  assign h2_new  = u2_reg;
+  assign h3_new  = u3_reg;
+  assign h4_new  = u4_reg;
+
+
+  //----------------------------------------------------------------
+  // mulacc instances.
+  //----------------------------------------------------------------
+  poly1305_mulacc mulacc0(
+                          .clk(clk),
+                          .reset_n(reset_n),
+                          .start(mulacc_start),
+                          .ready(mulacc0_ready),
+                          .opa0(r0),
+                          .opb0(s0_reg),
+                          .opa1(rr3),
+                          .opb1(s1_reg),
+                          .opa2(rr2),
+                          .opb2(s2_reg),
+                          .opa3(rr1),
+                          .opb3(s3_reg),
+                          .opa4(rr0),
+                          .opb4(s4_reg),
+                          .sum(x0_new)
+                          );
+
+  poly1305_mulacc mulacc1(
+                          .clk(clk),
+                          .reset_n(reset_n),
+                          .start(mulacc_start),
+                          .ready(mulacc1_ready),
+                          .opa0(r1),
+                          .opb0(s0_reg),
+                          .opa1(r0),
+                          .opb1(s1_reg),
+                          .opa2(rr3),
+                          .opb2(s2_reg),
+                          .opa3(rr2),
+                          .opb3(s3_reg),
+                          .opa4(rr1),
+                          .opb4(s4_reg),
+                          .sum(x1_new)
+                          );
+
+  poly1305_mulacc mulacc2(
+                          .clk(clk),
+                          .reset_n(reset_n),
+                          .start(mulacc_start),
+                          .ready(mulacc2_ready),
+                          .opa0(r2),
+                          .opb0(s0_reg),
+                          .opa1(r1),
+                          .opb1(s1_reg),
+                          .opa2(r0),
+                          .opb2(s2_reg),
+                          .opa3(rr3),
+                          .opb3(s3_reg),
+                          .opa4(rr2),
+                          .opb4(s4_reg),
+                          .sum(x2_new)
+                          );
+
+  poly1305_mulacc mulacc3(
+                          .clk(clk),
+                          .reset_n(reset_n),
+                          .start(mulacc_start),
+                          .ready(mulacc3_ready),
+                          .opa0(r3),
+                          .opb0(s0_reg),
+                          .opa1(r2),
+                          .opb1(s1_reg),
+                          .opa2(r1),
+                          .opb2(s2_reg),
+                          .opa3(r0),
+                          .opb3(s3_reg),
+                          .opa4(rr3),
+                          .opb4(s4_reg),
+                          .sum(x3_new)
+                          );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with synchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          s0_reg          <= 64'h0;
+          s1_reg          <= 64'h0;
+          s2_reg          <= 64'h0;
+          s3_reg          <= 64'h0;
+          s4_reg          <= 64'h0;
+          u0_reg          <= 32'h0;
+          u1_reg          <= 32'h0;
+          u2_reg          <= 32'h0;
+          u3_reg          <= 32'h0;
+          u4_reg          <= 32'h0;
+          ready_reg       <= 1'h1;
+          pblock_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (s_we)
+            begin
+              // s = h + c, no carry propagation.
+              s0_reg <= {32'h0, h0} + {32'h0, c0};
+              s1_reg <= {32'h0, h1} + {32'h0, c1};
+              s2_reg <= {32'h0, h2} + {32'h0, c2};
+              s3_reg <= {32'h0, h3} + {32'h0, c3};
+              s4_reg <= {32'h0, h4} + {32'h0, c4};
+            end
+
+          if (u_we)
+            begin
+              u0_reg <= u0_new;
+              u1_reg <= u1_new;
+              u2_reg <= u2_new;
+              u3_reg <= u3_new;
+              u4_reg <= u4_new;
+            end
+
+          if (ready_we)
+            ready_reg <= ready_new;
+
+          if (pblock_ctrl_we)
+            pblock_ctrl_reg <= pblock_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // reduction_logic
+  //
+  // The partial reduction modulo 2^130 - 5 performed in a single
+  // cycle. The equations are the same as in poly1305_pblock,
+  // but without the pipeline registers between the steps.
+  //----------------------------------------------------------------
+  always @*
+    begin : reduction_logic
+      reg [63 : 0] x4;
+      reg [63 : 0] u0;
+      reg [63 : 0] u1;
+      reg [63 : 0] u2;
+      reg [63 : 0] u3;
+      reg [63 : 0] u5;
+
+      x4 = s4_reg * {32'h0, (r0 & 32'h3)};
+
+      u5 = x4 + {32'h0, x3_new[63 : 32]};
+      u0 = ({2'h0, u5[31 : 2]} * 5) + {32'h0, x0_new[31 : 0]};
+      u1 = {32'h0, u0[63 : 32]} + {32'h0, x1_new[31 : 0]} + {32'h0, x0_new[63 : 32]};
+      u2 = {32'h0, u1[63 : 32]} + {32'h0, x2_new[31 : 0]} + {32'h0, x1_new[63 : 32]};
+      u3 = {32'h0, u2[63 : 32]} + {32'h0, x3_new[31 : 0]} + {32'h0, x2_new[63 : 32]};
+
+      u0_new = u0[31 : 0];
+      u1_new = u1[31 : 0];
+      u2_new = u2[31 : 0];
+      u3_new = u3[31 : 0];
+      u4_new = u3[63 : 32] + {30'h0, u5[1 : 0]};
+    end // reduction_logic
+
+
+  //----------------------------------------------------------------
+  // pblock_ctrl
+  //
+  // s is registered when start is asserted and the mulaccs are
+  // started in the next cycle. When the mulaccs are done, the
+  // reduced result is registered and ready is set.
+  //----------------------------------------------------------------
+  always @*
+    begin : pblock_ctrl
+      s_we            = 1'h0;
+      u_we            = 1'h0;
+      ready_new       = 1'h1;
+      ready_we        = 1'h0;
+      mulacc_start    = 1'h0;
+      pblock_ctrl_new = CTRL_IDLE;
+      pblock_ctrl_we  = 1'h0;
+
+      case (pblock_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (start)
+              begin
+                s_we            = 1'h1;
+                ready_new       = 1'h0;
+                ready_we        = 1'h1;
+                pblock_ctrl_new = CTRL_START;
+                pblock_ctrl_we  = 1'h1;
+              end
+          end
+
+        CTRL_START:
+          begin
+            mulacc_start    = 1'h1;
+            pblock_ctrl_new = CTRL_MULACC;
+            pblock_ctrl_we  = 1'h1;
+          end
+
+        CTRL_MULACC:
+          begin
+            if (mulacc0_ready)
+              begin
+                u_we            = 1'h1;
+                ready_new       = 1'h1;
+                ready_we        = 1'h1;
+                pblock_ctrl_new = CTRL_IDLE;
+                pblock_ctrl_we  = 1'h1;
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (pblock_ctrl_reg)
+    end // pblock_ctrl
+
+endmodule // poly1305_pblock_ll
+
+//======================================================================
+// EOF poly1305_pblock_ll.v
+//======================================================================
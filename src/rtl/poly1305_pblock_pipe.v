@@ -0,0 +1,486 @@
+//======================================================================
+//
+// poly1305_pblock_pipe.v
+// ----------------------
+// Pipelined version of the pblock. The multiplications, the
+// sums and the partial reduction are split into stages that
+// can be separated by pipeline registers, set by the
+// PIPE_DEPTH parameter.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_pblock_pipe #(parameter PIPE_DEPTH = 9)
+                            (
+                             input wire          clk,
+                             input wire          reset_n,
+
+                             input wire          start,
+                             output wire         ready,
+
+                             input wire [31 : 0] h0,
+                             input wire [31 : 0] h1,
+                             input wire [31 : 0] h2,
+                             input wire [31 : 0] h3,
+                             input wire [31 : 0] h4,
+
+                             input wire [31 : 0] c0,
+                             input wire [31 : 0] c1,
+                             input wire [31 : 0] c2,
+                             input wire [31 : 0] c3,
+                             input wire [31 : 0] c4,
+
+                             input wire [31 : 0] r0,
+                             input wire [31 : 0] r1,
+                             input wire [31 : 0] r2,
+                             input wire [31 : 0] r3,
+
+                             output wire [31 : 0] h0_new,
+                             output wire [31 : 0] h1_new,
+                             output wire [31 : 0] h2_new,
+                             output wire [31 : 0] h3_new,
+                             output wire [31 : 0] h4_new
+                            );
+
+
+  //----------------------------------------------------------------
+  // Parameters and symbolic values.
+  //
+  // The datapath consists of the stages below. Each stage can
+  // be followed by a pipeline register. PIPE_DEPTH (0..9) is
+  // the number of pipeline registers used, and STAGES gives
+  // which ones, in the order B, C, .. J (bit 0 .. 8).
+  //
+  // B: 16x33 bit partial products.
+  // C: 64 bit products.
+  // D: Sum of product pairs.
+  // E: x0..x3.
+  // F: u5 and the word sums for u0..u3.
+  // G: u0.
+  // H: u1.
+  // I: u2.
+  // J: u3.
+  //
+  // The stage after J is the output register for h.
+  //----------------------------------------------------------------
+  localparam [8 : 0] STAGES = (PIPE_DEPTH == 0) ? 9'h000 :
+                              (PIPE_DEPTH == 1) ? 9'h008 :
+                              (PIPE_DEPTH == 2) ? 9'h00a :
+                              (PIPE_DEPTH == 3) ? 9'h04a :
+                              (PIPE_DEPTH == 4) ? 9'h0aa :
+                              (PIPE_DEPTH == 5) ? 9'h0ab :
+                              (PIPE_DEPTH == 6) ? 9'h0af :
+                              (PIPE_DEPTH == 7) ? 9'h0bf :
+                              (PIPE_DEPTH == 8) ? 9'h0ff : 9'h1ff;
+
+  localparam STAGE_B = STAGES[0];
+  localparam STAGE_C = STAGES[1];
+  localparam STAGE_D = STAGES[2];
+  localparam STAGE_E = STAGES[3];
+  localparam STAGE_F = STAGES[4];
+  localparam STAGE_G = STAGES[5];
+  localparam STAGE_H = STAGES[6];
+  localparam STAGE_I = STAGES[7];
+  localparam STAGE_J = STAGES[8];
+
+  localparam CTRL_IDLE = 1'h0;
+  localparam CTRL_PIPE = 1'h1;
+
+
+  //----------------------------------------------------------------
+  // Registers (Variables)
+  //----------------------------------------------------------------
+  reg [32 : 0]  s_reg [0 : 4];
+  reg [31 : 0]  r_reg [0 : 3];
+  reg [31 : 0]  rr_reg [0 : 3];
+  reg           s_we;
+
+  reg [48 : 0]  pl_reg [0 : 19];
+  reg [48 : 0]  pl_new [0 : 19];
+  reg [48 : 0]  ph_reg [0 : 19];
+  reg [48 : 0]  ph_new [0 : 19];
+
+  reg [63 : 0]  p_reg [0 : 19];
+  reg [63 : 0]  p_new [0 : 19];
+
+  reg [63 : 0]  xa_reg [0 : 3];
+  reg [63 : 0]  xa_new [0 : 3];
+  reg [63 : 0]  xb_reg [0 : 3];
+  reg [63 : 0]  xb_new [0 : 3];
+
+  reg [63 : 0]  x_reg [0 : 3];
+  reg [63 : 0]  x_new [0 : 3];
+
+  reg [63 : 0]  t_reg [0 : 3];
+  reg [63 : 0]  t_new [0 : 3];
+  reg [63 : 0]  u5_reg;
+  reg [63 : 0]  u5_new;
+
+  reg [63 : 0]  u0_reg;
+  reg [63 : 0]  u0_new;
+  reg [63 : 0]  u1_reg;
+  reg [63 : 0]  u1_new;
+  reg [63 : 0]  u2_reg;
+  reg [63 : 0]  u2_new;
+  reg [63 : 0]  u3_reg;
+  reg [63 : 0]  u3_new;
+
+  reg [31 : 0]  h_reg [0 : 4];
+  reg [31 : 0]  h_new [0 : 4];
+  reg           h_we;
+
+  reg [3 : 0]   cycle_ctr_reg;
+  reg [3 : 0]   cycle_ctr_new;
+  reg           cycle_ctr_we;
+  reg           cycle_ctr_rst;
+  reg           cycle_ctr_inc;
+
+  reg           ready_reg;
+  reg           ready_new;
+  reg           ready_we;
+
+  reg           pblock_ctrl_reg;
+  reg           pblock_ctrl_new;
+  reg           pblock_ctrl_we;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //
+  // The stage outputs, taken from the pipeline register if the
+  // stage is registered, otherwise from the stage logic.
+  //----------------------------------------------------------------
+  reg [48 : 0] pl [0 : 19];
+  reg [48 : 0] ph [0 : 19];
+  reg [63 : 0] p [0 : 19];
+  reg [63 : 0] xa [0 : 3];
+  reg [63 : 0] xb [0 : 3];
+  reg [63 : 0] x [0 : 3];
+  reg [63 : 0] t [0 : 3];
+  reg [63 : 0] u5;
+  reg [63 : 0] u0;
+  reg [63 : 0] u1;
+  reg [63 : 0] u2;
+  reg [63 : 0] u3;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  assign ready  = ready_reg;
+
+  assign h0_new = h_reg[0];
+  assign h1_new = h_reg[1];
+  assign h2_new = h_reg[2];
+  assign h3_new = h_reg[3];
+  assign h4_new = h_reg[4];
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with synchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      integer i;
+
+      if (!reset_n)
+        begin
+          for (i = 0 ; i < 5 ; i = i + 1)
+            begin
+              s_reg[i] <= 33'h0;
+              h_reg[i] <= 32'h0;
+            end
+
+          for (i = 0 ; i < 4 ; i = i + 1)
+            begin
+              r_reg[i]  <= 32'h0;
+              rr_reg[i] <= 32'h0;
+              xa_reg[i] <= 64'h0;
+              xb_reg[i] <= 64'h0;
+              x_reg[i]  <= 64'h0;
+              t_reg[i]  <= 64'h0;
+            end
+
+          for (i = 0 ; i < 20 ; i = i + 1)
+            begin
+              pl_reg[i] <= 49'h0;
+              ph_reg[i] <= 49'h0;
+              p_reg[i]  <= 64'h0;
+            end
+
+          u5_reg          <= 64'h0;
+          u0_reg          <= 64'h0;
+          u1_reg          <= 64'h0;
+          u2_reg          <= 64'h0;
+          u3_reg          <= 64'h0;
+          cycle_ctr_reg   <= 4'h0;
+          ready_reg       <= 1'h1;
+          pblock_ctrl_reg <= CTRL_IDLE;
+        end
+      else
+        begin
+          if (s_we)
+            begin
+              s_reg[0]  <= {1'h0, h0} + {1'h0, c0};
+              s_reg[1]  <= {1'h0, h1} + {1'h0, c1};
+              s_reg[2]  <= {1'h0, h2} + {1'h0, c2};
+              s_reg[3]  <= {1'h0, h3} + {1'h0, c3};
+              s_reg[4]  <= {1'h0, h4} + {1'h0, c4};
+
+              r_reg[0]  <= r0;
+              r_reg[1]  <= r1;
+              r_reg[2]  <= r2;
+              r_reg[3]  <= r3;
+
+              rr_reg[0] <= {2'h0, r0[31 : 2]} * 32'h5;
+              rr_reg[1] <= {2'h0, r1[31 : 2]} + r1;
+              rr_reg[2] <= {2'h0, r2[31 : 2]} + r2;
+              rr_reg[3] <= {2'h0, r3[31 : 2]} + r3;
+            end
+
+          for (i = 0 ; i < 20 ; i = i + 1)
+            begin
+              pl_reg[i] <= pl_new[i];
+              ph_reg[i] <= ph_new[i];
+              p_reg[i]  <= p_new[i];
+            end
+
+          for (i = 0 ; i < 4 ; i = i + 1)
+            begin
+              xa_reg[i] <= xa_new[i];
+              xb_reg[i] <= xb_new[i];
+              x_reg[i]  <= x_new[i];
+              t_reg[i]  <= t_new[i];
+            end
+
+          u5_reg <= u5_new;
+          u0_reg <= u0_new;
+          u1_reg <= u1_new;
+          u2_reg <= u2_new;
+          u3_reg <= u3_new;
+
+          if (h_we)
+            for (i = 0 ; i < 5 ; i = i + 1)
+              h_reg[i] <= h_new[i];
+
+          if (cycle_ctr_we)
+            cycle_ctr_reg <= cycle_ctr_new;
+
+          if (ready_we)
+            ready_reg <= ready_new;
+
+          if (pblock_ctrl_we)
+            pblock_ctrl_reg <= pblock_ctrl_new;
+        end
+    end // reg_update
+
+
+  //----------------------------------------------------------------
+  // pipe_logic
+  //
+  // The datapath. The products are ordered so that product
+  // 5 * i + k is the term k in x_i, i.e. s_k multiplied with
+  // r_(i - k) or rr_(i - k + 4).
+  //
+  // The s, r and rr registers are only loaded at start, and are
+  // held during processing. Values used by later stages therefore
+  // don't need to be delayed to match the pipeline.
+  //----------------------------------------------------------------
+  always @*
+    begin : pipe_logic
+      integer i;
+      integer k;
+      reg [31 : 0] opa;
+
+      // B: Partial products.
+      for (i = 0 ; i < 4 ; i = i + 1)
+        for (k = 0 ; k < 5 ; k = k + 1)
+          begin
+            if (k <= i)
+              opa = r_reg[i - k];
+            else
+              opa = rr_reg[i - k + 4];
+
+            pl_new[5 * i + k] = opa[15 : 00] * s_reg[k];
+            ph_new[5 * i + k] = opa[31 : 16] * s_reg[k];
+          end
+
+      for (i = 0 ; i < 20 ; i = i + 1)
+        begin
+          pl[i] = STAGE_B ? pl_reg[i] : pl_new[i];
+          ph[i] = STAGE_B ? ph_reg[i] : ph_new[i];
+        end
+
+
+      // C: Products.
+      for (i = 0 ; i < 20 ; i = i + 1)
+        begin
+          p_new[i] = {15'h0, pl[i]} + {ph[i][47 : 0], 16'h0};
+          p[i]     = STAGE_C ? p_reg[i] : p_new[i];
+        end
+
+
+      // D: Sum of product pairs.
+      for (i = 0 ; i < 4 ; i = i + 1)
+        begin
+          xa_new[i] = p[5 * i] + p[5 * i + 1];
+          xb_new[i] = p[5 * i + 2] + p[5 * i + 3];
+          xa[i]     = STAGE_D ? xa_reg[i] : xa_new[i];
+          xb[i]     = STAGE_D ? xb_reg[i] : xb_new[i];
+        end
+
+
+      // E: x0..x3.
+      for (i = 0 ; i < 4 ; i = i + 1)
+        begin
+          x_new[i] = xa[i] + xb[i] + p[5 * i + 4];
+          x[i]     = STAGE_E ? x_reg[i] : x_new[i];
+        end
+
+
+      // F: u5 and word sums. x4 = s4 * (r0 & 3) is small.
+      u5_new   = {31'h0, s_reg[4]} * {62'h0, r_reg[0][1 : 0]} +
+                 {32'h0, x[3][63 : 32]};
+      t_new[0] = {32'h0, x[0][31 : 0]};
+      t_new[1] = {32'h0, x[1][31 : 0]} + {32'h0, x[0][63 : 32]};
+      t_new[2] = {32'h0, x[2][31 : 0]} + {32'h0, x[1][63 : 32]};
+      t_new[3] = {32'h0, x[3][31 : 0]} + {32'h0, x[2][63 : 32]};
+
+      u5 = STAGE_F ? u5_reg : u5_new;
+      for (i = 0 ; i < 4 ; i = i + 1)
+        t[i] = STAGE_F ? t_reg[i] : t_new[i];
+
+
+      // G..J: partial reduction modulo 2^130 - 5.
+      u0_new = ({2'h0, u5[31 : 2]} * 5) + t[0];
+      u0     = STAGE_G ? u0_reg : u0_new;
+
+      u1_new = {32'h0, u0[63 : 32]} + t[1];
+      u1     = STAGE_H ? u1_reg : u1_new;
+
+      u2_new = {32'h0, u1[63 : 32]} + t[2];
+      u2     = STAGE_I ? u2_reg : u2_new;
+
+      u3_new = {32'h0, u2[63 : 32]} + t[3];
+      u3     = STAGE_J ? u3_reg : u3_new;
+
+
+      // Output.
+      h_new[0] = u0[31 : 0];
+      h_new[1] = u1[31 : 0];
+      h_new[2] = u2[31 : 0];
+      h_new[3] = u3[31 : 0];
+      h_new[4] = u3[63 : 32] + {30'h0, u5[1 : 0]};
+    end // pipe_logic
+
+
+  //----------------------------------------------------------------
+  // cycle_ctr
+  //----------------------------------------------------------------
+  always @*
+    begin : cycle_ctr
+      cycle_ctr_new = 4'h0;
+      cycle_ctr_we  = 1'h0;
+
+      if (cycle_ctr_rst)
+        begin
+          cycle_ctr_new = 4'h0;
+          cycle_ctr_we  = 1'h1;
+        end
+      else if (cycle_ctr_inc)
+        begin
+          cycle_ctr_new = cycle_ctr_reg + 1'h1;
+          cycle_ctr_we  = 1'h1;
+        end
+    end
+
+
+  //----------------------------------------------------------------
+  // pblock_ctrl
+  //
+  // The result is captured in the h registers when it has
+  // passed all pipeline registers.
+  //----------------------------------------------------------------
+  always @*
+    begin : pblock_ctrl
+      s_we            = 1'h0;
+      h_we            = 1'h0;
+      ready_new       = 1'h1;
+      ready_we        = 1'h0;
+      cycle_ctr_rst   = 1'h0;
+      cycle_ctr_inc   = 1'h0;
+      pblock_ctrl_new = CTRL_IDLE;
+      pblock_ctrl_we  = 1'h0;
+
+      case (pblock_ctrl_reg)
+        CTRL_IDLE:
+          begin
+            if (start)
+              begin
+                s_we            = 1'h1;
+                ready_new       = 1'h0;
+                ready_we        = 1'h1;
+                cycle_ctr_rst   = 1'h1;
+                pblock_ctrl_new = CTRL_PIPE;
+                pblock_ctrl_we  = 1'h1;
+              end
+          end
+
+        CTRL_PIPE:
+          begin
+            cycle_ctr_inc = 1'h1;
+            if (cycle_ctr_reg == PIPE_DEPTH)
+              begin
+                h_we            = 1'h1;
+                ready_new       = 1'h1;
+                ready_we        = 1'h1;
+                pblock_ctrl_new = CTRL_IDLE;
+                pblock_ctrl_we  = 1'h1;
+              end
+          end
+
+        default:
+          begin
+          end
+      endcase // case (pblock_ctrl_reg)
+    end // pblock_ctrl
+
+endmodule // poly1305_pblock_pipe
+
+//======================================================================
+// EOF poly1305_pblock_pipe.v
+//======================================================================
@@ -0,0 +1,139 @@
+//======================================================================
+//
+// poly1305_wb.v
+// -------------
+// Wishbone B4 pipelined slave interface for the Poly1305 top
+// level wrapper. Accepts one access every cycle.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module poly1305_wb #(parameter FIFO_ADDR_BITS = 2,
+                     parameter LOW_LATENCY    = 0,
+                     parameter FINAL_LATENCY  = 0,
+                     parameter HIGH_FMAX      = 0,
+                     parameter PIPE_DEPTH     = 9,
+                     parameter SMALL_CORE     = 0)
+                  (
+                   input wire           clk,
+                   input wire           reset_n,
+
+                   input wire           wb_cyc_i,
+                   input wire           wb_stb_i,
+                   input wire           wb_we_i,
+                   input wire [9 : 0]   wb_adr_i,
+                   input wire [31 : 0]  wb_dat_i,
+                   input wire [3 : 0]   wb_sel_i,
+                   output wire [31 : 0] wb_dat_o,
+                   output wire          wb_ack_o,
+                   output wire          wb_stall_o,
+
+                   output wire          irq
+                  );
+
+
+  //----------------------------------------------------------------
+  // Registers including update variables and write enable.
+  //----------------------------------------------------------------
+  reg [31 : 0] dat_reg;
+  reg          ack_reg;
+
+
+  //----------------------------------------------------------------
+  // Wires.
+  //----------------------------------------------------------------
+  wire          core_cs;
+  wire [31 : 0] core_read_data;
+
+
+  //----------------------------------------------------------------
+  // Concurrent connectivity for ports etc.
+  //----------------------------------------------------------------
+  // All registers are 32 bits wide and the byte selects are
+  // ignored, i.e. only full word writes are supported.
+  assign core_cs    = wb_cyc_i && wb_stb_i;
+
+  assign wb_dat_o   = dat_reg;
+  assign wb_ack_o   = ack_reg;
+
+  // Every access completes in a single cycle,
+  // so the slave never stalls the pipeline.
+  assign wb_stall_o = 1'h0;
+
+
+  //----------------------------------------------------------------
+  // poly1305 instantiation.
+  //----------------------------------------------------------------
+  poly1305 #(.FIFO_ADDR_BITS(FIFO_ADDR_BITS), .LOW_LATENCY(LOW_LATENCY),
+             .FINAL_LATENCY(FINAL_LATENCY), .HIGH_FMAX(HIGH_FMAX),
+             .PIPE_DEPTH(PIPE_DEPTH), .SMALL_CORE(SMALL_CORE))
+           poly1305_inst(
+                         .clk(clk),
+                         .reset_n(reset_n),
+                         .cs(core_cs),
+                         .we(wb_we_i),
+                         .address(wb_adr_i[9 : 2]),
+                         .write_data(wb_dat_i),
+                         .read_data(core_read_data),
+                         .irq(irq)
+                        );
+
+
+  //----------------------------------------------------------------
+  // reg_update
+  //
+  // Update functionality for all registers in the core.
+  // All registers are positive edge triggered with synchronous
+  // active low reset.
+  //----------------------------------------------------------------
+  always @ (posedge clk)
+    begin : reg_update
+      if (!reset_n)
+        begin
+          dat_reg <= 32'h0;
+          ack_reg <= 1'h0;
+        end
+      else
+        begin
+          ack_reg <= core_cs;
+
+          if (core_cs && !wb_we_i)
+            dat_reg <= core_read_data;
+        end
+    end // reg_update
+
+endmodule // poly1305_wb
+
+//======================================================================
+// EOF poly1305_wb.v
+//======================================================================
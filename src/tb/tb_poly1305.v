@@ -43,6 +43,12 @@ module tb_poly1305();
   //----------------------------------------------------------------
   // Internal constant and parameter definitions.
   //----------------------------------------------------------------
+  parameter LOW_LATENCY   = 0;
+  parameter FINAL_LATENCY = 0;
+  parameter HIGH_FMAX     = 0;
+  parameter PIPE_DEPTH    = 9;
+  parameter SMALL_CORE    = 0;
+
   localparam CLK_HALF_PERIOD = 1;
   localparam CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
 
@@ -55,12 +61,33 @@ module tb_poly1305();
   localparam CTRL_INIT_BIT    = 0;
   localparam CTRL_NEXT_BIT    = 1;
   localparam CTRL_FINISH_BIT  = 2;
-
-  localparam ADDR_STATUS      = 8'h09;
-  localparam STATUS_READY_BIT = 0;
+  localparam CTRL_VERIFY_BIT  = 4;
+  localparam CTRL_RESTORE_BIT = 5;
+  localparam CTRL_FLUSH_BIT   = 6;
+
+  localparam ADDR_STATUS          = 8'h09;
+  localparam STATUS_READY_BIT     = 0;
+  localparam STATUS_FULL_BIT      = 1;
+  localparam STATUS_EMPTY_BIT     = 2;
+  localparam STATUS_VALID_BIT     = 3;
+  localparam STATUS_PASS_BIT      = 4;
+  localparam STATUS_CTX_ERROR_BIT = 5;
+  localparam STATUS_OVERFLOW_BIT  = 6;
 
   localparam ADDR_BLOCKLEN    = 8'h0a;
 
+  localparam ADDR_CONFIG      = 8'h0b;
+  localparam CONFIG_CHAIN_BIT = 0;
+
+  localparam ADDR_IRQ_ENABLE  = 8'h0c;
+  localparam ADDR_IRQ_MASK    = 8'h0d;
+  localparam ADDR_IRQ_STATUS  = 8'h0e;
+  localparam IRQ_INIT_BIT     = 0;
+  localparam IRQ_BLOCK_BIT    = 1;
+  localparam IRQ_FINAL_BIT    = 2;
+
+  localparam ADDR_CREDITS     = 8'h0f;
+
   localparam ADDR_KEY0        = 8'h10;
   localparam ADDR_KEY1        = 8'h11;
   localparam ADDR_KEY2        = 8'h12;
@@ -70,16 +97,48 @@ module tb_poly1305();
   localparam ADDR_KEY6        = 8'h16;
   localparam ADDR_KEY7        = 8'h17;
 
+  localparam ADDR_SKEY0       = 8'h18;
+  localparam ADDR_SKEY1       = 8'h19;
+  localparam ADDR_SKEY2       = 8'h1a;
+  localparam ADDR_SKEY3       = 8'h1b;
+  localparam ADDR_SKEY4       = 8'h1c;
+  localparam ADDR_SKEY5       = 8'h1d;
+  localparam ADDR_SKEY6       = 8'h1e;
+  localparam ADDR_SKEY7       = 8'h1f;
+
   localparam ADDR_BLOCK0      = 8'h20;
   localparam ADDR_BLOCK1      = 8'h21;
   localparam ADDR_BLOCK2      = 8'h22;
   localparam ADDR_BLOCK3      = 8'h23;
 
+  localparam ADDR_FIFO_DATA   = 8'h24;
+  localparam ADDR_LASTLEN     = 8'h25;
+  localparam ADDR_FRAGLEN     = 8'h26;
+  localparam ADDR_FIFO_FRAG   = 8'h27;
+
   localparam ADDR_MAC0        = 8'h30;
   localparam ADDR_MAC1        = 8'h31;
   localparam ADDR_MAC2        = 8'h32;
   localparam ADDR_MAC3        = 8'h33;
 
+  localparam ADDR_TAG0        = 8'h34;
+  localparam ADDR_TAG1        = 8'h35;
+  localparam ADDR_TAG2        = 8'h36;
+  localparam ADDR_TAG3        = 8'h37;
+
+  localparam ADDR_PERF_CTRL     = 8'h40;
+  localparam PERF_SNAPSHOT_BIT  = 0;
+  localparam PERF_CLEAR_BIT     = 1;
+
+  localparam ADDR_PERF_CYCLES   = 8'h44;
+  localparam ADDR_PERF_PBLOCK   = 8'h46;
+  localparam ADDR_PERF_FINAL    = 8'h48;
+  localparam ADDR_PERF_BLOCKS   = 8'h4a;
+  localparam ADDR_PERF_MESSAGES = 8'h4c;
+  localparam ADDR_PERF_STALL    = 8'h4e;
+
+  localparam ADDR_CTX0          = 8'h50;
+
 
   //----------------------------------------------------------------
   // Register and Wire declarations.
@@ -90,6 +149,8 @@ module tb_poly1305();
   reg           tc_correct;
 
   reg [31 : 0]  read_data;
+  reg [63 : 0]  perf_data;
+  reg [415 : 0] ctx_data;
   reg [127 : 0] result_mac;
 
   reg           tb_debug;
@@ -102,19 +163,24 @@ module tb_poly1305();
   reg [7  : 0]  tb_address;
   reg [31 : 0]  tb_write_data;
   wire [31 : 0] tb_read_data;
+  wire          tb_irq;
 
 
   //----------------------------------------------------------------
   // Device Under Test.
   //----------------------------------------------------------------
-  poly1305 dut(
+  poly1305 #(.LOW_LATENCY(LOW_LATENCY), .FINAL_LATENCY(FINAL_LATENCY),
+             .HIGH_FMAX(HIGH_FMAX), .PIPE_DEPTH(PIPE_DEPTH),
+             .SMALL_CORE(SMALL_CORE))
+           dut(
                .clk(tb_clk),
                .reset_n(tb_reset_n),
                .cs(tb_cs),
                .we(tb_we),
                .address(tb_address),
                .write_data(tb_write_data),
-               .read_data(tb_read_data)
+               .read_data(tb_read_data),
+               .irq(tb_irq)
               );
 
 
@@ -174,17 +240,15 @@ module tb_poly1305();
           $display("Internal state:");
           $display("---------------");
           $display("r:     0x%08x_%08x_%08x_%08x",
-                   dut.core.r_reg[0], dut.core.r_reg[1],
-                   dut.core.r_reg[2], dut.core.r_reg[3]);
+                   dut.core_ctx[255 : 224], dut.core_ctx[223 : 192],
+                   dut.core_ctx[191 : 160], dut.core_ctx[159 : 128]);
           $display("h:     0x%08x_%08x_%08x_%08x_%08x",
-                   dut.core.h_reg[0], dut.core.h_reg[1], dut.core.h_reg[2],
-                   dut.core.h_reg[3], dut.core.h_reg[4]);
-          $display("c:     0x%08x_%08x_%08x_%08x_%08x",
-                   dut.core.c_reg[0], dut.core.c_reg[1], dut.core.c_reg[2],
-                   dut.core.c_reg[3], dut.core.c_reg[4]);
+                   dut.core_ctx[415 : 384], dut.core_ctx[383 : 352],
+                   dut.core_ctx[351 : 320], dut.core_ctx[319 : 288],
+                   dut.core_ctx[287 : 256]);
           $display("s:     0x%08x_%08x_%08x_%08x",
-                   dut.core.s_reg[0], dut.core.s_reg[1],
-                   dut.core.s_reg[2], dut.core.s_reg[3]);
+                   dut.core_ctx[127 : 96], dut.core_ctx[95 : 64],
+                   dut.core_ctx[63 : 32], dut.core_ctx[31 : 0]);
         end
 
       $display("================================================================");
@@ -291,7 +355,7 @@ module tb_poly1305();
   task wait_ready;
     begin : wready
       read_word(ADDR_STATUS);
-      while (read_data == 0)
+      while (read_data[STATUS_READY_BIT] == 0)
         read_word(ADDR_STATUS);
     end
   endtask // wait_ready
@@ -364,6 +428,37 @@ module tb_poly1305();
   endtask // write_word
 
 
+  //----------------------------------------------------------------
+  // write_fifo()
+  //
+  // Write a word to one of the FIFO addresses. Waits until the
+  // FIFO can accept the word. Note that the write is performed
+  // during a single cycle since each write is pushed.
+  //----------------------------------------------------------------
+  task write_fifo(input [7 : 0]  address,
+                  input [31 : 0] word);
+    begin
+      read_word(ADDR_STATUS);
+      while (read_data[STATUS_FULL_BIT])
+        read_word(ADDR_STATUS);
+
+      if (tb_debug)
+        begin
+          $display("*** Writing 0x%08x to FIFO address 0x%02x.", word, address);
+          $display("");
+        end
+
+      tb_address = address;
+      tb_write_data = word;
+      tb_cs = 1;
+      tb_we = 1;
+      #(CLK_PERIOD);
+      tb_cs = 0;
+      tb_we = 0;
+    end
+  endtask // write_fifo
+
+
   //----------------------------------------------------------------
   // write_key()
   //----------------------------------------------------------------
@@ -386,6 +481,30 @@ module tb_poly1305();
   endtask // write_key
 
 
+  //----------------------------------------------------------------
+  // write_skey()
+  //
+  // Write the key for the next message to the shadow key bank.
+  //----------------------------------------------------------------
+  task write_skey(input [255 : 0] key);
+    begin
+      if (tb_debug)
+        begin
+          $display("Writing shadow key to the DUT: 0x%064x", key);
+        end
+
+      write_word(ADDR_SKEY0, key[255  : 224]);
+      write_word(ADDR_SKEY1, key[223  : 192]);
+      write_word(ADDR_SKEY2, key[191  : 160]);
+      write_word(ADDR_SKEY3, key[159  : 128]);
+      write_word(ADDR_SKEY4, key[127  :  96]);
+      write_word(ADDR_SKEY5, key[95   :  64]);
+      write_word(ADDR_SKEY6, key[63   :  32]);
+      write_word(ADDR_SKEY7, key[31   :   0]);
+    end
+  endtask // write_skey
+
+
   //----------------------------------------------------------------
   // write_block()
   //----------------------------------------------------------------
@@ -404,6 +523,99 @@ module tb_poly1305();
   endtask // write_block
 
 
+  //----------------------------------------------------------------
+  // write_tag()
+  //
+  // Write the expected tag used by the verify command.
+  //----------------------------------------------------------------
+  task write_tag(input [127 : 0] tag);
+    begin
+      write_word(ADDR_TAG0, tag[127  :  96]);
+      write_word(ADDR_TAG1, tag[95   :  64]);
+      write_word(ADDR_TAG2, tag[63   :  32]);
+      write_word(ADDR_TAG3, tag[31   :   0]);
+    end
+  endtask // write_tag
+
+
+  //----------------------------------------------------------------
+  // check_verify()
+  //
+  // Issue the verify command, wait for the result and compare
+  // the pass flag to the expected value.
+  //----------------------------------------------------------------
+  task check_verify(input expected);
+    begin
+      write_word(ADDR_CTRL, (32'h1 << CTRL_VERIFY_BIT));
+
+      read_word(ADDR_STATUS);
+      while (read_data[STATUS_VALID_BIT] == 0)
+        read_word(ADDR_STATUS);
+
+      if (read_data[STATUS_PASS_BIT] == expected)
+        $display("*** check_verify: Correct verify result %0d.", expected);
+      else begin
+        $display("*** check_verify: Error. Expected verify result %0d, got %0d.",
+                 expected, read_data[STATUS_PASS_BIT]);
+        error_ctr = error_ctr + 1;
+      end
+    end
+  endtask // check_verify
+
+
+  //----------------------------------------------------------------
+  // save_ctx()
+  //
+  // Read the context of the message being processed into
+  // ctx_data.
+  //----------------------------------------------------------------
+  task save_ctx;
+    begin : save_ctx
+      integer i;
+
+      for (i = 0 ; i < 13 ; i = i + 1)
+        begin
+          read_word(ADDR_CTX0 + i);
+          ctx_data[(12 - i) * 32 +: 32] = read_data;
+        end
+    end
+  endtask // save_ctx
+
+
+  //----------------------------------------------------------------
+  // restore_ctx()
+  //
+  // Write the context in ctx_data and restore it to the core.
+  //----------------------------------------------------------------
+  task restore_ctx;
+    begin : restore_ctx
+      integer i;
+
+      for (i = 0 ; i < 13 ; i = i + 1)
+        write_word(ADDR_CTX0 + i, ctx_data[(12 - i) * 32 +: 32]);
+
+      write_word(ADDR_CTRL, (32'h1 << CTRL_RESTORE_BIT));
+      wait_ready();
+    end
+  endtask // restore_ctx
+
+
+  //----------------------------------------------------------------
+  // read_perf()
+  //
+  // Read the 64-bit performance counter snapshot at the given
+  // address. The value is returned in perf_data.
+  //----------------------------------------------------------------
+  task read_perf(input [7 : 0] address);
+    begin
+      read_word(address);
+      perf_data[31 : 0] = read_data;
+      read_word(address + 1'h1);
+      perf_data[63 : 32] = read_data;
+    end
+  endtask // read_perf
+
+
   //----------------------------------------------------------------
   // check_mac
   //----------------------------------------------------------------
@@ -617,6 +829,661 @@ module tb_poly1305();
   endtask // test_long
 
 
+  //----------------------------------------------------------------
+  // test_fifo_rfc8439;
+  //
+  // The RFC 8439 test case with the message written as a stream
+  // of words into the block FIFO.
+  //----------------------------------------------------------------
+  task test_fifo_rfc8439;
+    begin : test_fifo_rfc8439
+      $display("*** test_fifo_rfc8439 started.");
+      inc_tc_ctr();
+
+      write_key(256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      wait_ready();
+
+      $display("*** test_fifo_rfc8439: Writing the 34 byte message to the FIFO.");
+      write_fifo(ADDR_FIFO_DATA, 32'h43727970);
+      write_fifo(ADDR_FIFO_DATA, 32'h746f6772);
+      write_fifo(ADDR_FIFO_DATA, 32'h61706869);
+      write_fifo(ADDR_FIFO_DATA, 32'h6320466f);
+      write_fifo(ADDR_FIFO_DATA, 32'h72756d20);
+      write_fifo(ADDR_FIFO_DATA, 32'h52657365);
+      write_fifo(ADDR_FIFO_DATA, 32'h61726368);
+      write_fifo(ADDR_FIFO_DATA, 32'h2047726f);
+      write_fifo(ADDR_FIFO_DATA, 32'h75700000);
+      write_fifo(ADDR_LASTLEN, 32'h2);
+      wait_ready();
+
+      $display("*** test_fifo_rfc8439: running finish() to get the MAC.");
+      write_word(ADDR_CTRL, (32'h1 << CTRL_FINISH_BIT));
+      wait_ready();
+      check_mac(128'ha8061dc1_305136c6_c22b8baf_0c0127a9);
+
+      $display("*** test_fifo_rfc8439 completed.\n");
+    end
+  endtask // test_fifo_rfc8439
+
+
+  //----------------------------------------------------------------
+  // test_fifo_long;
+  //
+  // The long message test case with all blocks written as a
+  // stream of words into the block FIFO.
+  //----------------------------------------------------------------
+  task test_fifo_long;
+    begin : test_fifo_long
+      integer i;
+
+      $display("*** test_fifo_long started.");
+      inc_tc_ctr();
+
+      write_key(256'hf3000000_00000000_00000000_0000003f_3f000000_00000000_00000000_000000f3);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      wait_ready();
+
+      $display("*** test_fifo_long: Writing 64 complete blocks to the FIFO.");
+      for (i = 0 ; i < 256 ; i = i + 1)
+        write_fifo(ADDR_FIFO_DATA, 32'hffffffff);
+
+      $display("*** test_fifo_long: Writing the final single byte block.");
+      write_fifo(ADDR_FIFO_DATA, 32'h01000000);
+      write_fifo(ADDR_LASTLEN, 32'h1);
+      wait_ready();
+
+      $display("*** test_fifo_long: running finish() to get the MAC.");
+      write_word(ADDR_CTRL, (32'h1 << CTRL_FINISH_BIT));
+      wait_ready();
+      check_mac(128'hdc0964e5ce9cd7d9a7571fafa5dc0473);
+
+      $display("*** test_fifo_long completed.\n");
+    end
+  endtask // test_fifo_long
+
+
+  //----------------------------------------------------------------
+  // write_fifo_msg()
+  //
+  // Write a message with the bytes 0x00, 0x01, ... to the FIFO
+  // as words, with the final word padded with zeros, followed
+  // by the length of the final block.
+  //----------------------------------------------------------------
+  task write_fifo_msg(input [31 : 0] num_bytes);
+    begin : write_fifo_msg
+      integer i;
+      integer j;
+      reg [31 : 0] word;
+
+      for (i = 0 ; i < num_bytes ; i = i + 4)
+        begin
+          word = 32'h0;
+          for (j = 0 ; j < 4 ; j = j + 1)
+            if ((i + j) < num_bytes)
+              word[(3 - j) * 8 +: 8] = i + j;
+          write_fifo(ADDR_FIFO_DATA, word);
+        end
+
+      write_fifo(ADDR_LASTLEN, num_bytes % 16);
+    end
+  endtask // write_fifo_msg
+
+
+  //----------------------------------------------------------------
+  // test_fifo_tails;
+  //
+  // Messages with a full block followed by a final block of
+  // 0, 12, 13 and 15 bytes written to the FIFO. The final block
+  // of 13..15 bytes has four words, where the last word is
+  // padded, and must not be processed as a full block.
+  //----------------------------------------------------------------
+  task test_fifo_tails;
+    begin : test_fifo_tails
+      integer i;
+      reg [31 : 0]  num_bytes;
+      reg [127 : 0] expected;
+
+      $display("*** test_fifo_tails started.");
+      inc_tc_ctr();
+
+      for (i = 0 ; i < 4 ; i = i + 1)
+        begin
+          case (i)
+            0:
+              begin
+                num_bytes = 32;
+                expected  = 128'ha0a50f18_e27e3b64_b55c78b7_10bc536b;
+              end
+
+            1:
+              begin
+                num_bytes = 28;
+                expected  = 128'h7ac8ffe5_3470b888_f68aebef_8d490f97;
+              end
+
+            2:
+              begin
+                num_bytes = 29;
+                expected  = 128'h5c7154a2_9292e652_3ab85c07_a06e0642;
+              end
+
+            default:
+              begin
+                num_bytes = 31;
+                expected  = 128'h0e25d93d_39507235_127a78c3_43311eca;
+              end
+          endcase // case (i)
+
+          $display("*** test_fifo_tails: Message with %0d bytes.", num_bytes);
+          write_key(256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b);
+          write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+          wait_ready();
+
+          write_fifo_msg(num_bytes);
+          wait_ready();
+          check_mac(expected);
+        end
+
+      $display("*** test_fifo_tails completed.\n");
+    end
+  endtask // test_fifo_tails
+
+
+  //----------------------------------------------------------------
+  // test_fifo_frag;
+  //
+  // Messages of 29 and 31 bytes written to the FIFO as fragments
+  // of 0..4 bytes using ADDR_FRAGLEN and ADDR_FIFO_FRAG. The
+  // fragments cross the word and block boundaries.
+  //----------------------------------------------------------------
+  task test_fifo_frag;
+    begin : test_fifo_frag
+      integer i;
+      integer j;
+      integer k;
+      integer b;
+      integer frag_len;
+      reg [31 : 0]  num_bytes;
+      reg [31 : 0]  word;
+      reg [127 : 0] expected;
+
+      $display("*** test_fifo_frag started.");
+      inc_tc_ctr();
+
+      for (i = 0 ; i < 2 ; i = i + 1)
+        begin
+          if (i == 0)
+            begin
+              num_bytes = 29;
+              expected  = 128'h5c7154a2_9292e652_3ab85c07_a06e0642;
+            end
+          else
+            begin
+              num_bytes = 31;
+              expected  = 128'h0e25d93d_39507235_127a78c3_43311eca;
+            end
+
+          $display("*** test_fifo_frag: Message with %0d bytes.", num_bytes);
+          write_key(256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b);
+          write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+          wait_ready();
+
+          j = 0;
+          k = 0;
+          while (j < num_bytes)
+            begin
+              case (k % 5)
+                0: frag_len = 3;
+                1: frag_len = 1;
+                2: frag_len = 0;
+                3: frag_len = 2;
+                default: frag_len = 4;
+              endcase // case (k % 5)
+
+              if ((j + frag_len) > num_bytes)
+                frag_len = num_bytes - j;
+
+              word = 32'h0;
+              for (b = 0 ; b < frag_len ; b = b + 1)
+                word[(3 - b) * 8 +: 8] = j + b;
+
+              write_word(ADDR_FRAGLEN, frag_len);
+              write_fifo(ADDR_FIFO_FRAG, word);
+              j = j + frag_len;
+              k = k + 1;
+            end
+
+          write_word(ADDR_FRAGLEN, 32'h4);
+          write_fifo(ADDR_LASTLEN, num_bytes % 16);
+          wait_ready();
+          check_mac(expected);
+        end
+
+      $display("*** test_fifo_frag completed.\n");
+    end
+  endtask // test_fifo_frag
+
+
+  //----------------------------------------------------------------
+  // test_chain;
+  //
+  // Two messages processed back to back in chain mode. The key
+  // for the second message is written to the shadow key bank
+  // while the first message is processed, and the core is
+  // initialized with it directly when the first final
+  // processing is completed. The second message is processed
+  // without any init command.
+  //----------------------------------------------------------------
+  task test_chain;
+    begin : test_chain
+      integer i;
+
+      $display("*** test_chain started.");
+      inc_tc_ctr();
+
+      write_key(256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      wait_ready();
+
+      write_word(ADDR_CONFIG, (32'h1 << CONFIG_CHAIN_BIT));
+      read_word(ADDR_CONFIG);
+      if (read_data != (32'h1 << CONFIG_CHAIN_BIT))
+        begin
+          $display("*** test_chain: Error. Chain mode not enabled.");
+          error_ctr = error_ctr + 1;
+        end
+
+      $display("*** test_chain: Writing the first message to the FIFO.");
+      write_fifo(ADDR_FIFO_DATA, 32'h43727970);
+      write_fifo(ADDR_FIFO_DATA, 32'h746f6772);
+      write_fifo(ADDR_FIFO_DATA, 32'h61706869);
+      write_fifo(ADDR_FIFO_DATA, 32'h6320466f);
+      write_fifo(ADDR_FIFO_DATA, 32'h72756d20);
+      write_skey(256'hf3000000_00000000_00000000_0000003f_3f000000_00000000_00000000_000000f3);
+      write_fifo(ADDR_FIFO_DATA, 32'h52657365);
+      write_fifo(ADDR_FIFO_DATA, 32'h61726368);
+      write_fifo(ADDR_FIFO_DATA, 32'h2047726f);
+      write_fifo(ADDR_FIFO_DATA, 32'h75700000);
+      write_fifo(ADDR_LASTLEN, 32'h2);
+      wait_ready();
+      check_mac(128'ha8061dc1_305136c6_c22b8baf_0c0127a9);
+
+      write_word(ADDR_CONFIG, 32'h0);
+
+      $display("*** test_chain: Writing the second message to the FIFO.");
+      for (i = 0 ; i < 256 ; i = i + 1)
+        write_fifo(ADDR_FIFO_DATA, 32'hffffffff);
+      write_fifo(ADDR_FIFO_DATA, 32'h01000000);
+      write_fifo(ADDR_LASTLEN, 32'h1);
+      wait_ready();
+      check_mac(128'hdc0964e5ce9cd7d9a7571fafa5dc0473);
+
+      $display("*** test_chain completed.\n");
+    end
+  endtask // test_chain
+
+
+  //----------------------------------------------------------------
+  // test_perf;
+  //
+  // Clear the performance counters, process the RFC 8439
+  // message and check the counter snapshot.
+  //----------------------------------------------------------------
+  task test_perf;
+    begin : test_perf
+      reg [63 : 0] cycles;
+      reg [63 : 0] pblock_cycles;
+      reg [63 : 0] final_cycles;
+
+      $display("*** test_perf started.");
+      inc_tc_ctr();
+
+      write_key(256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b);
+      write_word(ADDR_PERF_CTRL, (32'h1 << PERF_CLEAR_BIT));
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      wait_ready();
+
+      write_fifo(ADDR_FIFO_DATA, 32'h43727970);
+      write_fifo(ADDR_FIFO_DATA, 32'h746f6772);
+      write_fifo(ADDR_FIFO_DATA, 32'h61706869);
+      write_fifo(ADDR_FIFO_DATA, 32'h6320466f);
+      write_fifo(ADDR_FIFO_DATA, 32'h72756d20);
+      write_fifo(ADDR_FIFO_DATA, 32'h52657365);
+      write_fifo(ADDR_FIFO_DATA, 32'h61726368);
+      write_fifo(ADDR_FIFO_DATA, 32'h2047726f);
+      write_fifo(ADDR_FIFO_DATA, 32'h75700000);
+      write_fifo(ADDR_LASTLEN, 32'h2);
+      wait_ready();
+      check_mac(128'ha8061dc1_305136c6_c22b8baf_0c0127a9);
+
+      write_word(ADDR_PERF_CTRL, (32'h1 << PERF_SNAPSHOT_BIT));
+
+      read_perf(ADDR_PERF_CYCLES);
+      cycles = perf_data;
+      read_perf(ADDR_PERF_PBLOCK);
+      pblock_cycles = perf_data;
+      read_perf(ADDR_PERF_FINAL);
+      final_cycles = perf_data;
+      $display("*** test_perf: cycles: %0d, pblock: %0d, final: %0d",
+               cycles, pblock_cycles, final_cycles);
+
+      if ((pblock_cycles == 0) || (final_cycles == 0) ||
+          (cycles < (pblock_cycles + final_cycles)))
+        begin
+          $display("*** test_perf: Error. Incorrect cycle counters.");
+          error_ctr = error_ctr + 1;
+        end
+
+      read_perf(ADDR_PERF_BLOCKS);
+      if (perf_data != 64'h3)
+        begin
+          $display("*** test_perf: Error. Expected 3 blocks, got %0d.", perf_data);
+          error_ctr = error_ctr + 1;
+        end
+
+      read_perf(ADDR_PERF_MESSAGES);
+      if (perf_data != 64'h1)
+        begin
+          $display("*** test_perf: Error. Expected 1 message, got %0d.", perf_data);
+          error_ctr = error_ctr + 1;
+        end
+
+      read_perf(ADDR_PERF_STALL);
+      $display("*** test_perf: stall: %0d", perf_data);
+      if ((perf_data == 0) || (perf_data > cycles))
+        begin
+          $display("*** test_perf: Error. Incorrect stall counter.");
+          error_ctr = error_ctr + 1;
+        end
+
+      $display("*** test_perf completed.\n");
+    end
+  endtask // test_perf
+
+
+  //----------------------------------------------------------------
+  // wait_irq()
+  //
+  // Wait for the irq to be set and check that the expected
+  // event bits are set in the irq status. The events are
+  // then cleared.
+  //----------------------------------------------------------------
+  task wait_irq(input [2 : 0] expected);
+    begin : wait_irq
+      integer i;
+
+      i = 0;
+      while (!tb_irq && (i < 1000))
+        begin
+          #(CLK_PERIOD);
+          i = i + 1;
+        end
+
+      read_word(ADDR_IRQ_STATUS);
+      if (!tb_irq || (read_data[2 : 0] != expected))
+        begin
+          $display("*** wait_irq: Error. irq: %01x, status: 0x%01x, expected: 0x%01x",
+                   tb_irq, read_data[2 : 0], expected);
+          error_ctr = error_ctr + 1;
+        end
+
+      write_word(ADDR_IRQ_STATUS, {29'h0, expected});
+      #(2 * CLK_PERIOD);
+      if (tb_irq)
+        begin
+          $display("*** wait_irq: Error. irq not cleared.");
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // wait_irq
+
+
+  //----------------------------------------------------------------
+  // test_irq;
+  //
+  // The RFC 8439 message processed using the interrupt instead
+  // of polling the ready flag. The first two blocks are written
+  // to the FIFO based on the credits. The first block is passed
+  // to the core when the first word of the second block has
+  // been written.
+  //----------------------------------------------------------------
+  task test_irq;
+    begin : test_irq
+      $display("*** test_irq started.");
+      inc_tc_ctr();
+
+      write_key(256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b);
+      write_word(ADDR_IRQ_STATUS, 32'h7);
+      write_word(ADDR_IRQ_MASK, 32'h7);
+      write_word(ADDR_IRQ_ENABLE, 32'h1);
+
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      wait_irq(3'h1 << IRQ_INIT_BIT);
+
+      read_word(ADDR_CREDITS);
+      if (read_data < 2)
+        begin
+          $display("*** test_irq: Error. Expected at least 2 credits, got %0d.", read_data);
+          error_ctr = error_ctr + 1;
+        end
+
+      write_fifo(ADDR_FIFO_DATA, 32'h43727970);
+      write_fifo(ADDR_FIFO_DATA, 32'h746f6772);
+      write_fifo(ADDR_FIFO_DATA, 32'h61706869);
+      write_fifo(ADDR_FIFO_DATA, 32'h6320466f);
+      write_fifo(ADDR_FIFO_DATA, 32'h72756d20);
+      wait_irq(3'h1 << IRQ_BLOCK_BIT);
+
+      write_word(ADDR_IRQ_MASK, (32'h1 << IRQ_FINAL_BIT));
+      write_fifo(ADDR_FIFO_DATA, 32'h52657365);
+      write_fifo(ADDR_FIFO_DATA, 32'h61726368);
+      write_fifo(ADDR_FIFO_DATA, 32'h2047726f);
+      write_fifo(ADDR_FIFO_DATA, 32'h75700000);
+      write_fifo(ADDR_LASTLEN, 32'h2);
+      wait_irq((3'h1 << IRQ_BLOCK_BIT) | (3'h1 << IRQ_FINAL_BIT));
+      check_mac(128'ha8061dc1_305136c6_c22b8baf_0c0127a9);
+
+      write_word(ADDR_IRQ_ENABLE, 32'h0);
+      write_word(ADDR_IRQ_MASK, 32'h0);
+
+      $display("*** test_irq completed.\n");
+    end
+  endtask // test_irq
+
+
+  //----------------------------------------------------------------
+  // test_verify;
+  //
+  // The RFC 8439 message verified against the expected tag. The
+  // verify command is issued directly after the final block and
+  // must wait for the final processing. The mac is then
+  // verified against tags with a single bit error in the first
+  // and the last bit.
+  //----------------------------------------------------------------
+  task test_verify;
+    begin : test_verify
+      $display("*** test_verify started.");
+      inc_tc_ctr();
+
+      write_key(256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b);
+      write_tag(128'ha8061dc1_305136c6_c22b8baf_0c0127a9);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      wait_ready();
+
+      write_fifo(ADDR_FIFO_DATA, 32'h43727970);
+      write_fifo(ADDR_FIFO_DATA, 32'h746f6772);
+      write_fifo(ADDR_FIFO_DATA, 32'h61706869);
+      write_fifo(ADDR_FIFO_DATA, 32'h6320466f);
+      write_fifo(ADDR_FIFO_DATA, 32'h72756d20);
+      write_fifo(ADDR_FIFO_DATA, 32'h52657365);
+      write_fifo(ADDR_FIFO_DATA, 32'h61726368);
+      write_fifo(ADDR_FIFO_DATA, 32'h2047726f);
+      write_fifo(ADDR_FIFO_DATA, 32'h75700000);
+      write_fifo(ADDR_LASTLEN, 32'h2);
+      check_verify(1);
+
+      write_tag(128'h28061dc1_305136c6_c22b8baf_0c0127a9);
+      check_verify(0);
+
+      write_tag(128'ha8061dc1_305136c6_c22b8baf_0c0127a8);
+      check_verify(0);
+
+      write_tag(128'ha8061dc1_305136c6_c22b8baf_0c0127a9);
+      check_verify(1);
+
+      $display("*** test_verify completed.\n");
+    end
+  endtask // test_verify
+
+
+  //----------------------------------------------------------------
+  // test_ctx;
+  //
+  // Two streams time sliced on the core. The first two blocks
+  // of the RFC 8439 message are processed, flushed from the
+  // packer, and the context is saved. The long message is then processed, and finally the
+  // context is restored and the RFC 8439 message is completed.
+  //----------------------------------------------------------------
+  task test_ctx;
+    begin : test_ctx
+      integer i;
+      reg [31 : 0] saved_h4;
+
+      $display("*** test_ctx started.");
+      inc_tc_ctr();
+
+      write_key(256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      wait_ready();
+
+      write_fifo(ADDR_FIFO_DATA, 32'h43727970);
+      write_fifo(ADDR_FIFO_DATA, 32'h746f6772);
+      write_fifo(ADDR_FIFO_DATA, 32'h61706869);
+      write_fifo(ADDR_FIFO_DATA, 32'h6320466f);
+      write_fifo(ADDR_FIFO_DATA, 32'h72756d20);
+      write_fifo(ADDR_FIFO_DATA, 32'h52657365);
+      write_fifo(ADDR_FIFO_DATA, 32'h61726368);
+      write_fifo(ADDR_FIFO_DATA, 32'h2047726f);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_FLUSH_BIT));
+      wait_ready();
+
+      $display("*** test_ctx: Saving the context and switching to the long message.");
+      save_ctx();
+      saved_h4 = ctx_data[287 : 256];
+
+      write_key(256'hf3000000_00000000_00000000_0000003f_3f000000_00000000_00000000_000000f3);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      wait_ready();
+
+      for (i = 0 ; i < 256 ; i = i + 1)
+        write_fifo(ADDR_FIFO_DATA, 32'hffffffff);
+      write_fifo(ADDR_FIFO_DATA, 32'h01000000);
+      write_fifo(ADDR_LASTLEN, 32'h1);
+      wait_ready();
+      check_mac(128'hdc0964e5ce9cd7d9a7571fafa5dc0473);
+
+      $display("*** test_ctx: Restoring a context with h4 out of range.");
+      ctx_data[287 : 256] = 32'h5;
+      restore_ctx();
+      read_word(ADDR_STATUS);
+      if (!read_data[STATUS_CTX_ERROR_BIT])
+        begin
+          $display("*** test_ctx: Error. Context with h4 = 5 restored.");
+          error_ctr = error_ctr + 1;
+        end
+      ctx_data[287 : 256] = saved_h4;
+
+      $display("*** test_ctx: Restoring the context and completing the message.");
+      restore_ctx();
+      read_word(ADDR_STATUS);
+      if (read_data[STATUS_CTX_ERROR_BIT])
+        begin
+          $display("*** test_ctx: Error. Context error set for a valid context.");
+          error_ctr = error_ctr + 1;
+        end
+
+      write_fifo(ADDR_FIFO_DATA, 32'h75700000);
+      write_fifo(ADDR_LASTLEN, 32'h2);
+      wait_ready();
+      check_mac(128'ha8061dc1_305136c6_c22b8baf_0c0127a9);
+
+      $display("*** test_ctx completed.\n");
+    end
+  endtask // test_ctx
+
+
+  //----------------------------------------------------------------
+  // test_overflow;
+  //
+  // Check that FULL is not set when the FIFO can accept words,
+  // and that words written back to back without checking FULL
+  // are dropped when the FIFO is full and set the sticky
+  // OVERFLOW bit. The message is left incomplete, so this test
+  // must be run last.
+  //----------------------------------------------------------------
+  task test_overflow;
+    begin : test_overflow
+      integer i;
+
+      $display("*** test_overflow started.");
+      inc_tc_ctr();
+
+      write_key(256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      wait_ready();
+
+      $display("*** test_overflow: Writing one block with an empty FIFO.");
+      tb_address    = ADDR_FIFO_DATA;
+      tb_write_data = 32'hffffffff;
+      tb_cs         = 1;
+      tb_we         = 1;
+      #(4 * CLK_PERIOD);
+      tb_cs         = 0;
+      tb_we         = 0;
+
+      read_word(ADDR_STATUS);
+      if (read_data[STATUS_FULL_BIT] || read_data[STATUS_OVERFLOW_BIT])
+        begin
+          $display("*** test_overflow: Error. FULL or OVERFLOW set with room in the FIFO.");
+          error_ctr = error_ctr + 1;
+        end
+
+      $display("*** test_overflow: Writing words back to back until the FIFO overflows.");
+      tb_cs = 1;
+      tb_we = 1;
+      #(64 * CLK_PERIOD);
+      tb_cs = 0;
+      tb_we = 0;
+
+      read_word(ADDR_STATUS);
+      if (!read_data[STATUS_FULL_BIT] || !read_data[STATUS_OVERFLOW_BIT])
+        begin
+          $display("*** test_overflow: Error. FULL and OVERFLOW not set.");
+          error_ctr = error_ctr + 1;
+        end
+
+      wait_ready();
+      read_word(ADDR_STATUS);
+      if (!read_data[STATUS_OVERFLOW_BIT])
+        begin
+          $display("*** test_overflow: Error. OVERFLOW not sticky.");
+          error_ctr = error_ctr + 1;
+        end
+
+      write_word(ADDR_STATUS, (32'h1 << STATUS_OVERFLOW_BIT));
+      read_word(ADDR_STATUS);
+      if (read_data[STATUS_OVERFLOW_BIT])
+        begin
+          $display("*** test_overflow: Error. OVERFLOW not cleared.");
+          error_ctr = error_ctr + 1;
+        end
+
+      $display("*** test_overflow completed.\n");
+    end
+  endtask // test_overflow
+
+
   //----------------------------------------------------------------
   // main
   //
@@ -635,6 +1502,16 @@ module tb_poly1305();
       test_bytes1();
       test_rfc8439();
       test_long();
+      test_fifo_rfc8439();
+      test_fifo_long();
+      test_fifo_tails();
+      test_fifo_frag();
+      test_chain();
+      test_perf();
+      test_irq();
+      test_verify();
+      test_ctx();
+      test_overflow();
 
       display_test_results();
 
@@ -0,0 +1,490 @@
+//======================================================================
+//
+// tb_poly1305_aead.v
+// ------------------
+// Testbench for the Poly1305 AEAD framing front end.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module tb_poly1305_aead();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam CLK_HALF_PERIOD = 1;
+  localparam CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  localparam MAX_BYTES       = 128;
+
+  // Test vectors from RFC 8439, section 2.8.2.
+  localparam RFC_KEY = 256'h7bac2b25_2db447af_09b67a55_a4e95584_0ae1d673_1075d9eb_2a937578_3ed553ff;
+  localparam RFC_AAD = 96'h50515253_c0c1c2c3_c4c5c6c7;
+  localparam RFC_CT  = {128'hd31a8d34_648e60db_7b86afbc_53ef7ec2,
+                        128'ha4aded51_296e08fe_a9e2b5a7_36ee62d6,
+                        128'h3dbea45e_8ca96712_82fafb69_da92728b,
+                        128'h1a71de0a_9e060b29_05d6a5b6_7ecd3b36,
+                        128'h92ddbd7f_2d778b8c_9803aee3_28091b58,
+                        128'hfab324e4_fad67594_5585808b_4831d7bc,
+                        128'h3ff4def0_8e4b7a9d_e576d265_86cec64b,
+                        16'h6116};
+  localparam RFC_TAG = 128'h1ae10b59_4f09e26a_7e902ecb_d0600691;
+
+  localparam KEY     = 256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]   cycle_ctr;
+  reg [31 : 0]   error_ctr;
+  reg [31 : 0]   tc_ctr;
+
+  reg [7 : 0]    aad_mem [0 : (MAX_BYTES - 1)];
+  reg [7 : 0]    ct_mem [0 : (MAX_BYTES - 1)];
+
+  reg [127 : 0]  result_tag;
+  reg            result_valid;
+
+  reg            tb_debug;
+
+  reg            tb_clk;
+  reg            tb_reset_n;
+  reg            tb_init;
+  wire           tb_ready;
+  reg [255 : 0]  tb_key;
+  reg [63 : 0]   tb_aad_len;
+  reg [63 : 0]   tb_ct_len;
+  reg [127 : 0]  tb_s_aad_tdata;
+  reg            tb_s_aad_tvalid;
+  wire           tb_s_aad_tready;
+  reg [127 : 0]  tb_s_ct_tdata;
+  reg            tb_s_ct_tvalid;
+  wire           tb_s_ct_tready;
+  wire [127 : 0] tb_m_axis_tdata;
+  wire           tb_m_axis_tvalid;
+  reg            tb_m_axis_tready;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  poly1305_aead dut(
+                    .clk(tb_clk),
+                    .reset_n(tb_reset_n),
+                    .init(tb_init),
+                    .ready(tb_ready),
+                    .key(tb_key),
+                    .aad_len(tb_aad_len),
+                    .ct_len(tb_ct_len),
+                    .s_aad_tdata(tb_s_aad_tdata),
+                    .s_aad_tvalid(tb_s_aad_tvalid),
+                    .s_aad_tready(tb_s_aad_tready),
+                    .s_ct_tdata(tb_s_ct_tdata),
+                    .s_ct_tvalid(tb_s_ct_tvalid),
+                    .s_ct_tready(tb_s_ct_tready),
+                    .m_axis_tdata(tb_m_axis_tdata),
+                    .m_axis_tvalid(tb_m_axis_tvalid),
+                    .m_axis_tready(tb_m_axis_tready)
+                   );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter,
+  // captures the tag delivered on the tag stream and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always @ (posedge tb_clk)
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      if (tb_m_axis_tvalid && tb_m_axis_tready)
+        begin
+          result_tag   = tb_m_axis_tdata;
+          result_valid = 1;
+        end
+
+      if (tb_debug)
+        dump_dut_state();
+    end
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dump when needed.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("cycle: 0x%08x, aead_ctrl: 0x%01x, core_ready: 0x%01x",
+               cycle_ctr, dut.aead_ctrl_reg, dut.core_ready);
+      $display("aad_rem: 0x%016x, ct_rem: 0x%016x", dut.aad_rem_reg, dut.ct_rem_reg);
+      $display("core_next: 0x%01x, core_last: 0x%01x, core_block: 0x%032x",
+               dut.core_next, dut.core_last, dut.core_block);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("TB: Resetting dut.");
+      tb_reset_n = 0;
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      $display("");
+      if (error_ctr == 0)
+        begin
+          $display("%02d test completed. All test cases completed successfully.", tc_ctr);
+        end
+      else
+        begin
+          $display("%02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr        = 0;
+      error_ctr        = 0;
+      tc_ctr           = 0;
+      tb_debug         = 0;
+      result_tag       = 128'h0;
+      result_valid     = 0;
+
+      tb_clk           = 0;
+      tb_reset_n       = 1;
+      tb_init          = 0;
+      tb_key           = 256'h0;
+      tb_aad_len       = 64'h0;
+      tb_ct_len        = 64'h0;
+      tb_s_aad_tdata   = 128'h0;
+      tb_s_aad_tvalid  = 0;
+      tb_s_ct_tdata    = 128'h0;
+      tb_s_ct_tvalid   = 0;
+      tb_m_axis_tready = 1;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // start_aead()
+  //
+  // Wait for ready and start processing of a message with
+  // the given key and lengths.
+  //----------------------------------------------------------------
+  task start_aead(input [255 : 0] key, input [63 : 0] aad_len,
+                  input [63 : 0] ct_len);
+    begin
+      while (!tb_ready)
+        #(CLK_PERIOD);
+
+      tb_key     = key;
+      tb_aad_len = aad_len;
+      tb_ct_len  = ct_len;
+      tb_init    = 1;
+      #(CLK_PERIOD);
+      tb_init    = 0;
+    end
+  endtask // start_aead
+
+
+  //----------------------------------------------------------------
+  // send_aad()
+  //
+  // Send the given number of bytes from aad_mem as beats on the
+  // AAD stream, with the first byte in the least significant
+  // byte lane. The unused lanes in the final beat are set to
+  // garbage to check that they are padded by the DUT.
+  //----------------------------------------------------------------
+  task send_aad(input [31 : 0] num_bytes);
+    begin : send_aad
+      integer i;
+      integer j;
+
+      for (i = 0 ; i < num_bytes ; i = i + 16)
+        begin
+          for (j = 0 ; j < 16 ; j = j + 1)
+            tb_s_aad_tdata[j * 8 +: 8] = ((i + j) < num_bytes) ? aad_mem[i + j] : 8'ha5;
+          tb_s_aad_tvalid = 1;
+
+          while (!tb_s_aad_tready)
+            #(CLK_PERIOD);
+          #(CLK_PERIOD);
+
+          tb_s_aad_tvalid = 0;
+        end
+    end
+  endtask // send_aad
+
+
+  //----------------------------------------------------------------
+  // send_ct()
+  //
+  // Send the given number of bytes from ct_mem as beats on the
+  // ciphertext stream in the same way as for the AAD.
+  //----------------------------------------------------------------
+  task send_ct(input [31 : 0] num_bytes);
+    begin : send_ct
+      integer i;
+      integer j;
+
+      for (i = 0 ; i < num_bytes ; i = i + 16)
+        begin
+          for (j = 0 ; j < 16 ; j = j + 1)
+            tb_s_ct_tdata[j * 8 +: 8] = ((i + j) < num_bytes) ? ct_mem[i + j] : 8'h5a;
+          tb_s_ct_tvalid = 1;
+
+          while (!tb_s_ct_tready)
+            #(CLK_PERIOD);
+          #(CLK_PERIOD);
+
+          tb_s_ct_tvalid = 0;
+        end
+    end
+  endtask // send_ct
+
+
+  //----------------------------------------------------------------
+  // run_aead()
+  //
+  // Process a message with the AAD and ciphertext in aad_mem and
+  // ct_mem. Both streams are presented at the same time.
+  //----------------------------------------------------------------
+  task run_aead(input [255 : 0] key, input [31 : 0] aad_len,
+                input [31 : 0] ct_len);
+    begin
+      start_aead(key, aad_len, ct_len);
+
+      fork
+        send_aad(aad_len);
+        send_ct(ct_len);
+      join
+    end
+  endtask // run_aead
+
+
+  //----------------------------------------------------------------
+  // check_tag()
+  //
+  // Wait for the tag and compare it to the expected tag given
+  // with the first byte in the most significant byte.
+  //----------------------------------------------------------------
+  task check_tag(input [127 : 0] expected);
+    begin : check_tag
+      integer i;
+      reg [127 : 0] tag;
+
+      while (!result_valid)
+        #(CLK_PERIOD);
+      result_valid = 0;
+
+      for (i = 0 ; i < 16 ; i = i + 1)
+        tag[(15 - i) * 8 +: 8] = result_tag[i * 8 +: 8];
+
+      if (tag == expected)
+        $display("*** check_tag: Correct tag generated.");
+      else begin
+        $display("*** check_tag: Error. Incorrect tag generated.");
+        $display("*** check_tag: Expected: 0x%032x", expected);
+        $display("*** check_tag: Got:      0x%032x", tag);
+        error_ctr = error_ctr + 1;
+      end
+    end
+  endtask // check_tag
+
+
+  //----------------------------------------------------------------
+  // test_rfc8439;
+  //
+  // Test case that uses the AEAD test vectors from RFC 8439,
+  // section 2.8.2. The Poly1305 key is the one generated
+  // by ChaCha20 in the test vector.
+  // https://tools.ietf.org/html/rfc8439#section-2.8.2
+  //----------------------------------------------------------------
+  task test_rfc8439;
+    begin : test_rfc8439
+      integer i;
+
+      $display("*** test_rfc8439 started.");
+      tc_ctr = tc_ctr + 1;
+
+      for (i = 0 ; i < 12 ; i = i + 1)
+        aad_mem[i] = RFC_AAD[(11 - i) * 8 +: 8];
+
+      for (i = 0 ; i < 114 ; i = i + 1)
+        ct_mem[i] = RFC_CT[(113 - i) * 8 +: 8];
+
+      run_aead(RFC_KEY, 12, 114);
+      check_tag(RFC_TAG);
+
+      $display("*** test_rfc8439 completed.\n");
+    end
+  endtask // test_rfc8439
+
+
+  //----------------------------------------------------------------
+  // test_empty;
+  //
+  // Zero length AAD and ciphertext. Only the length block
+  // is processed.
+  //----------------------------------------------------------------
+  task test_empty;
+    begin : test_empty
+      $display("*** test_empty started.");
+      tc_ctr = tc_ctr + 1;
+
+      run_aead(KEY, 0, 0);
+      check_tag(128'h268f6e95_a4b8fa01_e694ddc1_d1d3fd25);
+
+      $display("*** test_empty completed.\n");
+    end
+  endtask // test_empty
+
+
+  //----------------------------------------------------------------
+  // test_aad_only;
+  //
+  // A full block of AAD and no ciphertext.
+  //----------------------------------------------------------------
+  task test_aad_only;
+    begin : test_aad_only
+      integer i;
+
+      $display("*** test_aad_only started.");
+      tc_ctr = tc_ctr + 1;
+
+      for (i = 0 ; i < 16 ; i = i + 1)
+        aad_mem[i] = i;
+
+      run_aead(KEY, 16, 0);
+      check_tag(128'h574e95b1_b6622f37_dec34e17_02c391f8);
+
+      $display("*** test_aad_only completed.\n");
+    end
+  endtask // test_aad_only
+
+
+  //----------------------------------------------------------------
+  // test_ct_only;
+  //
+  // No AAD and 17 bytes of ciphertext, i.e. a full block
+  // followed by a block with a single byte and padding.
+  //----------------------------------------------------------------
+  task test_ct_only;
+    begin : test_ct_only
+      integer i;
+
+      $display("*** test_ct_only started.");
+      tc_ctr = tc_ctr + 1;
+
+      for (i = 0 ; i < 17 ; i = i + 1)
+        ct_mem[i] = i;
+
+      run_aead(KEY, 0, 17);
+      check_tag(128'hbee1a9dc_5c878370_8c368e98_7faa1377);
+
+      $display("*** test_ct_only completed.\n");
+    end
+  endtask // test_ct_only
+
+
+  //----------------------------------------------------------------
+  // main
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : main
+      $display("*** Testbench for poly1305_aead started ***");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      test_rfc8439();
+      test_empty();
+      test_aad_only();
+      test_ct_only();
+      test_rfc8439();
+
+      display_test_results();
+
+      $display("*** Testbench for poly1305_aead done ***");
+      $finish;
+    end // main
+
+endmodule // tb_poly1305_aead
+
+//======================================================================
+// EOF tb_poly1305_aead.v
+//======================================================================
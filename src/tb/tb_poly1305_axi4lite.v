@@ -0,0 +1,421 @@
+//======================================================================
+//
+// tb_poly1305_axi4lite.v
+// ----------------------
+// Testbench for the Poly1305 AXI4-Lite interface.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module tb_poly1305_axi4lite();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam CLK_HALF_PERIOD = 1;
+  localparam CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  // The DUT address map.
+  localparam ADDR_CTRL        = 8'h08;
+  localparam CTRL_INIT_BIT    = 0;
+  localparam CTRL_NEXT_BIT    = 1;
+  localparam CTRL_FINISH_BIT  = 2;
+
+  localparam ADDR_STATUS      = 8'h09;
+  localparam STATUS_READY_BIT = 0;
+
+  localparam ADDR_KEY0        = 8'h10;
+
+  localparam ADDR_FIFO_DATA   = 8'h24;
+  localparam ADDR_LASTLEN     = 8'h25;
+
+  localparam ADDR_MAC0        = 8'h30;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]   cycle_ctr;
+  reg [31 : 0]   error_ctr;
+  reg [31 : 0]   tc_ctr;
+  reg [31 : 0]   write_ctr;
+  reg [31 : 0]   bresp_ctr;
+
+  reg [31 : 0]   read_data;
+  reg [127 : 0]  result_mac;
+
+  reg            tb_clk;
+  reg            tb_reset_n;
+
+  reg [9 : 0]    tb_awaddr;
+  reg            tb_awvalid;
+  wire           tb_awready;
+  reg [31 : 0]   tb_wdata;
+  reg            tb_wvalid;
+  wire           tb_wready;
+  wire [1 : 0]   tb_bresp;
+  wire           tb_bvalid;
+  reg            tb_bready;
+  reg [9 : 0]    tb_araddr;
+  reg            tb_arvalid;
+  wire           tb_arready;
+  wire [31 : 0]  tb_rdata;
+  wire [1 : 0]   tb_rresp;
+  wire           tb_rvalid;
+  reg            tb_rready;
+  wire           tb_irq;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  poly1305_axi4lite dut(
+                        .clk(tb_clk),
+                        .reset_n(tb_reset_n),
+                        .s_axi_awaddr(tb_awaddr),
+                        .s_axi_awvalid(tb_awvalid),
+                        .s_axi_awready(tb_awready),
+                        .s_axi_wdata(tb_wdata),
+                        .s_axi_wstrb(4'hf),
+                        .s_axi_wvalid(tb_wvalid),
+                        .s_axi_wready(tb_wready),
+                        .s_axi_bresp(tb_bresp),
+                        .s_axi_bvalid(tb_bvalid),
+                        .s_axi_bready(tb_bready),
+                        .s_axi_araddr(tb_araddr),
+                        .s_axi_arvalid(tb_arvalid),
+                        .s_axi_arready(tb_arready),
+                        .s_axi_rdata(tb_rdata),
+                        .s_axi_rresp(tb_rresp),
+                        .s_axi_rvalid(tb_rvalid),
+                        .s_axi_rready(tb_rready),
+                        .irq(tb_irq)
+                       );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter
+  // and counts the write responses.
+  //----------------------------------------------------------------
+  always @ (posedge tb_clk)
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      if (tb_bvalid && tb_bready)
+        bresp_ctr = bresp_ctr + 1;
+    end
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("TB: Resetting dut.");
+      tb_reset_n = 0;
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      $display("");
+      if (error_ctr == 0)
+        begin
+          $display("%02d test completed. All test cases completed successfully.", tc_ctr);
+        end
+      else
+        begin
+          $display("%02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr  = 0;
+      error_ctr  = 0;
+      tc_ctr     = 0;
+      write_ctr  = 0;
+      bresp_ctr  = 0;
+
+      tb_clk     = 0;
+      tb_reset_n = 1;
+      tb_awaddr  = 10'h0;
+      tb_awvalid = 0;
+      tb_wdata   = 32'h0;
+      tb_wvalid  = 0;
+      tb_bready  = 1;
+      tb_araddr  = 10'h0;
+      tb_arvalid = 0;
+      tb_rready  = 1;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // write_word()
+  //
+  // Present a write on the address and data channels and wait
+  // until it has been accepted. The valid signals are kept
+  // asserted, which allows back-to-back writes. Call bus_idle()
+  // to end a sequence of accesses.
+  //----------------------------------------------------------------
+  task write_word(input [7 : 0] address, input [31 : 0] word);
+    begin
+      @(negedge tb_clk);
+      tb_arvalid = 0;
+      tb_awaddr  = {address, 2'h0};
+      tb_awvalid = 1;
+      tb_wdata   = word;
+      tb_wvalid  = 1;
+
+      @(posedge tb_clk);
+      while (!(tb_awready && tb_wready))
+        @(posedge tb_clk);
+      write_ctr = write_ctr + 1;
+    end
+  endtask // write_word
+
+
+  //----------------------------------------------------------------
+  // bus_idle()
+  //
+  // Deassert all valid signals.
+  //----------------------------------------------------------------
+  task bus_idle;
+    begin
+      @(negedge tb_clk);
+      tb_awvalid = 0;
+      tb_wvalid  = 0;
+      tb_arvalid = 0;
+    end
+  endtask // bus_idle
+
+
+  //----------------------------------------------------------------
+  // read_word()
+  //
+  // Read a data word from the given address in the DUT.
+  // the word read will be available in the global variable
+  // read_data.
+  //----------------------------------------------------------------
+  task read_word(input [7 : 0] address);
+    begin
+      @(negedge tb_clk);
+      tb_awvalid = 0;
+      tb_wvalid  = 0;
+      tb_araddr  = {address, 2'h0};
+      tb_arvalid = 1;
+
+      @(posedge tb_clk);
+      while (!tb_arready)
+        @(posedge tb_clk);
+
+      @(negedge tb_clk);
+      tb_arvalid = 0;
+      read_data  = tb_rdata;
+    end
+  endtask // read_word
+
+
+  //----------------------------------------------------------------
+  // read_mac()
+  //
+  // Read the four mac words using back-to-back reads.
+  //----------------------------------------------------------------
+  task read_mac;
+    begin : read_mac
+      integer i;
+      reg [7 : 0] mac_addr;
+
+      @(negedge tb_clk);
+      tb_araddr  = {ADDR_MAC0, 2'h0};
+      tb_arvalid = 1;
+
+      for (i = 0 ; i < 4 ; i = i + 1)
+        begin
+          @(posedge tb_clk);
+          while (!tb_arready)
+            @(posedge tb_clk);
+
+          @(negedge tb_clk);
+          result_mac[(3 - i) * 32 +: 32] = tb_rdata;
+          mac_addr  = ADDR_MAC0 + i + 1;
+          tb_araddr = {mac_addr, 2'h0};
+          if (i == 3)
+            tb_arvalid = 0;
+        end
+    end
+  endtask // read_mac
+
+
+  //----------------------------------------------------------------
+  // wait_ready()
+  //
+  // Wait for the ready flag to be set in dut.
+  //----------------------------------------------------------------
+  task wait_ready;
+    begin : wready
+      read_word(ADDR_STATUS);
+      while (read_data[STATUS_READY_BIT] == 0)
+        read_word(ADDR_STATUS);
+    end
+  endtask // wait_ready
+
+
+  //----------------------------------------------------------------
+  // test_rfc8439;
+  //
+  // The RFC 8439 test case with the key and message written
+  // using back-to-back writes.
+  //----------------------------------------------------------------
+  task test_rfc8439;
+    begin : test_rfc8439
+      reg [31 : 0] start_cycle;
+
+      $display("*** test_rfc8439 started.");
+      tc_ctr = tc_ctr + 1;
+
+      start_cycle = cycle_ctr;
+      write_word(ADDR_KEY0 + 0, 32'h85d6be78);
+      write_word(ADDR_KEY0 + 1, 32'h57556d33);
+      write_word(ADDR_KEY0 + 2, 32'h7f4452fe);
+      write_word(ADDR_KEY0 + 3, 32'h42d506a8);
+      write_word(ADDR_KEY0 + 4, 32'h0103808a);
+      write_word(ADDR_KEY0 + 5, 32'hfb0db2fd);
+      write_word(ADDR_KEY0 + 6, 32'h4abff6af);
+      write_word(ADDR_KEY0 + 7, 32'h4149f51b);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      bus_idle();
+      $display("*** test_rfc8439: Key and init written in %0d cycles.",
+               cycle_ctr - start_cycle);
+      wait_ready();
+
+      write_word(ADDR_FIFO_DATA, 32'h43727970);
+      write_word(ADDR_FIFO_DATA, 32'h746f6772);
+      write_word(ADDR_FIFO_DATA, 32'h61706869);
+      write_word(ADDR_FIFO_DATA, 32'h6320466f);
+      write_word(ADDR_FIFO_DATA, 32'h72756d20);
+      write_word(ADDR_FIFO_DATA, 32'h52657365);
+      write_word(ADDR_FIFO_DATA, 32'h61726368);
+      write_word(ADDR_FIFO_DATA, 32'h2047726f);
+      write_word(ADDR_FIFO_DATA, 32'h75700000);
+      write_word(ADDR_LASTLEN, 32'h2);
+      bus_idle();
+      wait_ready();
+
+      write_word(ADDR_CTRL, (32'h1 << CTRL_FINISH_BIT));
+      bus_idle();
+      wait_ready();
+
+      read_mac();
+      if (result_mac == 128'ha8061dc1_305136c6_c22b8baf_0c0127a9)
+        $display("*** test_rfc8439: Correct MAC generated.");
+      else begin
+        $display("*** test_rfc8439: Error. Incorrect MAC generated.");
+        $display("*** test_rfc8439: Expected: 0xa8061dc1_305136c6_c22b8baf_0c0127a9");
+        $display("*** test_rfc8439: Got:      0x%032x", result_mac);
+        error_ctr = error_ctr + 1;
+      end
+
+      #(4 * CLK_PERIOD);
+      if (bresp_ctr != write_ctr)
+        begin
+          $display("*** test_rfc8439: Error. %0d writes but %0d write responses.",
+                   write_ctr, bresp_ctr);
+          error_ctr = error_ctr + 1;
+        end
+
+      $display("*** test_rfc8439 completed.\n");
+    end
+  endtask // test_rfc8439
+
+
+  //----------------------------------------------------------------
+  // main
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : main
+      $display("*** Testbench for poly1305_axi4lite started ***");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      test_rfc8439();
+
+      display_test_results();
+
+      $display("*** Testbench for poly1305_axi4lite done ***");
+      $finish;
+    end // main
+
+endmodule // tb_poly1305_axi4lite
+
+//======================================================================
+// EOF tb_poly1305_axi4lite.v
+//======================================================================
@@ -43,6 +43,8 @@ module tb_poly1305_core();
   //----------------------------------------------------------------
   // Internal constant and parameter definitions.
   //----------------------------------------------------------------
+  parameter DUMP_VCD = 0;
+
   localparam CLK_HALF_PERIOD = 1;
   localparam CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
 
@@ -57,6 +59,8 @@ module tb_poly1305_core();
 
   reg [31 : 0]   read_data;
   reg [127 : 0]  result_data;
+  reg [415 : 0]  saved_ctx;
+  reg [31 : 0]   tb_vcd_bytes;
 
   reg            tb_debug;
   reg            tb_pblock;
@@ -66,11 +70,17 @@ module tb_poly1305_core();
   reg            tb_reset_n;
   reg            tb_init;
   reg            tb_next;
+  reg            tb_last;
   reg            tb_finish;
+  reg            tb_restore;
   wire           tb_ready;
   reg [255 : 0]  tb_key;
+  reg            tb_chain;
+  reg [255 : 0]  tb_chain_key;
   reg [127 : 0]  tb_block;
   reg [4: 0]     tb_blocklen;
+  reg [415 : 0]  tb_ctx_in;
+  wire [415 : 0] tb_ctx;
   wire [127 : 0] tb_mac;
 
 
@@ -82,11 +92,19 @@ module tb_poly1305_core();
                     .reset_n(tb_reset_n),
                     .init(tb_init),
                     .next(tb_next),
+                    .last(tb_last),
                     .finish(tb_finish),
+                    .restore(tb_restore),
                     .ready(tb_ready),
+                    .pblock_busy(),
+                    .final_busy(),
                     .key(tb_key),
+                    .chain(tb_chain),
+                    .chain_key(tb_chain_key),
                     .block(tb_block),
                     .blocklen(tb_blocklen),
+                    .ctx_in(tb_ctx_in),
+                    .ctx(tb_ctx),
                     .mac(tb_mac)
                    );
 
@@ -168,48 +186,48 @@ module tb_poly1305_core();
           $display("");
           $display("pblock state:");
           $display("-------------");
-          $display("start: 0x%01x, ready: 0x%01x", dut.pblock_inst.start,
-                   dut.pblock_inst.ready);
-          $display("ctrl: 0x%01x", dut.pblock_inst.pblock_ctrl_reg);
+          $display("start: 0x%01x, ready: 0x%01x", dut.pblock_gen.pblock_inst.start,
+                   dut.pblock_gen.pblock_inst.ready);
+          $display("ctrl: 0x%01x", dut.pblock_gen.pblock_inst.pblock_ctrl_reg);
           $display("mulacc_start: 0x%01x  mulacc0_ready: ",
-                   dut.pblock_inst.mulacc_start,
-                   dut.pblock_inst.mulacc0_ready);
+                   dut.pblock_gen.pblock_inst.mulacc_start,
+                   dut.pblock_gen.pblock_inst.mulacc0_ready);
           $display("cycle_ctr: 0x%01x  ctr_rst: 0x%01x  ctr_inc: 0x%01x",
-                   dut.pblock_inst.cycle_ctr_reg, dut.pblock_inst.cycle_ctr_rst,
-                   dut.pblock_inst.cycle_ctr_inc);
+                   dut.pblock_gen.pblock_inst.cycle_ctr_reg, dut.pblock_gen.pblock_inst.cycle_ctr_rst,
+                   dut.pblock_gen.pblock_inst.cycle_ctr_inc);
           $display("");
 
           $display("s0: 0x%016x  s1: 0x%016x  s2: 0x%016x",
-                   dut.pblock_inst.s0_reg, dut.pblock_inst.s1_reg,
-                   dut.pblock_inst.s2_reg);
+                   dut.pblock_gen.pblock_inst.s0_reg, dut.pblock_gen.pblock_inst.s1_reg,
+                   dut.pblock_gen.pblock_inst.s2_reg);
           $display("s3: 0x%016x  s4: 0x%016x",
-                   dut.pblock_inst.s3_reg, dut.pblock_inst.s4_reg);
+                   dut.pblock_gen.pblock_inst.s3_reg, dut.pblock_gen.pblock_inst.s4_reg);
           $display("");
 
           $display("rr0: 0x%08x  rr1: 0x%08x  rr2: 0x%08x  rr3: 0x%08x",
-                   dut.pblock_inst.rr0_reg, dut.pblock_inst.rr1_reg,
-                   dut.pblock_inst.rr2_reg, dut.pblock_inst.rr3_reg);
+                   dut.pblock_gen.pblock_inst.rr0_reg, dut.pblock_gen.pblock_inst.rr1_reg,
+                   dut.pblock_gen.pblock_inst.rr2_reg, dut.pblock_gen.pblock_inst.rr3_reg);
           $display("");
 
           $display("x0:  0x%016x  x1: 0x%016x  x2: 0x%016x",
-                   dut.pblock_inst.x0_new, dut.pblock_inst.x1_new,
-                   dut.pblock_inst.x2_new);
+                   dut.pblock_gen.pblock_inst.x0_new, dut.pblock_gen.pblock_inst.x1_new,
+                   dut.pblock_gen.pblock_inst.x2_new);
           $display("x3:  0x%016x  x4: 0x%016x",
-                   dut.pblock_inst.x3_new, dut.pblock_inst.x4_reg);
+                   dut.pblock_gen.pblock_inst.x3_new, dut.pblock_gen.pblock_inst.x4_reg);
           $display("");
 
           $display("u0:  0x%016x  u1: 0x%016x u2: 0x%016x",
-                   dut.pblock_inst.u0_reg, dut.pblock_inst.u1_reg,
-                   dut.pblock_inst.u2_reg);
+                   dut.pblock_gen.pblock_inst.u0_reg, dut.pblock_gen.pblock_inst.u1_reg,
+                   dut.pblock_gen.pblock_inst.u2_reg);
           $display("u3:  0x%016x  u4: 0x%016x u5: 0x%08x",
-                   dut.pblock_inst.u3_reg, dut.pblock_inst.u4_reg,
-                   dut.pblock_inst.u5_reg);
+                   dut.pblock_gen.pblock_inst.u3_reg, dut.pblock_gen.pblock_inst.u4_reg,
+                   dut.pblock_gen.pblock_inst.u5_reg);
           $display("");
 
           $display("h0: 0x%08x  h1: 0x%08x  h2: 0x%08x  h3: 0x%08x  h4: 0x%08x",
-                   dut.pblock_inst.h0_new, dut.pblock_inst.h1_new,
-                   dut.pblock_inst.h2_new, dut.pblock_inst.h3_new,
-                   dut.pblock_inst.h4_new);
+                   dut.pblock_gen.pblock_inst.h0_new, dut.pblock_gen.pblock_inst.h1_new,
+                   dut.pblock_gen.pblock_inst.h2_new, dut.pblock_gen.pblock_inst.h3_new,
+                   dut.pblock_gen.pblock_inst.h4_new);
         end
 
 
@@ -290,20 +308,26 @@ module tb_poly1305_core();
   //----------------------------------------------------------------
   task init_sim;
     begin
-      cycle_ctr   = 0;
-      error_ctr   = 0;
-      tc_ctr      = 0;
-      tb_clk      = 0;
-      tb_debug    = 0;
-      tb_pblock   = 0;
-      tb_final    = 0;
-      tb_reset_n  = 1;
-      tb_init     = 0;
-      tb_next     = 0;
-      tb_finish   = 0;
-      tb_key      = 256'h0;
-      tb_block    = 128'h0;
-      tb_blocklen = 5'h0;
+      cycle_ctr    = 0;
+      error_ctr    = 0;
+      tc_ctr       = 0;
+      tb_clk       = 0;
+      tb_debug     = 0;
+      tb_pblock    = 0;
+      tb_final     = 0;
+      tb_reset_n   = 1;
+      tb_init      = 0;
+      tb_next      = 0;
+      tb_last      = 0;
+      tb_finish    = 0;
+      tb_restore   = 0;
+      tb_key       = 256'h0;
+      tb_chain     = 0;
+      tb_chain_key = 256'h0;
+      tb_block     = 128'h0;
+      tb_blocklen  = 5'h0;
+      tb_ctx_in    = 416'h0;
+      tb_vcd_bytes = 32'h0;
     end
   endtask // init_sim
 
@@ -450,6 +474,262 @@ module tb_poly1305_core();
   endtask // test_rfc8439
 
 
+  //----------------------------------------------------------------
+  // test_last;
+  //
+  // The RFC 8439 test vector and the 0 byte message processed
+  // with last set for the final next(), without finish().
+  //----------------------------------------------------------------
+  task test_last;
+    begin : test_last
+      $display("*** test_last started.\n");
+      inc_tc_ctr();
+
+      tb_key   = 256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b;
+      tb_block = 128'h0;
+      #(2 * CLK_PERIOD);
+
+      tb_init = 1;
+      #(CLK_PERIOD);
+      tb_init = 0;
+      wait_ready();
+
+      tb_block    = 128'h43727970_746f6772_61706869_6320466f;
+      tb_blocklen = 5'h10;
+      tb_next     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      wait_ready();
+
+      tb_block    = 128'h72756d20_52657365_61726368_2047726f;
+      tb_blocklen = 5'h10;
+      tb_next     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      wait_ready();
+
+      $display("*** test_last: Running next() with last for the final 2 bytes.");
+      tb_block    = 128'h75700000_00000000_00000000_00000000;
+      tb_blocklen = 5'h02;
+      tb_next     = 1;
+      tb_last     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      tb_last = 0;
+      wait_ready();
+
+      if (tb_mac == 128'ha8061dc1_305136c6_c22b8baf_0c0127a9)
+        $display("*** test_last: Correct MAC generated.");
+      else begin
+        $display("*** test_last: Error. Incorrect MAC generated.");
+        $display("*** test_last: Expected: 0xa8061dc1_305136c6_c22b8baf_0c0127a9");
+        $display("*** test_last: Got:      0x%032x", tb_mac);
+        error_ctr = error_ctr + 1;
+      end
+
+      tb_init = 1;
+      #(CLK_PERIOD);
+      tb_init = 0;
+      wait_ready();
+
+      $display("*** test_last: Running next() with last for a 0 byte message.");
+      tb_block    = 128'h0;
+      tb_blocklen = 5'h00;
+      tb_next     = 1;
+      tb_last     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      tb_last = 0;
+      wait_ready();
+
+      if (tb_mac == 128'h0103808afb0db2fd4abff6af4149f51b)
+        $display("*** test_last: Correct MAC generated.");
+      else begin
+        $display("*** test_last: Error. Incorrect MAC generated.");
+        $display("*** test_last: Expected: 0x0103808afb0db2fd4abff6af4149f51b");
+        $display("*** test_last: Got:      0x%032x", tb_mac);
+        error_ctr = error_ctr + 1;
+      end
+
+      $display("*** test_last completed.\n");
+    end
+  endtask // test_last
+
+
+  //----------------------------------------------------------------
+  // test_chain;
+  //
+  // A 0 byte message followed by the RFC 8439 test vector with
+  // chain set. The core is initialized with the chain key when
+  // the final processing of the first message is completed,
+  // and the second message is processed without init().
+  //----------------------------------------------------------------
+  task test_chain;
+    begin : test_chain
+      $display("*** test_chain started.\n");
+      inc_tc_ctr();
+
+      tb_key       = 256'hf3000000_00000000_00000000_0000003f_3f000000_00000000_00000000_000000f3;
+      tb_chain_key = 256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b;
+      tb_block     = 128'h0;
+      #(2 * CLK_PERIOD);
+
+      tb_init = 1;
+      #(CLK_PERIOD);
+      tb_init = 0;
+      wait_ready();
+
+      $display("*** test_chain: Running next() with last and chain for a 0 byte message.");
+      tb_chain    = 1;
+      tb_block    = 128'h0;
+      tb_blocklen = 5'h00;
+      tb_next     = 1;
+      tb_last     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      tb_last = 0;
+      wait_ready();
+      tb_chain = 0;
+
+      if (tb_mac == 128'h3f000000_00000000_00000000_000000f3)
+        $display("*** test_chain: Correct MAC generated.");
+      else begin
+        $display("*** test_chain: Error. Incorrect MAC generated.");
+        $display("*** test_chain: Expected: 0x3f000000_00000000_00000000_000000f3");
+        $display("*** test_chain: Got:      0x%032x", tb_mac);
+        error_ctr = error_ctr + 1;
+      end
+
+      $display("*** test_chain: Processing the RFC 8439 message without init().");
+      tb_block    = 128'h43727970_746f6772_61706869_6320466f;
+      tb_blocklen = 5'h10;
+      tb_next     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      wait_ready();
+
+      tb_block    = 128'h72756d20_52657365_61726368_2047726f;
+      tb_blocklen = 5'h10;
+      tb_next     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      wait_ready();
+
+      tb_block    = 128'h75700000_00000000_00000000_00000000;
+      tb_blocklen = 5'h02;
+      tb_next     = 1;
+      tb_last     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      tb_last = 0;
+      wait_ready();
+
+      if (tb_mac == 128'ha8061dc1_305136c6_c22b8baf_0c0127a9)
+        $display("*** test_chain: Correct MAC generated.");
+      else begin
+        $display("*** test_chain: Error. Incorrect MAC generated.");
+        $display("*** test_chain: Expected: 0xa8061dc1_305136c6_c22b8baf_0c0127a9");
+        $display("*** test_chain: Got:      0x%032x", tb_mac);
+        error_ctr = error_ctr + 1;
+      end
+
+      $display("*** test_chain completed.\n");
+    end
+  endtask // test_chain
+
+
+  //----------------------------------------------------------------
+  // test_ctx;
+  //
+  // The RFC 8439 message interrupted by a 0 byte message with
+  // another key. The context is saved after the first block
+  // and restored before the remaining blocks are processed.
+  //----------------------------------------------------------------
+  task test_ctx;
+    begin : test_ctx
+      $display("*** test_ctx started.\n");
+      inc_tc_ctr();
+
+      tb_key = 256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b;
+      tb_init = 1;
+      #(CLK_PERIOD);
+      tb_init = 0;
+      wait_ready();
+
+      tb_block    = 128'h43727970_746f6772_61706869_6320466f;
+      tb_blocklen = 5'h10;
+      tb_next     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      wait_ready();
+
+      $display("*** test_ctx: Saving the context and processing a 0 byte message.");
+      saved_ctx = tb_ctx;
+
+      tb_key = 256'hf3000000_00000000_00000000_0000003f_3f000000_00000000_00000000_000000f3;
+      tb_init = 1;
+      #(CLK_PERIOD);
+      tb_init = 0;
+      wait_ready();
+
+      tb_block    = 128'h0;
+      tb_blocklen = 5'h00;
+      tb_next     = 1;
+      tb_last     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      tb_last = 0;
+      wait_ready();
+
+      if (tb_mac != 128'h3f000000_00000000_00000000_000000f3)
+        begin
+          $display("*** test_ctx: Error. Incorrect MAC for the 0 byte message.");
+          error_ctr = error_ctr + 1;
+        end
+
+      $display("*** test_ctx: Restoring the context and processing the remaining blocks.");
+      tb_ctx_in  = saved_ctx;
+      tb_restore = 1;
+      #(CLK_PERIOD);
+      tb_restore = 0;
+      wait_ready();
+
+      if (tb_ctx != saved_ctx)
+        begin
+          $display("*** test_ctx: Error. Context not restored.");
+          error_ctr = error_ctr + 1;
+        end
+
+      tb_block    = 128'h72756d20_52657365_61726368_2047726f;
+      tb_blocklen = 5'h10;
+      tb_next     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      wait_ready();
+
+      tb_block    = 128'h75700000_00000000_00000000_00000000;
+      tb_blocklen = 5'h02;
+      tb_next     = 1;
+      tb_last     = 1;
+      #(CLK_PERIOD);
+      tb_next = 0;
+      tb_last = 0;
+      wait_ready();
+
+      if (tb_mac == 128'ha8061dc1_305136c6_c22b8baf_0c0127a9)
+        $display("*** test_ctx: Correct MAC generated.");
+      else begin
+        $display("*** test_ctx: Error. Incorrect MAC generated.");
+        $display("*** test_ctx: Expected: 0xa8061dc1_305136c6_c22b8baf_0c0127a9");
+        $display("*** test_ctx: Got:      0x%032x", tb_mac);
+        error_ctr = error_ctr + 1;
+      end
+
+      $display("*** test_ctx completed.\n");
+    end
+  endtask // test_ctx
+
+
   //----------------------------------------------------------------
   // test_p1305_bytes0;
   //
@@ -1522,6 +1802,30 @@ module tb_poly1305_core();
   endtask // testcase_long
 
 
+  //----------------------------------------------------------------
+  // test_toggles;
+  //
+  // Dump the DUT signals to a VCD file while processing the long
+  // message. The number of message bytes is dumped in tb_vcd_bytes
+  // to allow the toggles per byte to be calculated from the file.
+  //----------------------------------------------------------------
+  task test_toggles;
+    begin : test_toggles
+      $display("*** test_toggles: Dumping DUT signals to tb_poly1305_core.vcd.");
+      $dumpfile("tb_poly1305_core.vcd");
+      $dumpvars(0, dut);
+      $dumpvars(0, tb_vcd_bytes);
+
+      testcase_long();
+      tb_vcd_bytes = 32'd1025;
+      #(CLK_PERIOD);
+
+      $dumpoff;
+      $display("*** test_toggles completed.\n");
+    end
+  endtask // test_toggles
+
+
   //----------------------------------------------------------------
   // main
   //
@@ -1556,6 +1860,12 @@ module tb_poly1305_core();
       testcase_11();
       testcase_12();
       testcase_long();
+      test_last();
+      test_chain();
+      test_ctx();
+
+      if (DUMP_VCD)
+        test_toggles();
 
       display_test_results();
 
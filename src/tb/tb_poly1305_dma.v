@@ -0,0 +1,532 @@
+//======================================================================
+//
+// tb_poly1305_dma.v
+// -----------------
+// Testbench for the Poly1305 descriptor DMA engine.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module tb_poly1305_dma();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter DEBUG = 0;
+
+  localparam CLK_HALF_PERIOD = 1;
+  localparam CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  // The DUT address map.
+  localparam ADDR_CTRL        = 8'h08;
+  localparam CTRL_ENABLE_BIT  = 0;
+  localparam CTRL_IRQ_ACK_BIT = 1;
+
+  localparam ADDR_STATUS      = 8'h09;
+  localparam STATUS_IDLE_BIT  = 0;
+  localparam STATUS_DONE_BIT  = 1;
+
+  localparam ADDR_RING_BASE   = 8'h10;
+  localparam ADDR_RING_SIZE   = 8'h11;
+  localparam ADDR_RING_HEAD   = 8'h12;
+  localparam ADDR_RING_TAIL   = 8'h13;
+
+  // Memory layout used by the tests.
+  localparam MEM_WORDS        = 1024;
+  localparam RING_BASE        = 32'h000;
+  localparam RING_SIZE        = 4;
+  localparam KEY_BASE         = 32'h100;
+  localparam MSG_BASE         = 32'h200;
+  localparam TAG_BASE         = 32'h800;
+
+  localparam RFC_KEY = 256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]  cycle_ctr;
+  reg [31 : 0]  error_ctr;
+  reg [31 : 0]  tc_ctr;
+  reg [31 : 0]  mem_access_ctr;
+
+  reg [31 : 0]  read_data;
+
+  reg           tb_debug;
+
+  reg           tb_clk;
+  reg           tb_reset_n;
+  reg           tb_cs;
+  reg           tb_we;
+  reg [7 : 0]   tb_address;
+  reg [31 : 0]  tb_write_data;
+  wire [31 : 0] tb_read_data;
+  wire          tb_irq;
+
+  wire          tb_mem_cs;
+  wire          tb_mem_we;
+  wire [31 : 0] tb_mem_address;
+  wire [31 : 0] tb_mem_write_data;
+  reg [31 : 0]  tb_mem_read_data;
+  reg           tb_mem_ready;
+
+  reg [31 : 0]  mem [0 : (MEM_WORDS - 1)];
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  poly1305_dma dut(
+                   .clk(tb_clk),
+                   .reset_n(tb_reset_n),
+                   .cs(tb_cs),
+                   .we(tb_we),
+                   .address(tb_address),
+                   .write_data(tb_write_data),
+                   .read_data(tb_read_data),
+                   .irq(tb_irq),
+                   .mem_cs(tb_mem_cs),
+                   .mem_we(tb_mem_we),
+                   .mem_address(tb_mem_address),
+                   .mem_write_data(tb_mem_write_data),
+                   .mem_read_data(tb_mem_read_data),
+                   .mem_ready(tb_mem_ready)
+                  );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // mem_model
+  //
+  // Behavioral memory with little endian 32-bit words. Each
+  // access is acknowledged with ready in the cycle after the
+  // request, with read data valid when ready is set.
+  //----------------------------------------------------------------
+  always @ (posedge tb_clk)
+    begin : mem_model
+      if (tb_mem_cs && !tb_mem_ready)
+        begin
+          if (tb_mem_we)
+            mem[tb_mem_address[11 : 2]] <= tb_mem_write_data;
+
+          tb_mem_read_data <= mem[tb_mem_address[11 : 2]];
+          tb_mem_ready     <= 1'h1;
+          mem_access_ctr   = mem_access_ctr + 1;
+        end
+      else
+        tb_mem_ready <= 1'h0;
+    end // mem_model
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always @ (posedge tb_clk)
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      if (tb_debug)
+        dump_dut_state();
+    end
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dut.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("cycle: 0x%016x", cycle_ctr);
+      $display("dma_ctrl: 0x%01x, word_ctr: 0x%01x, tail: 0x%08x",
+               dut.dma_ctrl_reg, dut.word_ctr_reg, dut.ring_tail_reg);
+      $display("msg_addr: 0x%08x, msg_len: 0x%08x",
+               dut.msg_addr_reg, dut.msg_len_reg);
+      $display("mem_cs: 0x%01x, mem_we: 0x%01x, mem_address: 0x%08x, mem_ready: 0x%01x",
+               tb_mem_cs, tb_mem_we, tb_mem_address, tb_mem_ready);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("TB: Resetting dut.");
+      tb_reset_n = 0;
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      $display("");
+      if (error_ctr == 0)
+        begin
+          $display("%02d test completed. All test cases completed successfully.", tc_ctr);
+        end
+      else
+        begin
+          $display("%02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin : init_sim
+      integer i;
+
+      cycle_ctr        = 0;
+      error_ctr        = 0;
+      tc_ctr           = 0;
+      mem_access_ctr   = 0;
+      tb_debug         = DEBUG;
+
+      tb_clk           = 0;
+      tb_reset_n       = 1;
+      tb_cs            = 0;
+      tb_we            = 0;
+      tb_address       = 8'h0;
+      tb_write_data    = 32'h0;
+      tb_mem_read_data = 32'h0;
+      tb_mem_ready     = 0;
+
+      for (i = 0 ; i < MEM_WORDS ; i = i + 1)
+        mem[i] = 32'h0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // read_word()
+  //
+  // Read a data word from the given address in the DUT.
+  // the word read will be available in the global variable
+  // read_data.
+  //----------------------------------------------------------------
+  task read_word(input [7 : 0]  address);
+    begin
+      tb_address = address;
+      tb_cs = 1;
+      tb_we = 0;
+      #(CLK_PERIOD);
+      read_data = tb_read_data;
+      tb_cs = 0;
+    end
+  endtask // read_word
+
+
+  //----------------------------------------------------------------
+  // write_word()
+  //
+  // Write the given word to the DUT using the DUT interface.
+  //----------------------------------------------------------------
+  task write_word(input [7 : 0] address,
+                  input [31 : 0] word);
+    begin
+      tb_address = address;
+      tb_write_data = word;
+      tb_cs = 1;
+      tb_we = 1;
+      #(CLK_PERIOD);
+      tb_cs = 0;
+      tb_we = 0;
+    end
+  endtask // write_word
+
+
+  //----------------------------------------------------------------
+  // mem_write_byte()
+  // mem_read_byte()
+  //
+  // Backdoor access to bytes in the memory model.
+  //----------------------------------------------------------------
+  task mem_write_byte(input [31 : 0] address, input [7 : 0] data);
+    begin
+      mem[address[11 : 2]][address[1 : 0] * 8 +: 8] = data;
+    end
+  endtask // mem_write_byte
+
+  function [7 : 0] mem_read_byte(input [31 : 0] address);
+    begin
+      mem_read_byte = mem[address[11 : 2]][address[1 : 0] * 8 +: 8];
+    end
+  endfunction // mem_read_byte
+
+
+  //----------------------------------------------------------------
+  // write_key()
+  //
+  // Write the given key to memory, first byte in the MSB.
+  //----------------------------------------------------------------
+  task write_key(input [31 : 0] address, input [255 : 0] key);
+    begin : write_key
+      integer i;
+
+      for (i = 0 ; i < 32 ; i = i + 1)
+        mem_write_byte(address + i, key[(31 - i) * 8 +: 8]);
+    end
+  endtask // write_key
+
+
+  //----------------------------------------------------------------
+  // write_desc()
+  //
+  // Write a descriptor at the given index in the ring.
+  //----------------------------------------------------------------
+  task write_desc(input [31 : 0] index, input [31 : 0] key_addr,
+                  input [31 : 0] msg_addr, input [31 : 0] msg_len,
+                  input [31 : 0] tag_addr);
+    begin : write_desc
+      reg [31 : 0] desc_addr;
+
+      desc_addr = RING_BASE + 16 * index;
+      mem[desc_addr[11 : 2] + 0] = key_addr;
+      mem[desc_addr[11 : 2] + 1] = msg_addr;
+      mem[desc_addr[11 : 2] + 2] = msg_len;
+      mem[desc_addr[11 : 2] + 3] = tag_addr;
+    end
+  endtask // write_desc
+
+
+  //----------------------------------------------------------------
+  // wait_idle()
+  //
+  // Wait for the DMA engine to process all descriptors.
+  //----------------------------------------------------------------
+  task wait_idle;
+    begin
+      read_word(ADDR_STATUS);
+      while (!read_data[STATUS_IDLE_BIT])
+        read_word(ADDR_STATUS);
+    end
+  endtask // wait_idle
+
+
+  //----------------------------------------------------------------
+  // check_tag()
+  //
+  // Check the tag written to memory at the given address.
+  //----------------------------------------------------------------
+  task check_tag(input [31 : 0] address, input [127 : 0] expected);
+    begin : check_tag
+      integer i;
+      reg [127 : 0] tag;
+
+      for (i = 0 ; i < 16 ; i = i + 1)
+        tag[(15 - i) * 8 +: 8] = mem_read_byte(address + i);
+
+      if (tag == expected)
+        $display("*** Correct tag at 0x%03x.", address);
+      else
+        begin
+          $display("*** Error: Incorrect tag at 0x%03x.", address);
+          $display("*** Expected: 0x%032x", expected);
+          $display("*** Got:      0x%032x", tag);
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // check_tag
+
+
+  //----------------------------------------------------------------
+  // test_rfc8439
+  //
+  // A single descriptor with the RFC 8439 test vector.
+  //----------------------------------------------------------------
+  task test_rfc8439;
+    begin : test_rfc8439
+      integer i;
+      reg [(34 * 8 - 1) : 0] msg;
+      reg [31 : 0] start_cycle;
+
+      $display("*** test_rfc8439 started.");
+      tc_ctr = tc_ctr + 1;
+
+      msg = "Cryptographic Forum Research Group";
+      for (i = 0 ; i < 34 ; i = i + 1)
+        mem_write_byte(MSG_BASE + i, msg[(33 - i) * 8 +: 8]);
+      write_key(KEY_BASE, RFC_KEY);
+      write_desc(0, KEY_BASE, MSG_BASE, 34, TAG_BASE);
+
+      write_word(ADDR_RING_BASE, RING_BASE);
+      write_word(ADDR_RING_SIZE, RING_SIZE);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_ENABLE_BIT));
+
+      start_cycle    = cycle_ctr;
+      mem_access_ctr = 0;
+      write_word(ADDR_RING_HEAD, 32'h1);
+      wait_idle();
+      $display("*** test_rfc8439: Descriptor completed in %0d cycles with %0d memory accesses.",
+               cycle_ctr - start_cycle, mem_access_ctr);
+
+      check_tag(TAG_BASE, 128'ha8061dc1_305136c6_c22b8baf_0c0127a9);
+
+      read_word(ADDR_RING_TAIL);
+      if (read_data != 32'h1)
+        begin
+          $display("*** Error: Expected tail 0x1, got 0x%08x.", read_data);
+          error_ctr = error_ctr + 1;
+        end
+
+      if (!tb_irq)
+        begin
+          $display("*** Error: Completion not signalled.");
+          error_ctr = error_ctr + 1;
+        end
+
+      // The ack must not change the enable bit.
+      write_word(ADDR_CTRL, (32'h1 << CTRL_IRQ_ACK_BIT));
+      if (tb_irq)
+        begin
+          $display("*** Error: Completion not cleared.");
+          error_ctr = error_ctr + 1;
+        end
+
+      read_word(ADDR_CTRL);
+      if (read_data != 32'h1)
+        begin
+          $display("*** Error: Enable changed by irq ack, got 0x%08x.", read_data);
+          error_ctr = error_ctr + 1;
+        end
+
+      $display("*** test_rfc8439 completed.\n");
+    end
+  endtask // test_rfc8439
+
+
+  //----------------------------------------------------------------
+  // test_ring
+  //
+  // Queue several descriptors of different lengths, including
+  // an empty message, and let the ring wrap around.
+  //----------------------------------------------------------------
+  task test_ring;
+    begin : test_ring
+      integer i;
+
+      $display("*** test_ring started.");
+      tc_ctr = tc_ctr + 1;
+
+      // Messages with bytes 0, 1, 2, ... at MSG_BASE + 0x100.
+      for (i = 0 ; i < 100 ; i = i + 1)
+        mem_write_byte(MSG_BASE + 32'h100 + i, i);
+
+      write_desc(1, KEY_BASE, MSG_BASE + 32'h100, 0,   TAG_BASE + 32'h10);
+      write_desc(2, KEY_BASE, MSG_BASE + 32'h100, 64,  TAG_BASE + 32'h20);
+      write_desc(3, KEY_BASE, MSG_BASE + 32'h100, 100, TAG_BASE + 32'h30);
+      write_word(ADDR_RING_HEAD, 32'h0);
+      wait_idle();
+
+      check_tag(TAG_BASE + 32'h10, 128'h0103808a_fb0db2fd_4abff6af_4149f51b);
+      check_tag(TAG_BASE + 32'h20, 128'h2a7bebad_ae829f59_5bbde2cb_6cca72a9);
+      check_tag(TAG_BASE + 32'h30, 128'h86ba671d_3e1ce7fd_a7753225_5698e77b);
+
+      write_desc(0, KEY_BASE, MSG_BASE, 34, TAG_BASE + 32'h40);
+      write_word(ADDR_RING_HEAD, 32'h1);
+      wait_idle();
+
+      check_tag(TAG_BASE + 32'h40, 128'ha8061dc1_305136c6_c22b8baf_0c0127a9);
+
+      read_word(ADDR_RING_TAIL);
+      if (read_data != 32'h1)
+        begin
+          $display("*** Error: Expected tail 0x1, got 0x%08x.", read_data);
+          error_ctr = error_ctr + 1;
+        end
+
+      $display("*** test_ring completed.\n");
+    end
+  endtask // test_ring
+
+
+  //----------------------------------------------------------------
+  // main
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : main
+      $display("*** Testbench for poly1305_dma started ***");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      test_rfc8439();
+      test_ring();
+
+      display_test_results();
+
+      $display("*** Testbench for poly1305_dma done ***");
+      $finish;
+    end // main
+
+endmodule // tb_poly1305_dma
+
+//======================================================================
+// EOF tb_poly1305_dma.v
+//======================================================================
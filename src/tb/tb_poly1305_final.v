@@ -48,6 +48,7 @@ module tb_poly1305_final();
   //----------------------------------------------------------------
   parameter DEBUG     = 0;
   parameter DUMP_WAIT = 0;
+  parameter LATENCY   = 0;
 
   parameter CLK_HALF_PERIOD = 1;
   parameter CLK_PERIOD = 2 * CLK_HALF_PERIOD;
@@ -89,7 +90,7 @@ module tb_poly1305_final();
   //----------------------------------------------------------------
   // Device Under Test.
   //----------------------------------------------------------------
-  poly1305_final dut(
+  poly1305_final #(.LATENCY(LATENCY)) dut(
                      .clk(tb_clk),
                      .reset_n(tb_reset_n),
 
@@ -175,6 +176,7 @@ module tb_poly1305_final();
                dut.u3_reg, dut.u4_reg);
       $display("uu0:  0x%016x  uu1: 0x%016x", dut.uu0_reg, dut.uu1_reg);
       $display("uu2:  0x%016x  uu3: 0x%016x", dut.uu2_reg, dut.uu3_reg);
+      $display("q:    0x%01x  res: 0x%032x", dut.q_reg, dut.res_reg);
 
       $display("=====================================================");
       $display("\n");
@@ -405,6 +407,95 @@ module tb_poly1305_final();
   endtask // test_bytes16
 
 
+  //----------------------------------------------------------------
+  // reduce_vector;
+  //
+  // Run the final processing for the given h and s and check the
+  // result.
+  //----------------------------------------------------------------
+  task reduce_vector(input [159 : 0] h, input [127 : 0] s,
+                     input [127 : 0] expected);
+    begin : reduce_vector
+      reg [127 : 0] hres;
+
+      tb_h0 = h[031 : 000];
+      tb_h1 = h[063 : 032];
+      tb_h2 = h[095 : 064];
+      tb_h3 = h[127 : 096];
+      tb_h4 = h[159 : 128];
+
+      tb_s0 = s[031 : 000];
+      tb_s1 = s[063 : 032];
+      tb_s2 = s[095 : 064];
+      tb_s3 = s[127 : 096];
+
+      #(2 * CLK_PERIOD);
+      tb_start = 1;
+      #(1 * CLK_PERIOD);
+      tb_start = 0;
+      wait_ready();
+      #(2 * CLK_PERIOD);
+
+      hres = {tb_hres3, tb_hres2, tb_hres1, tb_hres0};
+      if (hres != expected)
+        begin
+          $display("Error for h: 0x%040x. Expected: 0x%032x. Got: 0x%032x",
+                   h, expected, hres);
+          incorrect = incorrect + 1;
+        end
+    end
+  endtask // reduce_vector
+
+
+  //----------------------------------------------------------------
+  // test_reduce;
+  //
+  // Test cases for h around 2^130 - 5 where the result must
+  // be reduced, including carries through all lanes.
+  //----------------------------------------------------------------
+  task test_reduce;
+    begin : test_reduce
+      $display("*** test_reduce started.\n");
+
+      tc_ctr = tc_ctr + 1;
+      incorrect = 0;
+
+      // h = 2^130 - 5.
+      reduce_vector(160'h00000003_ffffffff_ffffffff_ffffffff_fffffffb,
+                    128'h00000004_00000003_00000002_00000001,
+                    128'h00000004_00000003_00000002_00000001);
+
+      // h = 2^130 - 6.
+      reduce_vector(160'h00000003_ffffffff_ffffffff_ffffffff_fffffffa,
+                    128'h00000004_00000003_00000002_00000001,
+                    128'h00000004_00000003_00000001_fffffffb);
+
+      // h = 2^130 - 5, s with all bits set.
+      reduce_vector(160'h00000003_ffffffff_ffffffff_ffffffff_fffffffb,
+                    128'hffffffff_ffffffff_ffffffff_ffffffff,
+                    128'hffffffff_ffffffff_ffffffff_ffffffff);
+
+      // h = 2^130.
+      reduce_vector(160'h00000004_00000000_00000000_00000000_00000000,
+                    128'hffffffff_ffffffff_ffffffff_ffffffff,
+                    128'h00000000_00000000_00000000_00000004);
+
+      // h = 2^130 + 2^128 - 1, carry of two between the lanes.
+      reduce_vector(160'h00000004_ffffffff_ffffffff_ffffffff_ffffffff,
+                    128'hffffffff_ffffffff_ffffffff_ffffffff,
+                    128'h00000000_00000000_00000000_00000003);
+
+      if (!incorrect)
+        $display("*** test_reduce successfully completed.\n");
+      else
+        begin
+          $display("*** test_reduce completed with %d errors.\n", incorrect);
+          error_ctr = error_ctr + 1;
+        end
+    end
+  endtask // test_reduce
+
+
   //----------------------------------------------------------------
   // poly1305_final_test
   //----------------------------------------------------------------
@@ -420,6 +511,7 @@ module tb_poly1305_final();
       // test_aa();
       test_rfc8349();
       test_bytes16();
+      test_reduce();
 
       display_test_result();
 
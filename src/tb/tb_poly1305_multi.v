@@ -0,0 +1,477 @@
+//======================================================================
+//
+// tb_poly1305_multi.v
+// -------------------
+// Testbench for the Poly1305 multi core version.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module tb_poly1305_multi();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  parameter NUM_CORES = 4;
+  parameter IN_ORDER  = 1;
+
+  localparam NUM_JOBS        = 16;
+
+  localparam CLK_HALF_PERIOD = 1;
+  localparam CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  localparam RFC_KEY = 256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b;
+  localparam RFC_TAG = 128'ha8061dc1_305136c6_c22b8baf_0c0127a9;
+  localparam NUL_TAG = 128'h0103808a_fb0db2fd_4abff6af_4149f51b;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]   cycle_ctr;
+  reg [31 : 0]   error_ctr;
+  reg [31 : 0]   tc_ctr;
+
+  reg [127 : 0]  rx_tag [0 : (NUM_JOBS - 1)];
+  reg [7 : 0]    rx_id [0 : (NUM_JOBS - 1)];
+  reg [31 : 0]   rx_ctr;
+
+  reg            tb_debug;
+
+  reg            tb_clk;
+  reg            tb_reset_n;
+  reg [255 : 0]  tb_key;
+  reg [127 : 0]  tb_s_axis_tdata;
+  reg [15 : 0]   tb_s_axis_tkeep;
+  reg [7 : 0]    tb_s_axis_tid;
+  reg            tb_s_axis_tlast;
+  reg            tb_s_axis_tvalid;
+  wire           tb_s_axis_tready;
+  wire [127 : 0] tb_m_axis_tdata;
+  wire [7 : 0]   tb_m_axis_tid;
+  wire           tb_m_axis_tvalid;
+  reg            tb_m_axis_tready;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  poly1305_multi #(.NUM_CORES(NUM_CORES), .IN_ORDER(IN_ORDER))
+                 dut(
+                     .clk(tb_clk),
+                     .reset_n(tb_reset_n),
+                     .key(tb_key),
+                     .s_axis_tdata(tb_s_axis_tdata),
+                     .s_axis_tkeep(tb_s_axis_tkeep),
+                     .s_axis_tid(tb_s_axis_tid),
+                     .s_axis_tlast(tb_s_axis_tlast),
+                     .s_axis_tvalid(tb_s_axis_tvalid),
+                     .s_axis_tready(tb_s_axis_tready),
+                     .m_axis_tdata(tb_m_axis_tdata),
+                     .m_axis_tid(tb_m_axis_tid),
+                     .m_axis_tvalid(tb_m_axis_tvalid),
+                     .m_axis_tready(tb_m_axis_tready)
+                    );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter,
+  // captures the tags and IDs delivered on the tag stream and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always @ (posedge tb_clk)
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      if (tb_m_axis_tvalid && tb_m_axis_tready)
+        begin
+          if (rx_ctr < NUM_JOBS)
+            begin
+              rx_tag[rx_ctr] = tb_m_axis_tdata;
+              rx_id[rx_ctr]  = tb_m_axis_tid;
+            end
+          rx_ctr = rx_ctr + 1;
+        end
+
+      if (tb_debug)
+        dump_dut_state();
+    end
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dump when needed.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("cycle: 0x%08x, in_ctrl: 0x%01x, in_lane: 0x%02x, rr_lane: 0x%02x",
+               cycle_ctr, dut.in_ctrl_reg, dut.in_lane_reg, dut.rr_lane_reg);
+      $display("lane_free: 0x%02x, lane_full: 0x%02x, lane_done: 0x%02x, ord_ctr: 0x%02x",
+               dut.lane_free, dut.lane_full, dut.lane_done, dut.ord_ctr_reg);
+      $display("s_axis: tvalid: 0x%01x, tready: 0x%01x, tlast: 0x%01x, tid: 0x%02x",
+               tb_s_axis_tvalid, tb_s_axis_tready, tb_s_axis_tlast, tb_s_axis_tid);
+      $display("m_axis: tvalid: 0x%01x, tready: 0x%01x, tid: 0x%02x, tdata: 0x%032x",
+               tb_m_axis_tvalid, tb_m_axis_tready, tb_m_axis_tid, tb_m_axis_tdata);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("TB: Resetting dut.");
+      tb_reset_n = 0;
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      $display("");
+      if (error_ctr == 0)
+        begin
+          $display("%02d test completed. All test cases completed successfully.", tc_ctr);
+        end
+      else
+        begin
+          $display("%02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr        = 0;
+      error_ctr        = 0;
+      tc_ctr           = 0;
+      rx_ctr           = 0;
+      tb_debug         = 0;
+
+      tb_clk           = 0;
+      tb_reset_n       = 1;
+      tb_key           = 256'h0;
+      tb_s_axis_tdata  = 128'h0;
+      tb_s_axis_tkeep  = 16'h0;
+      tb_s_axis_tid    = 8'h0;
+      tb_s_axis_tlast  = 0;
+      tb_s_axis_tvalid = 0;
+      tb_m_axis_tready = 1;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // send_beat()
+  //
+  // Present a beat on the message stream and wait until it has
+  // been accepted. The block is given in the same byte order as
+  // for the core, i.e. with the first byte in the most
+  // significant byte. The number of valid bytes is given in len.
+  //----------------------------------------------------------------
+  task send_beat(input [127 : 0] block, input [4 : 0] len, input last);
+    begin : send_beat
+      integer i;
+
+      for (i = 0 ; i < 16 ; i = i + 1)
+        tb_s_axis_tdata[i * 8 +: 8] = block[(15 - i) * 8 +: 8];
+
+      tb_s_axis_tkeep  = (17'h1 << len) - 1'h1;
+      tb_s_axis_tlast  = last;
+      tb_s_axis_tvalid = 1;
+
+      while (!tb_s_axis_tready)
+        #(CLK_PERIOD);
+      #(CLK_PERIOD);
+
+      tb_s_axis_tvalid = 0;
+      tb_s_axis_tlast  = 0;
+    end
+  endtask // send_beat
+
+
+  //----------------------------------------------------------------
+  // send_rfc8439()
+  //
+  // Send the message from RFC 8439, section 2.5.2 as a job
+  // with the given ID.
+  //----------------------------------------------------------------
+  task send_rfc8439(input [7 : 0] id);
+    begin
+      tb_key        = RFC_KEY;
+      tb_s_axis_tid = id;
+      send_beat(128'h43727970_746f6772_61706869_6320466f, 5'h10, 0);
+      send_beat(128'h72756d20_52657365_61726368_2047726f, 5'h10, 0);
+      send_beat(128'h75700000_00000000_00000000_00000000, 5'h02, 1);
+    end
+  endtask // send_rfc8439
+
+
+  //----------------------------------------------------------------
+  // send_bytes0()
+  //
+  // Send a zero byte length message as a job with the given ID.
+  //----------------------------------------------------------------
+  task send_bytes0(input [7 : 0] id);
+    begin
+      tb_key        = RFC_KEY;
+      tb_s_axis_tid = id;
+      send_beat(128'h0, 5'h00, 1);
+    end
+  endtask // send_bytes0
+
+
+  //----------------------------------------------------------------
+  // wait_tags()
+  //
+  // Wait until the given number of tags have been received.
+  //----------------------------------------------------------------
+  task wait_tags(input [31 : 0] num);
+    begin
+      while (rx_ctr < num)
+        #(CLK_PERIOD);
+    end
+  endtask // wait_tags
+
+
+  //----------------------------------------------------------------
+  // check_tag()
+  //
+  // Compare a received tag and ID to the expected tag given
+  // in the same byte order as the mac from the core.
+  //----------------------------------------------------------------
+  task check_tag(input [31 : 0] idx, input [7 : 0] id,
+                 input [127 : 0] expected);
+    begin : check_tag
+      integer i;
+      reg [127 : 0] tag;
+
+      for (i = 0 ; i < 16 ; i = i + 1)
+        tag[(15 - i) * 8 +: 8] = rx_tag[idx][i * 8 +: 8];
+
+      if ((tag == expected) && (rx_id[idx] == id))
+        $display("*** check_tag: Correct tag generated for job 0x%02x.", id);
+      else begin
+        $display("*** check_tag: Error. Incorrect tag or ID.");
+        $display("*** check_tag: Expected: 0x%02x 0x%032x", id, expected);
+        $display("*** check_tag: Got:      0x%02x 0x%032x", rx_id[idx], tag);
+        error_ctr = error_ctr + 1;
+      end
+    end
+  endtask // check_tag
+
+
+  //----------------------------------------------------------------
+  // test_rfc8439;
+  //
+  // Test case that uses the test vectors from RFC 8439,
+  // section 2.5.2:
+  // https://tools.ietf.org/html/rfc8439#section-2.5.2
+  //----------------------------------------------------------------
+  task test_rfc8439;
+    begin : test_rfc8439
+      $display("*** test_rfc8439 started.");
+      tc_ctr = tc_ctr + 1;
+      rx_ctr = 0;
+
+      send_rfc8439(8'h5a);
+      wait_tags(1);
+      check_tag(0, 8'h5a, RFC_TAG);
+
+      $display("*** test_rfc8439 completed.\n");
+    end
+  endtask // test_rfc8439
+
+
+  //----------------------------------------------------------------
+  // test_backpressure;
+  //
+  // Two jobs are processed while the tag stream is stalled.
+  // Both tags must be delivered when the stall is released.
+  //----------------------------------------------------------------
+  task test_backpressure;
+    begin : test_backpressure
+      $display("*** test_backpressure started.");
+      tc_ctr = tc_ctr + 1;
+      rx_ctr = 0;
+
+      tb_m_axis_tready = 0;
+      send_rfc8439(8'h01);
+      send_bytes0(8'h02);
+      #(100 * CLK_PERIOD);
+
+      if (rx_ctr != 0)
+        begin
+          $display("*** test_backpressure: Error. Tag delivered during stall.");
+          error_ctr = error_ctr + 1;
+        end
+
+      tb_m_axis_tready = 1;
+      wait_tags(2);
+
+      if (rx_id[0] == 8'h01)
+        begin
+          check_tag(0, 8'h01, RFC_TAG);
+          check_tag(1, 8'h02, NUL_TAG);
+        end
+      else
+        begin
+          check_tag(0, 8'h02, NUL_TAG);
+          check_tag(1, 8'h01, RFC_TAG);
+        end
+
+      $display("*** test_backpressure completed.\n");
+    end
+  endtask // test_backpressure
+
+
+  //----------------------------------------------------------------
+  // test_jobs;
+  //
+  // NUM_JOBS jobs alternating between the RFC 8439 message and
+  // the zero length message. The short jobs complete before
+  // the long jobs, which requires the tags to be reordered in
+  // order mode. Without ordering each tag is checked using the
+  // ID. The number of cycles used is reported to allow the
+  // scaling with the number of cores to be measured.
+  //----------------------------------------------------------------
+  task test_jobs;
+    begin : test_jobs
+      integer i;
+      reg [31 : 0] start_cycle;
+      reg [(NUM_JOBS - 1) : 0] seen;
+
+      $display("*** test_jobs started.");
+      tc_ctr = tc_ctr + 1;
+      rx_ctr = 0;
+      seen   = {NUM_JOBS{1'h0}};
+
+      start_cycle = cycle_ctr;
+      for (i = 0 ; i < NUM_JOBS ; i = i + 1)
+        begin
+          if (i[0])
+            send_bytes0(i);
+          else
+            send_rfc8439(i);
+        end
+      wait_tags(NUM_JOBS);
+
+      $display("*** test_jobs: %0d cores, %0d cycles for %0d jobs, %0d cycles/job.",
+               NUM_CORES, (cycle_ctr - start_cycle), NUM_JOBS,
+               (cycle_ctr - start_cycle) / NUM_JOBS);
+
+      for (i = 0 ; i < NUM_JOBS ; i = i + 1)
+        begin
+          if (IN_ORDER)
+            check_tag(i, i, (i[0] ? NUL_TAG : RFC_TAG));
+          else
+            begin
+              check_tag(i, rx_id[i], (rx_id[i][0] ? NUL_TAG : RFC_TAG));
+
+              if (seen[rx_id[i]])
+                begin
+                  $display("*** test_jobs: Error. Job 0x%02x delivered twice.", rx_id[i]);
+                  error_ctr = error_ctr + 1;
+                end
+              seen[rx_id[i]] = 1'h1;
+            end
+        end
+
+      $display("*** test_jobs completed.\n");
+    end
+  endtask // test_jobs
+
+
+  //----------------------------------------------------------------
+  // main
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : main
+      $display("*** Testbench for poly1305_multi started ***");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      test_rfc8439();
+      test_backpressure();
+      test_jobs();
+      test_rfc8439();
+
+      display_test_results();
+
+      $display("*** Testbench for poly1305_multi done ***");
+      $finish;
+    end // main
+
+endmodule // tb_poly1305_multi
+
+//======================================================================
+// EOF tb_poly1305_multi.v
+//======================================================================
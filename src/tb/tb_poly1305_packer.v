@@ -0,0 +1,502 @@
+//======================================================================
+//
+// tb_poly1305_packer.v
+// --------------------
+// Testbench for the Poly1305 byte granular input packer.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module tb_poly1305_packer();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam CLK_HALF_PERIOD = 1;
+  localparam CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  localparam MAX_BYTES       = 1040;
+
+  localparam RFC_KEY  = 256'h85d6be78_57556d33_7f4452fe_42d506a8_0103808a_fb0db2fd_4abff6af_4149f51b;
+  localparam LONG_KEY = 256'hf3000000_00000000_00000000_0000003f_3f000000_00000000_00000000_000000f3;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]   cycle_ctr;
+  reg [31 : 0]   error_ctr;
+  reg [31 : 0]   tc_ctr;
+
+  reg [7 : 0]    msg_mem [0 : (MAX_BYTES - 1)];
+  reg            last_seen;
+
+  reg            tb_debug;
+
+  reg            tb_clk;
+  reg            tb_reset_n;
+  reg            tb_init;
+  reg [255 : 0]  tb_key;
+  reg [31 : 0]   tb_data;
+  reg [2 : 0]    tb_len;
+  reg            tb_last;
+  reg            tb_valid;
+  wire           tb_ready;
+  wire           tb_core_next;
+  wire           tb_core_last;
+  wire [127 : 0] tb_core_block;
+  wire [4 : 0]   tb_core_blocklen;
+  wire           tb_core_ready;
+  wire [127 : 0] tb_mac;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  poly1305_packer dut(
+                      .clk(tb_clk),
+                      .reset_n(tb_reset_n),
+                      .data(tb_data),
+                      .len(tb_len),
+                      .last(tb_last),
+                      .valid(tb_valid),
+                      .ready(tb_ready),
+                      .lastlen_we(1'h0),
+                      .lastlen(5'h0),
+                      .flush(1'h0),
+                      .busy(),
+                      .core_next(tb_core_next),
+                      .core_last(tb_core_last),
+                      .core_block(tb_core_block),
+                      .core_blocklen(tb_core_blocklen),
+                      .core_ready(tb_core_ready)
+                     );
+
+
+  poly1305_core core(
+                     .clk(tb_clk),
+                     .reset_n(tb_reset_n),
+                     .init(tb_init),
+                     .next(tb_core_next),
+                     .last(tb_core_last),
+                     .finish(1'h0),
+                     .restore(1'h0),
+                     .ready(tb_core_ready),
+                     .pblock_busy(),
+                     .final_busy(),
+                     .key(tb_key),
+                     .chain(1'h0),
+                     .chain_key(256'h0),
+                     .block(tb_core_block),
+                     .blocklen(tb_core_blocklen),
+                     .ctx_in(416'h0),
+                     .ctx(),
+                     .mac(tb_mac)
+                    );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter,
+  // detects when the final block is sent to the core and
+  // conditionally displays information about the DUT.
+  //----------------------------------------------------------------
+  always @ (posedge tb_clk)
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      if (tb_core_next && tb_core_last)
+        last_seen = 1;
+
+      if (tb_debug)
+        dump_dut_state();
+    end
+
+
+  //----------------------------------------------------------------
+  // dump_dut_state()
+  //
+  // Dump the state of the dump when needed.
+  //----------------------------------------------------------------
+  task dump_dut_state;
+    begin
+      $display("cycle: 0x%08x, cnt: 0x%02x, last_pending: 0x%01x, block_valid: 0x%01x",
+               cycle_ctr, dut.cnt_reg, dut.last_pending_reg, dut.block_valid_reg);
+      $display("acc: 0x%040x", dut.acc_reg);
+      $display("data: 0x%08x, len: 0x%01x, last: 0x%01x, valid: 0x%01x, ready: 0x%01x",
+               tb_data, tb_len, tb_last, tb_valid, tb_ready);
+      $display("core_next: 0x%01x, core_last: 0x%01x, core_blocklen: 0x%02x, core_ready: 0x%01x",
+               tb_core_next, tb_core_last, tb_core_blocklen, tb_core_ready);
+      $display("core_block: 0x%032x", tb_core_block);
+      $display("");
+    end
+  endtask // dump_dut_state
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("TB: Resetting dut.");
+      tb_reset_n = 0;
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      $display("");
+      if (error_ctr == 0)
+        begin
+          $display("%02d test completed. All test cases completed successfully.", tc_ctr);
+        end
+      else
+        begin
+          $display("%02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr  = 0;
+      error_ctr  = 0;
+      tc_ctr     = 0;
+      last_seen  = 0;
+      tb_debug   = 0;
+
+      tb_clk     = 0;
+      tb_reset_n = 1;
+      tb_init    = 0;
+      tb_key     = 256'h0;
+      tb_data    = 32'h0;
+      tb_len     = 3'h0;
+      tb_last    = 0;
+      tb_valid   = 0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // init_core()
+  //
+  // Initialize the core with the given key and wait for ready.
+  //----------------------------------------------------------------
+  task init_core(input [255 : 0] key);
+    begin
+      tb_key  = key;
+      tb_init = 1;
+      #(CLK_PERIOD);
+      tb_init = 0;
+      #(2 * CLK_PERIOD);
+
+      while (!tb_core_ready)
+        #(CLK_PERIOD);
+    end
+  endtask // init_core
+
+
+  //----------------------------------------------------------------
+  // send_frag()
+  //
+  // Present a fragment with len bytes, first byte in the most
+  // significant byte of data, and wait until it has been
+  // accepted. The unused bytes are set to garbage to check
+  // that they are masked by the packer.
+  //----------------------------------------------------------------
+  task send_frag(input [31 : 0] data, input [2 : 0] len, input last);
+    begin
+      tb_data  = data | (32'ha5a5a5a5 >> (len * 8));
+      tb_len   = len;
+      tb_last  = last;
+      tb_valid = 1;
+
+      while (!tb_ready)
+        #(CLK_PERIOD);
+      #(CLK_PERIOD);
+
+      tb_valid = 0;
+      tb_last  = 0;
+    end
+  endtask // send_frag
+
+
+  //----------------------------------------------------------------
+  // send_msg()
+  //
+  // Send the first num_bytes bytes in msg_mem as fragments.
+  // The fragment sizes cycle through one to four bytes,
+  // starting at the given phase. The last fragment is sent
+  // with last set. A zero length message is sent as a single
+  // fragment with zero bytes and last set.
+  //----------------------------------------------------------------
+  task send_msg(input [31 : 0] num_bytes, input [1 : 0] phase);
+    begin : send_msg
+      integer i;
+      integer j;
+      integer n;
+      reg [1 : 0]  step;
+      reg [31 : 0] data;
+
+      last_seen = 0;
+      step      = phase;
+      i         = 0;
+
+      if (num_bytes == 0)
+        send_frag(32'h0, 3'h0, 1);
+
+      while (i < num_bytes)
+        begin
+          n = step + 1;
+          if (n > (num_bytes - i))
+            n = num_bytes - i;
+
+          data = 32'h0;
+          for (j = 0 ; j < n ; j = j + 1)
+            data[(3 - j) * 8 +: 8] = msg_mem[i + j];
+
+          send_frag(data, n, ((i + n) == num_bytes));
+          i    = i + n;
+          step = step + 1;
+        end
+    end
+  endtask // send_msg
+
+
+  //----------------------------------------------------------------
+  // check_mac()
+  //
+  // Wait for the final block to be processed and compare the
+  // mac to the expected value.
+  //----------------------------------------------------------------
+  task check_mac(input [127 : 0] expected);
+    begin
+      while (!last_seen)
+        #(CLK_PERIOD);
+      #(2 * CLK_PERIOD);
+
+      while (!tb_core_ready)
+        #(CLK_PERIOD);
+
+      if (tb_mac == expected)
+        $display("*** check_mac: Correct MAC generated.");
+      else begin
+        $display("*** check_mac: Error. Incorrect MAC generated.");
+        $display("*** check_mac: Expected: 0x%032x", expected);
+        $display("*** check_mac: Got:      0x%032x", tb_mac);
+        error_ctr = error_ctr + 1;
+      end
+    end
+  endtask // check_mac
+
+
+  //----------------------------------------------------------------
+  // load_rfc8439()
+  //
+  // Load the 34 byte message from RFC 8439, section 2.5.2
+  // into msg_mem.
+  //----------------------------------------------------------------
+  task load_rfc8439;
+    begin : load_rfc8439
+      integer i;
+      reg [271 : 0] msg;
+
+      msg = {128'h43727970_746f6772_61706869_6320466f,
+             128'h72756d20_52657365_61726368_2047726f,
+             16'h7570};
+
+      for (i = 0 ; i < 34 ; i = i + 1)
+        msg_mem[i] = msg[(33 - i) * 8 +: 8];
+    end
+  endtask // load_rfc8439
+
+
+  //----------------------------------------------------------------
+  // test_rfc8439;
+  //
+  // Test case that uses the test vectors from RFC 8439,
+  // section 2.5.2. The message is sent with all four
+  // fragment size phases.
+  // https://tools.ietf.org/html/rfc8439#section-2.5.2
+  //----------------------------------------------------------------
+  task test_rfc8439;
+    begin : test_rfc8439
+      integer phase;
+
+      $display("*** test_rfc8439 started.");
+      tc_ctr = tc_ctr + 1;
+
+      load_rfc8439();
+
+      for (phase = 0 ; phase < 4 ; phase = phase + 1)
+        begin
+          init_core(RFC_KEY);
+          send_msg(34, phase);
+          check_mac(128'ha8061dc1_305136c6_c22b8baf_0c0127a9);
+        end
+
+      $display("*** test_rfc8439 completed.\n");
+    end
+  endtask // test_rfc8439
+
+
+  //----------------------------------------------------------------
+  // test_bytes0;
+  //
+  // Zero length message. The mac is the s part of the key.
+  //----------------------------------------------------------------
+  task test_bytes0;
+    begin : test_bytes0
+      $display("*** test_bytes0 started.");
+      tc_ctr = tc_ctr + 1;
+
+      init_core(RFC_KEY);
+      send_msg(0, 0);
+      check_mac(128'h0103808a_fb0db2fd_4abff6af_4149f51b);
+
+      $display("*** test_bytes0 completed.\n");
+    end
+  endtask // test_bytes0
+
+
+  //----------------------------------------------------------------
+  // test_bytes32;
+  //
+  // A message with two full blocks. The second block must be
+  // processed with last set, without a separate final block.
+  //----------------------------------------------------------------
+  task test_bytes32;
+    begin : test_bytes32
+      $display("*** test_bytes32 started.");
+      tc_ctr = tc_ctr + 1;
+
+      load_rfc8439();
+      init_core(RFC_KEY);
+      send_msg(32, 1);
+      check_mac(128'hdf33cbbe_e5c281ca_f23e2a60_65f8a2f4);
+
+      $display("*** test_bytes32 completed.\n");
+    end
+  endtask // test_bytes32
+
+
+  //----------------------------------------------------------------
+  // test_long;
+  //
+  // A 1025 byte long message. The number of cycles used
+  // is reported to allow measurement of the throughput.
+  //----------------------------------------------------------------
+  task test_long;
+    begin : test_long
+      integer i;
+      reg [31 : 0] start_cycle;
+
+      $display("*** test_long started.");
+      tc_ctr = tc_ctr + 1;
+
+      for (i = 0 ; i < 1024 ; i = i + 1)
+        msg_mem[i] = 8'hff;
+      msg_mem[1024] = 8'h01;
+
+      init_core(LONG_KEY);
+      start_cycle = cycle_ctr;
+      send_msg(1025, 3);
+      check_mac(128'hdc0964e5_ce9cd7d9_a7571faf_a5dc0473);
+
+      $display("*** test_long: %0d cycles for 1025 bytes.",
+               (cycle_ctr - start_cycle));
+      $display("*** test_long completed.\n");
+    end
+  endtask // test_long
+
+
+  //----------------------------------------------------------------
+  // main
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : main
+      $display("*** Testbench for poly1305_packer started ***");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      test_rfc8439();
+      test_bytes0();
+      test_bytes32();
+      test_long();
+
+      display_test_results();
+
+      $display("*** Testbench for poly1305_packer done ***");
+      $finish;
+    end // main
+
+endmodule // tb_poly1305_packer
+
+//======================================================================
+// EOF tb_poly1305_packer.v
+//======================================================================
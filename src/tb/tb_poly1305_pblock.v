@@ -560,6 +560,93 @@ module tb_poly1305_pblock();
   endtask // test_long_block
 
 
+  //----------------------------------------------------------------
+  // check_h;
+  //
+  // Check the pblock result against the expected h words,
+  // given as {h4, h3, h2, h1, h0}.
+  //----------------------------------------------------------------
+  task check_h(input [159 : 0] expected);
+    begin
+      if ({tb_h4_new, tb_h3_new, tb_h2_new, tb_h1_new, tb_h0_new} != expected)
+        begin
+          $display("Error in h. Expected: 0x%040x", expected);
+          $display("Error in h. Got:      0x%08x%08x%08x%08x%08x",
+                   tb_h4_new, tb_h3_new, tb_h2_new, tb_h1_new, tb_h0_new);
+          incorrect = incorrect + 1;
+        end
+    end
+  endtask // check_h
+
+
+  //----------------------------------------------------------------
+  // test_back_to_back;
+  //
+  // Two blocks processed back to back with the same r. The
+  // operands of the second block are selected so that u1 and u2
+  // are on a carry boundary. The reduction chain must therefore
+  // settle completely, and the second result must not depend
+  // on values in the u registers from the first block.
+  //----------------------------------------------------------------
+  task test_back_to_back;
+    begin : test_back_to_back
+      $display("*** test_back_to_back started.\n");
+
+      tc_ctr = tc_ctr + 1;
+      incorrect = 0;
+
+      tb_r0 = 32'h0e9e3ded;
+      tb_r1 = 32'h0bb76da4;
+      tb_r2 = 32'h00000000;
+      tb_r3 = 32'h00000000;
+
+      tb_h0 = 32'ha4d36fa0;
+      tb_h1 = 32'he307a948;
+      tb_h2 = 32'h7fe2815c;
+      tb_h3 = 32'he9b090ea;
+      tb_h4 = 32'h00000001;
+
+      tb_c0 = 32'h00000000;
+      tb_c1 = 32'h00000000;
+      tb_c2 = 32'h00000000;
+      tb_c3 = 32'h00000000;
+      tb_c4 = 32'h00000000;
+
+      tb_start = 1;
+      #(1 * CLK_PERIOD);
+      tb_start = 0;
+      wait_ready();
+      check_h(160'h00000001_840e655c_1f42b8bb_daa5c717_32787140);
+
+      tb_h0 = 32'h00000000;
+      tb_h1 = 32'h00000000;
+      tb_h2 = 32'h00000000;
+      tb_h3 = 32'h00000000;
+      tb_h4 = 32'h00000000;
+
+      tb_c0 = 32'h3a264282;
+      tb_c1 = 32'h22aa3df5;
+      tb_c2 = 32'hfa3f8f93;
+      tb_c3 = 32'h5d5b4b0c;
+      tb_c4 = 32'h00000000;
+
+      tb_start = 1;
+      #(1 * CLK_PERIOD);
+      tb_start = 0;
+      wait_ready();
+      check_h(160'h00000000_8b9d3819_ffffffff_ffffffff_fd40b3fa);
+
+      if (!incorrect)
+        $display("*** test_back_to_back successfully completed.\n");
+      else
+        begin
+          error_ctr = error_ctr + 1;
+          $display("*** test_back_to_back completed with %d errors.\n", incorrect);
+        end
+    end
+  endtask // test_back_to_back
+
+
   //----------------------------------------------------------------
   // poly1305_pblock_test
   //----------------------------------------------------------------
@@ -576,6 +663,7 @@ module tb_poly1305_pblock();
       // test_rfc8349();
       // test_p1305_bytes16();
       test_long_block();
+      test_back_to_back();
 
       display_test_result();
 
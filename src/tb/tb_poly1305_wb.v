@@ -0,0 +1,377 @@
+//======================================================================
+//
+// tb_poly1305_wb.v
+// ----------------
+// Testbench for the Poly1305 Wishbone interface.
+//
+//
+// Copyright (c) 2026, Secworks Sweden AB
+// Joachim Strömbergson
+//
+// Redistribution and use in source and binary forms, with or
+// without modification, are permitted provided that the following
+// conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in
+//    the documentation and/or other materials provided with the
+//    distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+// BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//======================================================================
+
+`default_nettype none
+
+module tb_poly1305_wb();
+
+  //----------------------------------------------------------------
+  // Internal constant and parameter definitions.
+  //----------------------------------------------------------------
+  localparam CLK_HALF_PERIOD = 1;
+  localparam CLK_PERIOD      = 2 * CLK_HALF_PERIOD;
+
+  // The DUT address map.
+  localparam ADDR_CTRL        = 8'h08;
+  localparam CTRL_INIT_BIT    = 0;
+  localparam CTRL_NEXT_BIT    = 1;
+  localparam CTRL_FINISH_BIT  = 2;
+
+  localparam ADDR_STATUS      = 8'h09;
+  localparam STATUS_READY_BIT = 0;
+
+  localparam ADDR_KEY0        = 8'h10;
+
+  localparam ADDR_FIFO_DATA   = 8'h24;
+  localparam ADDR_LASTLEN     = 8'h25;
+
+  localparam ADDR_MAC0        = 8'h30;
+
+
+  //----------------------------------------------------------------
+  // Register and Wire declarations.
+  //----------------------------------------------------------------
+  reg [31 : 0]   cycle_ctr;
+  reg [31 : 0]   error_ctr;
+  reg [31 : 0]   tc_ctr;
+  reg [31 : 0]   access_ctr;
+  reg [31 : 0]   ack_ctr;
+
+  reg            read_pending;
+  reg [31 : 0]   read_buf [0 : 3];
+  reg [1 : 0]    read_ctr;
+  reg [127 : 0]  result_mac;
+
+  reg            tb_clk;
+  reg            tb_reset_n;
+
+  reg            tb_cyc;
+  reg            tb_stb;
+  reg            tb_we;
+  reg [9 : 0]    tb_adr;
+  reg [31 : 0]   tb_dat_i;
+  wire [31 : 0]  tb_dat_o;
+  wire           tb_ack;
+  wire           tb_stall;
+  wire           tb_irq;
+
+
+  //----------------------------------------------------------------
+  // Device Under Test.
+  //----------------------------------------------------------------
+  poly1305_wb dut(
+                  .clk(tb_clk),
+                  .reset_n(tb_reset_n),
+                  .wb_cyc_i(tb_cyc),
+                  .wb_stb_i(tb_stb),
+                  .wb_we_i(tb_we),
+                  .wb_adr_i(tb_adr),
+                  .wb_dat_i(tb_dat_i),
+                  .wb_sel_i(4'hf),
+                  .wb_dat_o(tb_dat_o),
+                  .wb_ack_o(tb_ack),
+                  .wb_stall_o(tb_stall),
+                  .irq(tb_irq)
+                 );
+
+
+  //----------------------------------------------------------------
+  // clk_gen
+  //
+  // Always running clock generator process.
+  //----------------------------------------------------------------
+  always
+    begin : clk_gen
+      #CLK_HALF_PERIOD;
+      tb_clk = !tb_clk;
+    end // clk_gen
+
+
+  //----------------------------------------------------------------
+  // sys_monitor()
+  //
+  // An always running process that creates a cycle counter,
+  // counts acknowledges and collects read data. An ack is for
+  // a read if a read was issued in the previous cycle.
+  //----------------------------------------------------------------
+  always @ (posedge tb_clk)
+    begin : sys_monitor
+      cycle_ctr = cycle_ctr + 1;
+
+      if (tb_ack)
+        begin
+          ack_ctr = ack_ctr + 1;
+          if (read_pending)
+            begin
+              read_buf[read_ctr] = tb_dat_o;
+              read_ctr = read_ctr + 1;
+            end
+        end
+
+      read_pending = tb_cyc && tb_stb && !tb_stall && !tb_we;
+    end
+
+
+  //----------------------------------------------------------------
+  // reset_dut()
+  //
+  // Toggle reset to put the DUT into a well known state.
+  //----------------------------------------------------------------
+  task reset_dut;
+    begin
+      $display("TB: Resetting dut.");
+      tb_reset_n = 0;
+      #(2 * CLK_PERIOD);
+      tb_reset_n = 1;
+    end
+  endtask // reset_dut
+
+
+  //----------------------------------------------------------------
+  // display_test_results()
+  //
+  // Display the accumulated test results.
+  //----------------------------------------------------------------
+  task display_test_results;
+    begin
+      $display("");
+      if (error_ctr == 0)
+        begin
+          $display("%02d test completed. All test cases completed successfully.", tc_ctr);
+        end
+      else
+        begin
+          $display("%02d tests completed - %02d test cases did not complete successfully.",
+                   tc_ctr, error_ctr);
+        end
+    end
+  endtask // display_test_results
+
+
+  //----------------------------------------------------------------
+  // init_sim()
+  //
+  // Initialize all counters and testbed functionality as well
+  // as setting the DUT inputs to defined values.
+  //----------------------------------------------------------------
+  task init_sim;
+    begin
+      cycle_ctr    = 0;
+      error_ctr    = 0;
+      tc_ctr       = 0;
+      access_ctr   = 0;
+      ack_ctr      = 0;
+      read_pending = 0;
+      read_ctr     = 0;
+
+      tb_clk       = 0;
+      tb_reset_n   = 1;
+      tb_cyc       = 0;
+      tb_stb       = 0;
+      tb_we        = 0;
+      tb_adr       = 10'h0;
+      tb_dat_i     = 32'h0;
+    end
+  endtask // init_sim
+
+
+  //----------------------------------------------------------------
+  // bus_access()
+  //
+  // Issue a single access in the next cycle. The cycle is kept
+  // open which allows pipelined back-to-back accesses.
+  // Call bus_end() to end the cycle when all accesses have
+  // been acknowledged.
+  //----------------------------------------------------------------
+  task bus_access(input we, input [7 : 0] address, input [31 : 0] word);
+    begin
+      @(negedge tb_clk);
+      tb_cyc   = 1;
+      tb_stb   = 1;
+      tb_we    = we;
+      tb_adr   = {address, 2'h0};
+      tb_dat_i = word;
+
+      @(posedge tb_clk);
+      while (tb_stall)
+        @(posedge tb_clk);
+      access_ctr = access_ctr + 1;
+    end
+  endtask // bus_access
+
+
+  //----------------------------------------------------------------
+  // bus_end()
+  //
+  // Stop issuing accesses, wait for all outstanding
+  // acknowledges and end the cycle.
+  //----------------------------------------------------------------
+  task bus_end;
+    begin
+      @(negedge tb_clk);
+      tb_stb = 0;
+      while (ack_ctr != access_ctr)
+        @(negedge tb_clk);
+      tb_cyc = 0;
+    end
+  endtask // bus_end
+
+
+  //----------------------------------------------------------------
+  // write_word()
+  //----------------------------------------------------------------
+  task write_word(input [7 : 0] address, input [31 : 0] word);
+    begin
+      bus_access(1, address, word);
+    end
+  endtask // write_word
+
+
+  //----------------------------------------------------------------
+  // wait_ready()
+  //
+  // Wait for the ready flag to be set in dut.
+  //----------------------------------------------------------------
+  task wait_ready;
+    begin : wready
+      reg ready;
+
+      ready = 0;
+      while (!ready)
+        begin
+          read_ctr = 0;
+          bus_access(0, ADDR_STATUS, 32'h0);
+          bus_end();
+          ready = read_buf[0][STATUS_READY_BIT];
+        end
+    end
+  endtask // wait_ready
+
+
+  //----------------------------------------------------------------
+  // test_rfc8439;
+  //
+  // The RFC 8439 test case with the key and message written
+  // using pipelined writes.
+  //----------------------------------------------------------------
+  task test_rfc8439;
+    begin : test_rfc8439
+      reg [31 : 0] start_cycle;
+
+      $display("*** test_rfc8439 started.");
+      tc_ctr = tc_ctr + 1;
+
+      start_cycle = cycle_ctr;
+      write_word(ADDR_KEY0 + 0, 32'h85d6be78);
+      write_word(ADDR_KEY0 + 1, 32'h57556d33);
+      write_word(ADDR_KEY0 + 2, 32'h7f4452fe);
+      write_word(ADDR_KEY0 + 3, 32'h42d506a8);
+      write_word(ADDR_KEY0 + 4, 32'h0103808a);
+      write_word(ADDR_KEY0 + 5, 32'hfb0db2fd);
+      write_word(ADDR_KEY0 + 6, 32'h4abff6af);
+      write_word(ADDR_KEY0 + 7, 32'h4149f51b);
+      write_word(ADDR_CTRL, (32'h1 << CTRL_INIT_BIT));
+      bus_end();
+      $display("*** test_rfc8439: Key and init written in %0d cycles.",
+               cycle_ctr - start_cycle);
+      wait_ready();
+
+      write_word(ADDR_FIFO_DATA, 32'h43727970);
+      write_word(ADDR_FIFO_DATA, 32'h746f6772);
+      write_word(ADDR_FIFO_DATA, 32'h61706869);
+      write_word(ADDR_FIFO_DATA, 32'h6320466f);
+      write_word(ADDR_FIFO_DATA, 32'h72756d20);
+      write_word(ADDR_FIFO_DATA, 32'h52657365);
+      write_word(ADDR_FIFO_DATA, 32'h61726368);
+      write_word(ADDR_FIFO_DATA, 32'h2047726f);
+      write_word(ADDR_FIFO_DATA, 32'h75700000);
+      write_word(ADDR_LASTLEN, 32'h2);
+      bus_end();
+      wait_ready();
+
+      write_word(ADDR_CTRL, (32'h1 << CTRL_FINISH_BIT));
+      bus_end();
+      wait_ready();
+
+      read_ctr = 0;
+      bus_access(0, ADDR_MAC0 + 0, 32'h0);
+      bus_access(0, ADDR_MAC0 + 1, 32'h0);
+      bus_access(0, ADDR_MAC0 + 2, 32'h0);
+      bus_access(0, ADDR_MAC0 + 3, 32'h0);
+      bus_end();
+      result_mac = {read_buf[0], read_buf[1], read_buf[2], read_buf[3]};
+
+      if (result_mac == 128'ha8061dc1_305136c6_c22b8baf_0c0127a9)
+        $display("*** test_rfc8439: Correct MAC generated.");
+      else begin
+        $display("*** test_rfc8439: Error. Incorrect MAC generated.");
+        $display("*** test_rfc8439: Expected: 0xa8061dc1_305136c6_c22b8baf_0c0127a9");
+        $display("*** test_rfc8439: Got:      0x%032x", result_mac);
+        error_ctr = error_ctr + 1;
+      end
+
+      $display("*** test_rfc8439 completed.\n");
+    end
+  endtask // test_rfc8439
+
+
+  //----------------------------------------------------------------
+  // main
+  //
+  // The main test functionality.
+  //----------------------------------------------------------------
+  initial
+    begin : main
+      $display("*** Testbench for poly1305_wb started ***");
+      $display("");
+
+      init_sim();
+      reset_dut();
+
+      test_rfc8439();
+
+      display_test_results();
+
+      $display("*** Testbench for poly1305_wb done ***");
+      $finish;
+    end // main
+
+endmodule // tb_poly1305_wb
+
+//======================================================================
+// EOF tb_poly1305_wb.v
+//======================================================================
@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#=======================================================================
+#
+# qor.py
+# ------
+# Synthesis quality of results benchmark for the Poly1305 top using
+# open source tools. The top is synthesized with Yosys for each
+# micro-architecture configuration, as generic cells and for iCE40
+# and ECP5. The ECP5 netlist is placed and routed with nextpnr to
+# get the Fmax. The top does not fit in any iCE40 device with DSPs,
+# and the iCE40 results are from synthesis only.
+# The results are tabulated together with the throughput derived
+# from the block latency of each configuration.
+#
+#
+# Author: Joachim Strömbergson
+# Copyright (c) 2026, Secworks Sweden AB
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or
+# without modification, are permitted provided that the following
+# conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+# STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+# ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#=======================================================================
+
+#-------------------------------------------------------------------
+# Python module imports.
+#-------------------------------------------------------------------
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+
+#-------------------------------------------------------------------
+# Constants.
+#-------------------------------------------------------------------
+RTL_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "rtl")
+
+TOP_SRC = ["poly1305.v", "poly1305_core.v", "poly1305_pblock.v",
+           "poly1305_pblock_ll.v", "poly1305_pblock_pipe.v",
+           "poly1305_mulacc.v", "poly1305_final.v",
+           "poly1305_core_small.v", "poly1305_packer.v"]
+
+# Configurations with the parameters for the top, and the number
+# of cycles for a next operation, i.e. the cycles per 16 byte
+# block when processing long messages. The pipelined pblock
+# latency is PIPE_DEPTH + 2 cycles, and the core adds three cycles.
+# The area optimized core uses 29 cycles per block.
+CONFIGS = [
+    ("default",  {},                                                   17),
+    ("ll",       {"LOW_LATENCY": 1, "FINAL_LATENCY": 1},               9),
+    ("hf",       {"HIGH_FMAX": 1, "FINAL_LATENCY": 2},                 9 + 5),
+    ("hf_d4",    {"HIGH_FMAX": 1, "FINAL_LATENCY": 2, "PIPE_DEPTH": 4}, 4 + 5),
+    ("hf_d0",    {"HIGH_FMAX": 1, "FINAL_LATENCY": 2, "PIPE_DEPTH": 0}, 0 + 5),
+    ("small",    {"SMALL_CORE": 1},                                    29),
+]
+
+# Yosys synthesis commands and cell classification per target.
+TARGETS = {
+    "generic": {
+        "synth": "synth -top poly1305",
+        "lut":   None,
+        "ff":    re.compile(r"^\$_S?DFF"),
+        "mul":   None,
+    },
+    "ice40": {
+        "synth": "synth_ice40 -top poly1305 -json {json}",
+        "lut":   re.compile(r"^SB_LUT4$"),
+        "ff":    re.compile(r"^SB_DFF"),
+        "mul":   None,
+    },
+    "ecp5": {
+        "synth": "synth_ecp5 -top poly1305 -json {json}",
+        "lut":   re.compile(r"^(LUT4|CCU2C)$"),
+        "ff":    re.compile(r"^TRELLIS_FF$"),
+        "mul":   re.compile(r"^MULT18X18D$"),
+    },
+}
+
+# Place and route per target. The iCE40 devices with DSPs (UltraPlus)
+# have at most 5280 LUTs and the iCE40 targets are not placed and
+# routed.
+NEXTPNR = {
+    "ecp5":  ["nextpnr-ecp5", "--85k", "--package", "CABGA381"],
+}
+
+
+#-------------------------------------------------------------------
+# run()
+#
+# Run a command with the output in a log file.
+# Returns True if the command completed successfully.
+#-------------------------------------------------------------------
+def run(cmd, logname):
+    with open(logname, "w") as log:
+        try:
+            res = subprocess.run(cmd, stdout=log, stderr=subprocess.STDOUT)
+        except FileNotFoundError:
+            log.write("Command not found: %s\n" % cmd[0])
+            return False
+    return res.returncode == 0
+
+
+#-------------------------------------------------------------------
+# parse_cells()
+#
+# Get the cell counts for the top from the last stat output in
+# a Yosys log.
+#-------------------------------------------------------------------
+def parse_cells(logname):
+    cells = {}
+    total = 0
+    with open(logname, "r") as f:
+        lines = f.readlines()
+
+    for line in lines:
+        m = re.match(r"^\s+Number of cells:\s+(\d+)", line)
+        if m:
+            cells = {}
+            total = int(m.group(1))
+            continue
+
+        m = re.match(r"^\s+(\S+)\s+(\d+)$", line)
+        if m and total:
+            cells[m.group(1)] = int(m.group(2))
+    return total, cells
+
+
+#-------------------------------------------------------------------
+# count()
+#-------------------------------------------------------------------
+def count(cells, pattern):
+    if pattern is None:
+        return None
+    return sum(n for (c, n) in cells.items() if pattern.match(c))
+
+
+#-------------------------------------------------------------------
+# parse_fmax()
+#
+# Get the routed Fmax from a nextpnr log.
+#-------------------------------------------------------------------
+def parse_fmax(logname):
+    fmax = None
+    with open(logname, "r") as f:
+        for line in f:
+            m = re.search(r"Max frequency for clock '[^']*': ([\d.]+) MHz", line)
+            if m:
+                fmax = float(m.group(1))
+    return fmax
+
+
+#-------------------------------------------------------------------
+# synth_config()
+#
+# Synthesize and optionally place and route one configuration
+# for one target.
+#-------------------------------------------------------------------
+def synth_config(name, params, target, workdir, pnr):
+    base = os.path.join(workdir, "%s_%s" % (name, target))
+    json = base + ".json"
+    src = " ".join(os.path.join(RTL_DIR, f) for f in TOP_SRC)
+
+    script = ["read_verilog %s" % src]
+    for (p, v) in params.items():
+        script.append("chparam -set %s %d poly1305" % (p, v))
+    script.append(TARGETS[target]["synth"].format(json=json))
+    script.append("stat")
+
+    res = {"lut": None, "ff": None, "mul": None, "cells": None, "fmax": None}
+    if not run(["yosys", "-p", "; ".join(script)], base + "_yosys.log"):
+        print("Synthesis of %s for %s failed, see %s_yosys.log" % (name, target, base))
+        return res
+
+    total, cells = parse_cells(base + "_yosys.log")
+    res["cells"] = total
+    res["lut"] = count(cells, TARGETS[target]["lut"])
+    res["ff"] = count(cells, TARGETS[target]["ff"])
+    res["mul"] = count(cells, TARGETS[target]["mul"])
+
+    if pnr and target in NEXTPNR:
+        cmd = NEXTPNR[target] + ["--json", json, "--freq", "100",
+                                 "--lpf-allow-unconstrained"]
+        if run(cmd, base + "_nextpnr.log"):
+            res["fmax"] = parse_fmax(base + "_nextpnr.log")
+        else:
+            print("Place and route of %s for %s failed, see %s_nextpnr.log" %
+                  (name, target, base))
+    return res
+
+
+#-------------------------------------------------------------------
+# fmt()
+#-------------------------------------------------------------------
+def fmt(val, form="%d"):
+    if val is None:
+        return "-"
+    return form % val
+
+
+#-------------------------------------------------------------------
+# main()
+#-------------------------------------------------------------------
+def main():
+    parser = argparse.ArgumentParser(description="Poly1305 synthesis QoR benchmark.")
+    parser.add_argument("--targets", default="generic,ice40,ecp5",
+                        help="Comma separated list of targets (generic, ice40, ecp5).")
+    parser.add_argument("--configs", default=",".join(c[0] for c in CONFIGS),
+                        help="Comma separated list of configurations.")
+    parser.add_argument("--no-pnr", action="store_true",
+                        help="Skip place and route.")
+    parser.add_argument("--workdir", default="qor_work",
+                        help="Directory for logs and netlists.")
+    parser.add_argument("--out", default=None,
+                        help="Write the result table to this file.")
+    args = parser.parse_args()
+
+    targets = args.targets.split(",")
+    configs = [c for c in CONFIGS if c[0] in args.configs.split(",")]
+    for t in targets:
+        if t not in TARGETS:
+            print("Unknown target: %s" % t)
+            return 1
+
+    os.makedirs(args.workdir, exist_ok=True)
+
+    rows = ["| config | target | cells | LUTs | FFs | mults | Fmax (MHz) | "
+            "cycles/block | Mbps | Mbps/kLUT |",
+            "|---|---|---|---|---|---|---|---|---|---|"]
+
+    for (name, params, block_cycles) in configs:
+        for t in targets:
+            print("Running %s for %s" % (name, t))
+            r = synth_config(name, params, t, args.workdir, not args.no_pnr)
+
+            mbps = None
+            per_klut = None
+            if r["fmax"]:
+                mbps = r["fmax"] * 128 / block_cycles
+                if r["lut"]:
+                    per_klut = 1000.0 * mbps / r["lut"]
+
+            rows.append("| %s | %s | %s | %s | %s | %s | %s | %d | %s | %s |" %
+                        (name, t, fmt(r["cells"]), fmt(r["lut"]), fmt(r["ff"]),
+                         fmt(r["mul"]), fmt(r["fmax"], "%.1f"), block_cycles,
+                         fmt(mbps, "%.1f"), fmt(per_klut, "%.2f")))
+
+    table = "\n".join(rows) + "\n"
+    print("")
+    print(table)
+
+    if args.out:
+        with open(args.out, "w") as f:
+            f.write(table)
+    return 0
+
+
+#-------------------------------------------------------------------
+# __name__
+# Python thingy which allows the file to be run standalone as
+# well as parsed from within a Python interpreter.
+#-------------------------------------------------------------------
+if __name__=="__main__":
+    # Run the main function.
+    sys.exit(main())
+
+#=======================================================================
+# EOF qor.py
+#=======================================================================
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#=======================================================================
+#
+# vcd_toggles.py
+# --------------
+# Count the signal toggles in a VCD file as a proxy for the dynamic
+# power. Each changed bit in a value change is one toggle. The
+# values in the initial dump are not counted. The toggles are
+# reported per module and for the most active signals, and per
+# message byte if the tb_vcd_bytes signal is in the file.
+#
+#
+# Author: Joachim Strömbergson
+# Copyright (c) 2026, Secworks Sweden AB
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or
+# without modification, are permitted provided that the following
+# conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in
+#    the documentation and/or other materials provided with the
+#    distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+# BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+# STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+# ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#=======================================================================
+
+
+#-------------------------------------------------------------------
+# Python module imports.
+#-------------------------------------------------------------------
+import argparse
+import sys
+
+
+#-------------------------------------------------------------------
+# parse_vcd()
+#
+# Parse a VCD file. Returns a dict with the scope and name of each
+# signal, a dict with the number of toggles for each signal, and
+# the last value of each signal.
+#-------------------------------------------------------------------
+def parse_vcd(filename):
+    signals = {}
+    toggles = {}
+    values = {}
+    scope = []
+    section = None
+    header = True
+
+    with open(filename, "r") as f:
+        for line in f:
+            tokens = line.split()
+            if not tokens:
+                continue
+
+            if header:
+                if tokens[0] == "$scope":
+                    scope.append(tokens[2])
+                elif tokens[0] == "$upscope":
+                    scope.pop()
+                elif tokens[0] == "$var":
+                    ident = tokens[3]
+                    if ident not in signals:
+                        signals[ident] = (".".join(scope), tokens[4])
+                        toggles[ident] = 0
+                elif tokens[0] == "$enddefinitions":
+                    header = False
+                continue
+
+            # Value changes in the $dumpvars, $dumpon and $dumpall
+            # sections set values but are not toggles. The x values
+            # in a $dumpoff section are ignored.
+            if tokens[0] in ("$dumpvars", "$dumpon", "$dumpall", "$dumpoff"):
+                section = tokens[0]
+                continue
+            if tokens[0] == "$end":
+                section = None
+                continue
+            if tokens[0][0] == "#" or section == "$dumpoff":
+                continue
+
+            if tokens[0][0] in "bBrR":
+                val = tokens[0][1:]
+                ident = tokens[1]
+            else:
+                val = tokens[0][0]
+                ident = tokens[0][1:]
+
+            if ident not in signals:
+                continue
+
+            old = values.get(ident)
+            values[ident] = val
+            if section or old is None:
+                continue
+            toggles[ident] += count_toggles(old, val)
+
+    return signals, toggles, values
+
+
+#-------------------------------------------------------------------
+# count_toggles()
+#
+# Number of bits that differ between two values. The values are
+# zero extended to the same width, and bits that are x or z are
+# counted as changed if they differ.
+#-------------------------------------------------------------------
+def count_toggles(old, new):
+    width = max(len(old), len(new))
+    old = old.rjust(width, "0")
+    new = new.rjust(width, "0")
+    return sum(1 for (a, b) in zip(old, new) if a != b)
+
+
+#-------------------------------------------------------------------
+# to_int()
+#-------------------------------------------------------------------
+def to_int(val):
+    try:
+        return int(val, 2)
+    except (TypeError, ValueError):
+        return None
+
+
+#-------------------------------------------------------------------
+# main()
+#-------------------------------------------------------------------
+def main():
+    parser = argparse.ArgumentParser(description="Count signal toggles in a VCD file.")
+    parser.add_argument("vcd", help="The VCD file.")
+    parser.add_argument("--top", type=int, default=20,
+                        help="Number of signals to list.")
+    args = parser.parse_args()
+
+    signals, toggles, values = parse_vcd(args.vcd)
+
+    nbytes = None
+    for (ident, (scope, name)) in signals.items():
+        if name == "tb_vcd_bytes":
+            nbytes = to_int(values.get(ident))
+            del toggles[ident]
+
+    total = sum(toggles.values())
+    print("Total toggles: %d" % total)
+    if nbytes:
+        print("Message bytes: %d" % nbytes)
+        print("Toggles/byte:  %.1f" % (total / nbytes))
+
+    modules = {}
+    for (ident, n) in toggles.items():
+        scope = signals[ident][0]
+        modules[scope] = modules.get(scope, 0) + n
+
+    print("")
+    print("Toggles per module:")
+    for (scope, n) in sorted(modules.items(), key=lambda m: -m[1]):
+        print("  %-40s %10d  %5.1f%%" % (scope, n, 100.0 * n / max(total, 1)))
+
+    print("")
+    print("Most active signals:")
+    active = sorted(toggles.items(), key=lambda t: -t[1])[:args.top]
+    for (ident, n) in active:
+        (scope, name) = signals[ident]
+        print("  %-40s %10d" % (scope + "." + name, n))
+    return 0
+
+
+#-------------------------------------------------------------------
+# __name__
+# Python thingy which allows the file to be run standalone as
+# well as parsed from within a Python interpreter.
+#-------------------------------------------------------------------
+if __name__=="__main__":
+    # Run the main function.
+    sys.exit(main())
+
+#=======================================================================
+# EOF vcd_toggles.py
+#=======================================================================